@@ -32,6 +32,7 @@ echo Y | del /s .\BridgeWx\* >nul 2>&1
 
 :: copy non-dll release to destination
 copy ..\vc_x64_mswu\BridgeWx.exe .\BridgeWx\
+copy ..\vc_x64_mswu\BridgeCalc.exe .\BridgeWx\
 
 :: copy translations for each language
 :: English, remark: no wx locale needed, default is English, rest of texts: buildin
@@ -413,8 +413,8 @@ float GetScale()
     return (float)(mainSize/defaultSize);
 }   // GetScale()
 
-int MyMessageBox(const wxString& message, const wxString& caption, long style, const wxPoint& position)
-{
+int MyMessageDialog(const wxString& message, const wxString& caption, long style, const wxPoint& position)
+{   // called by MyMessageBox(), in the ui thread
     auto pMain = GetMainframe();    // this guarantees MY main window
     if (pMain == nullptr)
     {
@@ -457,7 +457,7 @@ int MyMessageBox(const wxString& message, const wxString& caption, long style, c
 
     int result = dialog.ShowModal();
     return result;
-}   // MyMessageBox()
+}   // MyMessageDialog()
 
 // display a message during some time and selfdestruct afterwards (like a tooltip)
 void BusyBox(const wxString& message, int milisecondsShow, const wxPoint& position)
@@ -520,53 +520,6 @@ void BusyBox(const wxString& message, int milisecondsShow, const wxPoint& positi
         new bb(message, milisecondsShow, position);
 }   // BusyBox()
 
-/****************** MyTextFile **********************/
-MyTextFile::MyTextFile(const wxString& a_filename, AccessType a_access, wxTextFileType a_textType)
-{
-    MyCreate(a_filename, a_access, a_textType);
-}   // MyTextFile()
-
-void MyTextFile::MyCreate(const wxString& a_filename, AccessType a_access, wxTextFileType a_textType)
-{
-    m_access    = a_access;
-    m_textType  = a_textType;
-    m_fileName  = a_filename;
-    m_error     = 0;
-
-    Close();    // if opened previous, it will reinitialize/reset the class
-    m_bOk = Open(m_fileName, wxCSConv(wxFONTENCODING_CP437));
-    if (m_access != READ)
-    {
-        if (m_bOk)
-        {
-            if ( m_access == WRITE) Clear(); // empty existing file
-        }
-        else
-        {
-            m_bOk = Create();    // create file if it does not yet exists
-            if (m_bOk)
-                m_bOk = Open(m_fileName);
-        }
-    }
-}   // MyCreate()
-
-bool MyTextFile::IsOk() const
-{
-    return m_bOk;
-}   // IsOk()
-
-MyTextFile::~MyTextFile()
-{
-    Flush();
-}   // ~MyTextFile()
-
-void MyTextFile::Flush()
-{
-    if (IsOpened() && ( m_access != READ) )
-        m_bOk = Write(m_textType, wxCSConv(wxFONTENCODING_CP437));  // write changes to disk
-}   // Flush()
-
-/****************** end MyTextFile **********************/
 // cppcheck-suppress constParameterPointer
 AHKHelper::AHKHelper(wxWindow* a_pParent, wxWindow* a_pTarget, const  wxString& a_label)
   : m_pTarget(a_pTarget)
@@ -15,8 +15,11 @@
 #include <wx/combobox.h>
 #include <wx/stattext.h>
 #include <wx/checkbox.h>
+#include <string>
 
 #include "utils.h"
+#include "uilink.h"
+#include "mytextfile.h"
 #include "choicemc.h"
 #include "mygrid.h"
 
@@ -30,7 +33,6 @@ void AutoTestBusy(wxWindow* pWin, const wxString& msg);
 #endif
 
 class wxBoxSizer;
-class MyTextFile;
 class wxRadioBox;
 
 #define MY_SIZE_TXTCTRL_NUM(count) wxDefaultPosition, {GetCharWidth()*(1+(count)),-1} /* default size for textCtrl with number input*/
@@ -206,34 +208,11 @@ private:
     wxBoxSizer* m_pBoxSizer;
 };
 
-// wxMessageBox has quirks: different fontsize/color if you have more lines
-int MyMessageBox(const wxString& message, const wxString& caption = ES, long style=wxOK|wxCENTER, const wxPoint& position = wxDefaultPosition);
+// the ui part of MyMessageBox(): wxMessageBox has quirks, different fontsize/color if you have more lines
+int MyMessageDialog(const wxString& message, const wxString& caption, long style, const wxPoint& position);
 
 void BusyBox(const wxString& message = _("Busy..."), int milisecondsShow = 800, const wxPoint& position = wxDefaultPosition);
 
-class MyTextFile : public wxTextFile
-{   // wrapper around wxTextFile with buildin CP437 conversion for read/write
-public:
-    enum AccessType
-    {
-          READ
-        , WRITE
-        , READ_WRITE
-    };
-    MyTextFile() = default;
-    explicit MyTextFile(const wxString& filename, AccessType access = READ, wxTextFileType textType = wxTextFileType_Dos);
-    ~MyTextFile() final;
-    void MyCreate(const wxString& filename, AccessType access = READ, wxTextFileType textType= wxTextFileType_Dos);
-    bool IsOk() const;
-    void  Flush();
-private:
-    AccessType      m_access    = READ;
-    wxTextFileType  m_textType  = wxTextFileType_Dos;
-    wxString        m_fileName;
-    int             m_error     = -1;
-    bool            m_bOk       = false;
-};
-
 int MyGetSingleChoiceIndex(const wxString& message, const wxString& caption, const wxArrayString& names, wxWindow* pParent = nullptr, int selection = 0);
 
 #endif
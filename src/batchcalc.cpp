@@ -0,0 +1,218 @@
+﻿// Copyright(c) 2024-present, BusyHarry/h.levels & BridgeWx contributors.
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+// Start of the headless batch calculator: (re)calculates matches and writes all result lists, no ui
+#ifdef _MSC_VER
+#include <msvc/wx/setup.h>      // all kinds of defines and force include of needed wx-libs
+#endif
+#include <wx/app.h>
+#include <wx/cmdline.h>
+#include <wx/dir.h>
+#include <wx/filename.h>
+#include <wx/stdpaths.h>
+#include <wx/process.h>
+#include <wx/evtloop.h>
+#include <iostream>
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <thread>
+#ifdef _WIN32
+#include <wx/msw/wrapwin.h>     // SetConsoleOutputCP()
+#endif
+
+#include "cfg.h"
+#include "calcreports.h"
+#include "benchmarks.h"
+#include "version.h"
+#include "uilink.h"
+
+static bool HandleCfg(const wxString& a_session = ES, bool a_bInit = false)
+{   // (re)read the configuration, optionally for another session
+    wxArrayString argv;
+    argv.push_back(__PRG_NAME__);
+    if (!a_session.IsEmpty())
+    {
+        argv.push_back("-z");
+        argv.push_back(a_session);
+    }
+    return CFG_OK == cfg::HandleCommandline(argv, a_bInit);
+}   // HandleCfg()
+
+static bool CalcMatch(const wxString& a_matchFile, long a_session, const wxString& a_outputFolder)
+{   // calculate one match, for a_session or (if <0) for all sessions upto the active one
+    if (!wxFileName::FileExists(a_matchFile))
+    {
+        std::cout << FMT(_("Match '%s' not found\n"), a_matchFile);
+        return false;
+    }
+
+    cfg::SetBatchMatch(a_matchFile);
+    if (!HandleCfg(ES, true)) return false;
+
+    UINT activeSession = cfg::GetActiveSession();
+    UINT firstSession  = activeSession == 0 ? 0 : 1;
+    UINT lastSession   = activeSession;
+    if (a_session >= 0)
+        firstSession = lastSession = static_cast<UINT>(a_session);
+
+    bool     bOk        = true;
+    wxString matchName  = wxFileName(a_matchFile).GetName();
+    for (UINT session = firstSession; session <= lastSession; ++session)
+    {   // in order: the total of a session uses the results of the previous sessions
+        if (!HandleCfg(U2String(session))) return false;
+        CalcReports reports;                // fresh state for each session
+        (void)reports.Calculate();
+        for (const auto& info : reports.TakeMessages())
+            std::cout << FMT("%s, %u: %s: %s\n", matchName, session, info.caption, info.message);
+        wxString folder = a_outputFolder + PS + matchName + PS + U2String(session);
+        if (!reports.SaveReports(folder))
+        {
+            std::cout << FMT(_("Could not write the results to '%s'\n"), folder);
+            bOk = false;
+        }
+        cfg::FLushConfigs();
+    }
+
+    if (cfg::GetActiveSession() != activeSession)
+        (void)HandleCfg(U2String(activeSession));   // leave the match as we found it
+    std::cout << FMT("%s: %s\n", matchName, bOk ? _("ready") : _("errors"));
+    return bOk;
+}   // CalcMatch()
+
+static std::vector<wxString> GetMatchFiles(const wxString& a_folder)
+{   // all matches in a_folder, if more types exist for the same match: prefer .db, then .sqlite, then .ini
+    static const std::map<wxString, int> priority = {{"db", 3}, {"sqlite", 2}, {"ini", 1}};
+    std::map<wxString, std::pair<int, wxString> > matches;    // name -> priority, file
+    wxString skipIni     = wxFileName(cfg::GetBareMainIni()).GetName().Lower();
+    wxString skipGlobals = wxFileName(cfg::GetGlobalNameFile()).GetName().Lower();
+
+    wxArrayString files;
+    (void)wxDir::GetAllFiles(a_folder, &files, ES, wxDIR_FILES);
+    for (const auto& file : files)
+    {
+        wxFileName fn(file);
+        auto it = priority.find(fn.GetExt().Lower());
+        if (it == priority.end()) continue;
+        wxString name = fn.GetName().Lower();
+        if (name == skipIni || name == skipGlobals) continue;
+        auto& match = matches[name];
+        if (it->second > match.first)
+            match = {it->second, file};
+    }
+
+    std::vector<wxString> result;
+    for (const auto& [name, match] : matches)
+        result.push_back(match.second);
+    return result;
+}   // GetMatchFiles()
+
+class MatchProcess final : public wxProcess
+{   // one running match calculation, reports its exit code when it ends
+public:
+    explicit MatchProcess(std::function<void(int)> a_onEnd) : m_onEnd(std::move(a_onEnd)) {}
+    void OnTerminate(int /*pid*/, int a_status) override {m_onEnd(a_status); delete this;}
+private:
+    std::function<void(int)> m_onEnd;
+};  // class MatchProcess
+
+static bool CalcFolder(const wxString& a_folder, const wxString& a_outputFolder)
+{   // each match in its own process: the configuration is global, so one match per process
+    // wxExecute() only works in the main thread: start the processes async and wait for them in a local eventloop
+    auto        matches    = GetMatchFiles(a_folder);
+    wxString    exe        = wxStandardPaths::Get().GetExecutablePath();
+    const UINT  maxRunning = std::max(std::thread::hardware_concurrency(), 1U);
+    UINT        next       = 0;
+    UINT        running    = 0;
+    UINT        errors     = 0;
+    wxEventLoop loop;
+    wxEventLoopActivator activate(&loop);
+
+    std::function<void()> startMatches = [&]()
+    {   // keep upto maxRunning processes busy
+        while (running < maxRunning && next < matches.size())
+        {
+            const wxString& match  = matches[next++];
+            const wchar_t*  argv[] = {exe.wc_str(), L"-m", match.wc_str(), L"-o", a_outputFolder.wc_str(), nullptr};
+            auto process = new MatchProcess([&](int a_status)
+                {
+                    --running;
+                    if (a_status != 0) ++errors;
+                    startMatches();
+                    if (running == 0 && loop.IsRunning()) loop.Exit();
+                });
+            if (wxExecute(argv, wxEXEC_ASYNC, process) == 0)
+            {   // not started, so no OnTerminate() either
+                delete process;
+                ++errors;
+                continue;
+            }
+            ++running;
+        }
+    };
+
+    startMatches();
+    if (running != 0) (void)loop.Run();
+
+    std::cout << FMT(_("%u matches calculated, %u with errors\n"), (UINT)matches.size(), errors);
+    return errors == 0;
+}   // CalcFolder()
+
+class BatchApp final : public wxApp
+{
+public:
+    BatchApp() = default;
+    ~BatchApp() override = default;
+    bool OnInit() override {SetHeadless(); return true;}   // no ui and no default commandline handling
+    int  OnRun () override;
+};  // class BatchApp
+
+wxIMPLEMENT_APP_CONSOLE(BatchApp);
+
+int BatchApp::OnRun()
+{
+    static const wxCmdLineEntryDesc cmdLineDesc[] =
+    {
+          { wxCMD_LINE_OPTION, "m", nullptr, "match file (.db, .sqlite or .ini) to calculate"     , wxCMD_LINE_VAL_STRING}
+        , { wxCMD_LINE_OPTION, "z", nullptr, "session to calculate, default: all upto the active session", wxCMD_LINE_VAL_NUMBER}
+        , { wxCMD_LINE_OPTION, "p", nullptr, "folder: calculate all matches in it, in parallel"   , wxCMD_LINE_VAL_STRING}
+        , { wxCMD_LINE_OPTION, "o", nullptr, "output folder for the result lists, for -m and -p"  , wxCMD_LINE_VAL_STRING}
+        , { wxCMD_LINE_SWITCH, "b", nullptr, "compare and time the optimized calculation/storage code, no match needed"}
+        , { wxCMD_LINE_NONE }
+    };
+
+#ifdef _WIN32
+    SetConsoleOutputCP(437);        // result lists are in CP437
+#endif
+    Cleanup  cleaner;               // close databases and remove private config on exit
+    wxCmdLineParser parser(cmdLineDesc, argc, argv);
+    parser.SetLogo(FMT("%s %s %s: %s", __PRG_NAME__, _("version"), __VERSION__, _("batch calculation of match results")));
+    if (parser.Parse() != 0) return 1;
+
+    wxString matchFile;
+    wxString folder;
+    wxString outputFolder;
+    long     session = -1;
+    (void)parser.Found("o", &outputFolder);
+    (void)parser.Found("z", &session);
+    outputFolder = wxFileName(outputFolder).GetAbsolutePath();
+
+    bool bOk;
+    if (parser.Found("b"))
+        bOk = RunBenchmarks();
+    else if (!parser.Found("o"))
+    {
+        std::cout << _("An output folder (-o) is needed\n");
+        bOk = false;
+    }
+    else if (parser.Found("m", &matchFile))
+        bOk = CalcMatch(wxFileName(matchFile).GetAbsolutePath(), session, outputFolder);
+    else if (parser.Found("p", &folder))
+        bOk = CalcFolder(folder, outputFolder);
+    else
+    {
+        parser.Usage();
+        bOk = false;
+    }
+    return bOk ? 0 : 1;
+}   // OnRun()
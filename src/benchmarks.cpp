@@ -0,0 +1,301 @@
+﻿// Copyright(c) 2026-present, BusyHarry/h.levels & BridgeWx contributors.
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+// Comparisons of the optimized code with the generic/original code on generated input: the results
+// must be identical, the times show the gain. Run by 'BridgeCalc -b', never by the application itself.
+#include <wx/wxcrtvararg.h>
+#include <wx/filename.h>
+#include <iostream>
+#include <random>
+#include <chrono>
+#include <numeric>
+#include <algorithm>
+#include <string>
+
+#include "cfg.h"
+#include "calcengine.h"
+#include "sqlite.h"
+#include "itemscanner.h"
+#include "benchmarks.h"
+
+template <typename Function>
+static long long TimeUs(Function&& a_function)
+{   // run a_function once, returns the time it took in microseconds
+    auto start = std::chrono::steady_clock::now();
+    a_function();
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}   // TimeUs()
+
+static bool Report(const wxString& a_info, bool a_bEqual)
+{
+    std::cout << FMT("%s, results %s\n", a_info, a_bEqual ? "equal" : "DIFFERENT");
+    return a_bEqual;
+}   // Report()
+
+static bool BenchmarkMatchpoints()
+{   // random games: compare the compact ranking/lookup with the generic sort/search, results must be identical
+    static const int scorePool[] = {-1100, -800, -500, -200, -150, -100, -50, 90, 110, 120, 140, 170, 400, 420, 430, 450, 480, 600, 620, 630, 650, 680, 1400, 1430, 1440};
+    const UINT games = 20000;
+    std::mt19937 rng(1234);
+    std::vector<std::vector<int> > allScores(games);
+    for (auto& scores : allScores)
+    {
+        UINT sets = 2 + rng() % 59;
+        for (UINT set = 0; set < sets; ++set)
+        {
+            if (rng() % 20 == 0)    // now and then an adjusted score
+                scores.push_back(score::Procent2Procentscore(10*(rng() % 11)));
+            else
+                scores.push_back(scorePool[rng() % std::size(scorePool)]);
+        }
+    }
+
+    auto makeInfo = [](const std::vector<int>& a_scores, bool a_bNeuberg)
+    {
+        MatchpointInfo mpInfo;
+        auto sets = (UINT)a_scores.size();
+        mpInfo.adjustedScoreCount = (UINT)std::ranges::count_if(a_scores, [](int score){return score::IsProcent(score);});
+        mpInfo.sets      = sets;
+        mpInfo.normalTop = (sets-1)*2;
+        mpInfo.top       = mpInfo.normalTop-mpInfo.adjustedScoreCount;
+        mpInfo.bNeuberg  = a_bNeuberg;
+        if (a_bNeuberg)
+        {
+            mpInfo.neubergCount = sets-mpInfo.adjustedScoreCount;
+            mpInfo.top         -= mpInfo.adjustedScoreCount;
+        }
+        return mpInfo;
+    };
+
+    std::vector<Fdp> sumSorted(games), sumCompact(games);
+    CalcContext::FS_INFO fsInfo;
+    auto timeSorted = TimeUs([&]()
+    {   // the original method: sort, count, search
+        for (UINT game = 0; game < games; ++game)
+        {
+            auto scores = allScores[game];
+            fsInfo.clear();
+            RankScoresSorted(scores, makeInfo(allScores[game], game & 1), fsInfo);
+            for (auto score : allScores[game])
+                sumSorted[game] += std::ranges::find_if(fsInfo, [score](const auto& info){return score == info.score;})->points;
+        }
+    });
+
+    auto timeCompact = TimeUs([&]()
+    {   // counting in the compact domain and direct lookup
+        for (UINT game = 0; game < games; ++game)
+        {
+            fsInfo.clear();
+            (void)RankScoresCompact(allScores[game], makeInfo(allScores[game], game & 1), fsInfo);
+            ScoreLookup lookup(fsInfo);
+            for (auto score : allScores[game])
+                sumCompact[game] += lookup.Find(score)->points;
+        }
+    });
+
+    return Report(FMT("Matchpoints: %u games, sorted: %lldus, compact: %lldus", games, timeSorted, timeCompact), sumSorted == sumCompact);
+}   // BenchmarkMatchpoints()
+
+static bool BenchmarkRanking()
+{   // random total results for the max number of pairs: sort on the results or on a rank column, ranks must be identical
+    const UINT pairs   = cfg::MAX_PAIRS;
+    const UINT repeats = 20000;
+    std::mt19937 rng(1234);
+    std::vector<ScoreInfo> results(pairs+1ULL);
+    for (UINT pair = 1; pair <= pairs; ++pair)
+    {
+        results[pair].totalN     = Fdp(static_cast<int>(rng() % 10000))/100;
+        results[pair].bHasPlayed = rng() % 10 != 0;
+    }
+
+    std::vector<UINT> rankResults(pairs+1ULL), rankColumn;
+    auto timeResults = TimeUs([&]()
+    {   // the original method: compare the result structs
+        for (UINT repeat = 0; repeat < repeats; ++repeat)
+        {
+            std::iota(rankResults.begin(), rankResults.end(), 0);
+            std::sort(rankResults.begin()+1, rankResults.end(),
+                [&results](auto left, auto right){return results[left].bHasPlayed && results[left].totalN > results[right].totalN;} );
+        }
+    });
+
+    auto timeColumn = TimeUs([&]()
+    {   // make the dense rank column and sort on it
+        for (UINT repeat = 0; repeat < repeats; ++repeat)
+        {
+            RankColumn column(pairs+1ULL);
+            for (UINT pair = 0; pair <= pairs; ++pair)
+                column[pair] = {results[pair].totalN, results[pair].bHasPlayed};
+            SortOnRank(rankColumn, column);
+        }
+    });
+
+    return Report(FMT("Ranking: %u pairs, %u times, results: %lldus, column: %lldus", pairs, repeats, timeResults, timeColumn), rankResults == rankColumn);
+}   // BenchmarkRanking()
+
+static bool BenchmarkStatements()
+{   // a temporary match database: pairnames and a match value written and read back through the sql layer,
+    // with the formatted sql as before and with the prepared statements. What is read back must be what was written
+    const UINT repeats = 100;
+    wxString   dbFile  = wxFileName(wxFileName::GetTempDir(), "BridgeCalcStatements.sqlite").GetFullPath();
+    (void)wxRemoveFile(dbFile);
+    if ( !sql::TestDatabaseOpen(dbFile) )
+        return Report("Statements: can't create a test database", false);
+
+    names::PairInfoData pairInfo(1);    // entry 0 is dummy
+    for (UINT pair = 1; pair <= cfg::MAX_PAIRS; ++pair)
+        pairInfo.emplace_back(FMT("pair %u - O'Partner %u", pair, pair % 37), static_cast<int>(pair % cfg::MAX_CLUBID_UNION));
+
+    bool bEqual = true;
+    auto writeRead = [&](auto a_pairnamesWrite, auto a_valueWrite)
+    {
+        for (UINT repeat = 0; repeat < repeats; ++repeat)
+        {
+            bEqual = a_pairnamesWrite(pairInfo) && bEqual;
+            for (UINT pair = 1; pair <= cfg::MAX_PAIRS; ++pair)
+                bEqual = a_valueWrite(KEY_MATCH_CMNT, FMT("comment '%u'", pair)) && bEqual;
+
+            names::PairInfoData pairInfoRead;
+            bEqual = sql::PairnamesRead(pairInfoRead) && pairInfoRead == pairInfo && bEqual;
+            bEqual = sql::ReadValue(KEY_MATCH_CMNT, ES) == FMT("comment '%u'", cfg::MAX_PAIRS) && bEqual;
+        }
+    };
+
+    auto timeFormatted = TimeUs([&]()
+    {   // each sql text is compiled on each use
+        writeRead([](const names::PairInfoData& a_pairInfo){return sql::PairnamesWriteFormatted(a_pairInfo);}
+                , [](keyId a_id, const wxString& a_value)  {return sql::WriteValueFormatted(a_id, a_value);});
+    });
+
+    auto timePrepared = TimeUs([&]()
+    {   // compiled once, the values are bound
+        writeRead([](const names::PairInfoData& a_pairInfo){return sql::PairnamesWrite(a_pairInfo);}
+                , [](keyId a_id, const wxString& a_value)  {return sql::WriteValue(a_id, a_value);});
+    });
+
+    (void)sql::DatabaseClose(io::DB_MATCH);
+    (void)wxRemoveFile(dbFile);
+    return Report(FMT("Statements: %u x %u pairnames and values written and read, formatted: %lldus, prepared: %lldus", repeats, cfg::MAX_PAIRS, timeFormatted, timePrepared), bEqual);
+}   // BenchmarkStatements()
+
+static bool BenchmarkParser()
+{   // fuzz corpus of valid and mutated items: the scanner must give the same count and fields as wxSplit()+wxSscanf()
+    static const char* const validItems[] =
+    {   // scores, end corrections, session corrections, schema groups, session totals
+        R"({1,2,110,-110,"3SA","3SA"})", " { 12 , 3, 50% , 50% , \"4H ,  \"-}", "{4,5,400,-400}", "{7,8,-,60%}",
+        "{3,1.50,0.00,0}", " {12 , -2.25 , 1.00 , 24 }", "{9,+3%,0.0,0,0}", " {4 ,-010 % , 2.5 ,0x1F, 12 }", "{5,+2%,1.5,3}",
+        R"({14,0,"6multi14",""})", R"( {8 ,1 , "" , "AB" })", R"({10,0,"4stayt10"," "})",
+        "{1,25.123,50.5,1.0,3,2,1,0,1}", " {2 , -0.5 , 0 , 12345678901234567 , 1 , 2 , 3 , 4 , 5 }"
+    };
+    static const char mutationChars[] = "{}\",\\@ \t+-0x9aZ%.";
+    const UINT   corpusSize = 20000;
+    const UINT   repeats    = 20;
+    const wxChar separator  = glb::GetSeparator();
+    std::mt19937 rng(1234);
+    wxArrayString corpus;
+    for ( UINT item = 0; item < corpusSize; ++item )
+    {
+        std::string text = validItems[rng() % std::size(validItems)];
+        for ( UINT mutations = rng() % 4; mutations; --mutations )
+        {
+            size_t pos = text.empty() ? 0 : rng() % text.size();
+            char   ch  = mutationChars[rng() % (std::size(mutationChars) - 1)];
+            switch ( rng() % 4 )
+            {
+                case 0: text.insert(pos, 1, ch); break;
+                case 1: if ( !text.empty() ) text.erase(pos, 1); break;
+                case 2: text.resize(pos); break;
+                default: if ( !text.empty() ) text[pos] = ch; break;
+            }
+        }
+        corpus.push_back(wxString::FromAscii(text.c_str()));
+    }
+    wxString data;
+    for ( const auto& item : corpus )
+        data += item + separator;
+    data += corpus[0];
+
+    // all formats on each item, the fields as text for compare
+    auto sscanfItem = [](const wxString& a_item)
+    {
+        UINT u1 = 0, u2 = 0, u3 = 0, u4 = 0, u5 = 0, u6 = 0; int i1 = 0, i2 = 0; char c1 = 0;
+        char b1[40] = { 0 }, b2[40] = { 0 }, b3[40] = { 0 }, b4[40] = { 0 };
+        int count1 = wxSscanf(a_item, " { %u , %u, %9[^, ] , %9[^} ,] , \"%19[^,], \"%19[^}]}", &u1, &u2, b1, b2, b3, b4);
+        int count2 = wxSscanf(a_item, " {%u ,%i %c , %10[^, ] ,%i, %u }", &u3, &i1, &c1, b1 + 20, &i2, &u4);
+        int count3 = wxSscanf(a_item, R"( {%u ,%u , "%19[^"]" , "%19[^"]" })", &u5, &u6, b3 + 20, b4 + 20);
+        return FMT("%i %i %i:%u,%u,%u,%u,%u,%u,%i,%i,%i:%s|%s|%s|%s", count1, count2, count3, u1, u2, u3, u4, u5, u6, i1, i2, (int)c1, b1, b2, b3, b4);
+    };
+    auto scanItem = [](glb::ItemScanner& a_item)
+    {
+        glb::ItemScanner item2 = a_item, item3 = a_item;
+        UINT u1 = 0, u2 = 0, u3 = 0, u4 = 0, u5 = 0, u6 = 0; int i1 = 0, i2 = 0; char c1 = 0;
+        char b1[40] = { 0 }, b2[40] = { 0 }, b3[40] = { 0 }, b4[40] = { 0 };
+        int count1 = a_item.Space().Literal('{').Space().Uint(u1).Space().Literal(',').Space().Uint(u2)
+            .Literal(',').Space().Field(b1, 9, ", ").Space().Literal(',').Space().Field(b2, 9, "} ,")
+            .Space().Literal(',').Space().Literal('"').Field(b3, 19, ",")
+            .Literal(',').Space().Literal('"').Field(b4, 19, "}").Literal('}').Count();
+        int count2 = item2.Space().Literal('{').Uint(u3).Space().Literal(',').Int(i1).Space().Char(c1)
+            .Space().Literal(',').Space().Field(b1 + 20, 10, ", ").Space().Literal(',').Int(i2)
+            .Literal(',').Space().Uint(u4).Space().Literal('}').Count();
+        int count3 = item3.Space().Literal('{').Uint(u5).Space().Literal(',').Uint(u6)
+            .Space().Literal(',').Space().Literal('"').Field(b3 + 20, 19, "\"").Literal('"')
+            .Space().Literal(',').Space().Literal('"').Field(b4 + 20, 19, "\"").Literal('"').Space().Literal('}').Count();
+        return FMT("%i %i %i:%u,%u,%u,%u,%u,%u,%i,%i,%i:%s|%s|%s|%s", count1, count2, count3, u1, u2, u3, u4, u5, u6, i1, i2, (int)c1, b1, b2, b3, b4);
+    };
+
+    std::vector<wxString> resultSscanf, resultScanner;
+    for ( const auto& item : wxSplit(data, separator) )
+        resultSscanf.push_back(sscanfItem(item));
+    glb::ForEachItem(data, [&](glb::ItemScanner& a_item){ resultScanner.push_back(scanItem(a_item)); });
+    size_t differences = 0;
+    for ( size_t index = 0; index < std::max(resultSscanf.size(), resultScanner.size()); ++index )
+    {
+        if ( index < resultSscanf.size() && index < resultScanner.size() && resultSscanf[index] == resultScanner[index] ) continue;
+        if ( ++differences <= 10 )
+            std::cout << FMT("Parser: item %zu <%s>: sscanf <%s>, scanner <%s>\n", index, index < corpus.size() ? corpus[index] : ES
+                , index < resultSscanf.size() ? resultSscanf[index] : ES, index < resultScanner.size() ? resultScanner[index] : ES);
+    }
+
+    // throughput on the scores format only
+    UINT checkSscanf = 0, checkScanner = 0;
+    auto timeSscanf = TimeUs([&]()
+    {
+        for ( UINT repeat = 0; repeat < repeats; ++repeat )
+        {
+            for ( const auto& item : wxSplit(data, separator) )
+            {
+                UINT pairNS = 0, pairEW = 0;
+                char nsScore[10] = { 0 }, ewScore[10] = { 0 }, nsContract[20] = { 0 }, ewContract[20] = { 0 };
+                checkSscanf += wxSscanf(item, " { %u , %u, %9[^, ] , %9[^} ,] , \"%19[^,], \"%19[^}]}", &pairNS, &pairEW, nsScore, ewScore, nsContract, ewContract) + pairNS;
+            }
+        }
+    });
+
+    auto timeScanner = TimeUs([&]()
+    {
+        for ( UINT repeat = 0; repeat < repeats; ++repeat )
+        {
+            glb::ForEachItem(data, [&](glb::ItemScanner& a_item)
+            {
+                UINT pairNS = 0, pairEW = 0;
+                char nsScore[10] = { 0 }, ewScore[10] = { 0 }, nsContract[20] = { 0 }, ewContract[20] = { 0 };
+                checkScanner += a_item.Space().Literal('{').Space().Uint(pairNS).Space().Literal(',').Space().Uint(pairEW)
+                    .Literal(',').Space().Field(nsScore, 9, ", ").Space().Literal(',').Space().Field(ewScore, 9, "} ,")
+                    .Space().Literal(',').Space().Literal('"').Field(nsContract, 19, ",")
+                    .Literal(',').Space().Literal('"').Field(ewContract, 19, "}").Literal('}').Count() + pairNS;
+            });
+        }
+    });
+
+    return Report(FMT("Parser: %u items, %zu different, %u x scores: sscanf: %lldus, scanner: %lldus", corpusSize, differences, repeats, timeSscanf, timeScanner)
+        , differences == 0 && checkSscanf == checkScanner);
+}   // BenchmarkParser()
+
+bool RunBenchmarks()
+{   // all comparisons, also if one of them fails
+    bool bOk = BenchmarkMatchpoints();
+    bOk = BenchmarkRanking   () && bOk;
+    bOk = BenchmarkStatements() && bOk;
+    bOk = BenchmarkParser    () && bOk;
+    return bOk;
+}   // RunBenchmarks()
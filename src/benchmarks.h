@@ -0,0 +1,9 @@
+﻿// Copyright(c) 2026-present, BusyHarry/h.levels & BridgeWx contributors.
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#if !defined _BENCHMARKS_H_
+#define  _BENCHMARKS_H_
+
+bool RunBenchmarks();   // compare and time the optimized code with the original code, returns false if a result differs
+
+#endif
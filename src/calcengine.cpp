@@ -0,0 +1,1237 @@
+﻿// Copyright(c) 2024-present, BusyHarry/h.levels & BridgeWx contributors.
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#include <wx/string.h>
+#include <numeric>
+#include <array>
+#include <span>
+#include <algorithm>
+#include <climits>
+#include <atomic>
+#include <cstring>
+#include <type_traits>
+
+#include "calcengine.h"
+#include "parallel.h"
+
+static const auto sButlerRemoveScoresPercent = 10;  // remove N % of highest/lowest scores
+static const auto sButlerMinimumScores       = 3;   // we want atleast N scores after removal
+static const auto sButlerImpsPer10Procent    = 2;   // referee scores: each 10% above/below 50% equals N imps, ASSUME scores are multiple of 5%
+
+struct lowHighImp { int low; int high; int mp; };
+static constexpr lowHighImp suImpTable[]=
+{
+    {0   , 10  , 0 }, {20  , 40  , 1 }, {50  , 80  , 2 }, {90  , 120 , 3 }, {130 , 160 , 4 }, {170 , 210 , 5 },
+    {220 , 260 , 6 }, {270 , 310 , 7 }, {320 , 360 , 8 }, {370 , 420 , 9 }, {430 , 490 , 10}, {500 , 590 , 11},
+    {600 , 740 , 12}, {750 , 890 , 13}, {900 , 1090, 14}, {1100, 1290, 15}, {1300, 1490, 16}, {1500, 1740, 17},
+    {1750, 1990, 18}, {2000, 2240, 19}, {2250, 2490, 20}, {2500, 2990, 21}, {3000, 3490, 22}, {3500, 3990, 23},
+    {4000, 99999,24}
+};
+
+static constexpr int IMP_DIRECT_SIZE = suImpTable[std::size(suImpTable)-1].low; // imps for differences below this value by direct index
+static constexpr auto suImpDirect = []()
+{   // imps for each difference 0..IMP_DIRECT_SIZE-1, differences outside the brackets have 0 imps
+    std::array<signed char, IMP_DIRECT_SIZE> table{};
+    for (const auto& imp : suImpTable)
+        for (int diff = imp.low; diff <= imp.high && diff < IMP_DIRECT_SIZE; ++diff)
+            table[diff] = static_cast<signed char>(imp.mp);
+    return table;
+}();
+
+static int ImpsFromDifference(int a_diff)
+{   // imps for the difference between a score and the datum score
+    int absDiff = std::abs(a_diff);
+    int sign    = a_diff < 0 ? -1 : 1;
+    if (absDiff < IMP_DIRECT_SIZE)
+        return sign*suImpDirect[absDiff];
+    const auto& last = suImpTable[std::size(suImpTable)-1];
+    return absDiff <= last.high ? sign*last.mp : 0;     // 0: should not happen....
+}   // ImpsFromDifference()
+
+static Fdp NeubergPoints(const Fdp& points, UINT gameCount, UINT comparableCount);
+
+int ButlerGetMpsFromScore(int a_score, int a_datumScore)
+{
+    if (score::IsProcent(a_score))
+    {   // for now, assume a procentscore is a multiple of 5%
+        auto deltaProcent = score::Procentscore2Procent(a_score) - 50;
+        return sButlerImpsPer10Procent*deltaProcent/10;
+    }
+
+    // now we have a 'normal' score
+    a_score = score::Score2Real(a_score);  //convert (possible) real adjusted score to a normal score
+    return ImpsFromDifference(a_score - a_datumScore);
+}   // ButlerGetMpsFromScore()
+
+static void ButlerGetMpsFromScores(std::span<const int> a_scores, int a_datumScore, std::span<int> a_imps)
+{   // convert all scores of a game in one go: a_imps[i] = imps for a_scores[i]
+    for (size_t index = 0; index < a_scores.size(); ++index)
+        a_imps[index] = ButlerGetMpsFromScore(a_scores[index], a_datumScore);
+}   // ButlerGetMpsFromScores()
+
+template <typename SCORE>
+static void InitPairToRankVector(const std::vector<UINT>& a_rankToPair, std::vector<UINT>& a_pairToRank, SCORE a_score)
+{   // equal scores get the same (highest) rank
+    a_pairToRank.clear();
+    a_pairToRank.resize(a_rankToPair.size());
+    for (UINT rank = 1; rank < a_rankToPair.size(); ++rank)
+    {   // todo? if pair == 0, skip this?
+        UINT pair       = a_rankToPair[rank];
+        Fdp  score      = a_score(pair);
+        UINT realRank   = rank;
+        while ( (realRank > 1) && (score == a_score(a_rankToPair[realRank-1])) )
+        {
+            --realRank; // find highest rank with equal score
+        }
+
+        a_pairToRank[pair] = realRank;    // if scores are equal, so the rank is
+    }
+}   // InitPairToRankVector()
+
+void SortOnRank(std::vector<UINT>& a_rankToPair, const RankColumn& a_column)
+{   // a_rankToPair[0] stays 0, the pairs are sorted on decreasing score
+    a_rankToPair.resize(a_column.size());
+    std::iota(a_rankToPair.begin(), a_rankToPair.end(), 0);  // fill with 0,1,2,3....
+    std::sort(a_rankToPair.begin()+1, a_rankToPair.end(),
+        [&a_column](UINT left, UINT right){return a_column[left].bRanked && a_column[left].score > a_column[right].score;});
+}   // SortOnRank()
+
+// Compact score domain for the matchpoint calculation: real scores are multiples of 10 in a small range
+// and %-scores are 0..100%. Each score in the domain has its own index: a higher score has a higher index.
+// So scores can be ranked by counting them, instead of sorting/searching. Other scores use the generic code.
+static constexpr int  DOMAIN_REAL_MAX       = 8000;                     // abs(real score) <= this value
+static constexpr UINT DOMAIN_PROCENT_BASE   = 2*DOMAIN_REAL_MAX/10+1;   // index of 0%: above all real scores
+static constexpr UINT DOMAIN_SIZE           = DOMAIN_PROCENT_BASE+101;  // 0% .. 100%
+static constexpr UINT DOMAIN_INVALID        = UINT_MAX;
+
+static UINT DomainIndex(int a_score)
+{   // index of a (real or %) score in the compact domain or DOMAIN_INVALID if not present
+    if (score::IsProcent(a_score))
+        return DOMAIN_PROCENT_BASE + score::Procentscore2Procent(a_score);
+    if (a_score % 10 || a_score < -DOMAIN_REAL_MAX || a_score > DOMAIN_REAL_MAX)
+        return DOMAIN_INVALID;
+    return static_cast<UINT>(a_score + DOMAIN_REAL_MAX)/10;
+}   // DomainIndex()
+
+ScoreLookup::ScoreLookup(const CalcContext::FS_INFO& a_fsInfo) : m_fsInfo(a_fsInfo)
+{
+    for (const auto& it : m_fsInfo)
+        if (DomainIndex(it.score) == DOMAIN_INVALID) return;     // m_bCompact stays false
+    for (UINT pos = 0; pos < m_fsInfo.size(); ++pos)
+        smPos[DomainIndex(m_fsInfo[pos].score)] = pos+1;
+    m_bCompact = true;
+}   // ScoreLookup()
+
+ScoreLookup::~ScoreLookup()
+{   // leave smPos clean for the next user
+    if (m_bCompact)
+        for (const auto& it : m_fsInfo) smPos[DomainIndex(it.score)] = 0;
+}   // ~ScoreLookup()
+
+const CalcContext::FrequencyState* ScoreLookup::Find(int a_score) const
+{   // nullptr if not present
+    if (m_bCompact)
+    {   // all scores in the table are in the domain, so a score outside it can't be found
+        UINT index = DomainIndex(a_score);
+        if (index == DOMAIN_INVALID || smPos[index] == 0) return nullptr;
+        return &m_fsInfo[smPos[index]-1ULL];
+    }
+    auto it = std::ranges::find_if(m_fsInfo, [a_score](const auto& info){return a_score == info.score;});
+    return it == m_fsInfo.end() ? nullptr : &*it;
+}   // Find()
+
+thread_local std::vector<UINT> ScoreLookup::smPos(DOMAIN_SIZE);
+
+static void MergeFrqTablesSorted(CalcContext::FS_INFO& ns, const CalcContext::FS_INFO& ew)
+{   // generic merge: search each ew score in ns, sort afterwards
+    for (const auto& itEW : ew)    // now merge ew into ns
+    {
+        int nsScore  = score::ScoreEwToNs(itEW.score); // transform ew-score to a comparable ns-score
+        auto itNS    = std::ranges::find_if(ns, [nsScore](const CalcContext::FrequencyState& fq){return nsScore == fq.score;});
+        if (itNS != ns.end())
+        {
+            itNS->pointsEW = itEW.points;  // already existing NS score, so just add EW points for this score
+        }
+        else
+        {   // non existing yet, so add the new info
+            CalcContext::FrequencyState fkw;
+            fkw.pointsEW = itEW.points;
+            fkw.score    = nsScore;
+            ns.push_back(fkw);
+        }
+    }
+    std::ranges::sort(ns, [](const auto& left, const auto& right){return left.score > right.score;});
+}   // MergeFrqTablesSorted()
+
+static bool MergeFrqTablesCompact(CalcContext::FS_INFO& ns, const CalcContext::FS_INFO& ew)
+{   // merge using the compact score domain: no searching/sorting needed
+    // return false (nothing done) if a score is outside the domain
+    thread_local std::vector<UINT> nsPos(DOMAIN_SIZE);  // position+1 in 'ns', 0 -> not present. All 0 between calls
+    thread_local std::vector<UINT> ewPos(DOMAIN_SIZE);  // position+1 in 'ew', 0 -> not present. All 0 between calls
+
+    UINT low  = DOMAIN_SIZE;
+    UINT high = 0;
+    auto update = [&low, &high](UINT index){low = std::min(low, index); high = std::max(high, index);};
+    for (const auto& it : ns)
+    {
+        if (DomainIndex(it.score) == DOMAIN_INVALID) return false;
+    }
+    for (const auto& it : ew)
+    {
+        if (DomainIndex(score::ScoreEwToNs(it.score)) == DOMAIN_INVALID) return false;
+    }
+
+    for (UINT pos = 0; pos < ns.size(); ++pos)
+    {
+        UINT index = DomainIndex(ns[pos].score);
+        nsPos[index] = pos+1;
+        update(index);
+    }
+    for (UINT pos = 0; pos < ew.size(); ++pos)
+    {
+        UINT index = DomainIndex(score::ScoreEwToNs(ew[pos].score));  // transform ew-score to a comparable ns-score
+        ewPos[index] = pos+1;
+        update(index);
+    }
+
+    CalcContext::FS_INFO merged;
+    merged.reserve(ns.size()+ew.size());
+    for (UINT index = high+1; index-- > low; )
+    {   // from high to low score
+        if (nsPos[index] == 0 && ewPos[index] == 0) continue;
+        CalcContext::FrequencyState fkw;
+        if (nsPos[index])
+            fkw = ns[nsPos[index]-1ULL];    // existing NS score
+        else
+            fkw.score = score::ScoreEwToNs(ew[ewPos[index]-1ULL].score);
+        if (ewPos[index])
+            fkw.pointsEW = ew[ewPos[index]-1ULL].points;
+        merged.push_back(fkw);
+        nsPos[index] = ewPos[index] = 0;    // ready for next call
+    }
+    ns.swap(merged);
+    return true;
+}   // MergeFrqTablesCompact()
+
+static void MergeFrqTables(CalcContext::FS_INFO& ns, const CalcContext::FS_INFO& ew)
+{   // merge the ew table into the ns table: ew scores are converted to ns scores, result is ordered from high to low
+    if ( !MergeFrqTablesCompact(ns, ew) )
+        MergeFrqTablesSorted(ns, ew);
+}   // MergeFrqTables()
+
+void CalcContext::SetSettings(const Settings& a_settings)
+{   // any change in the settings will recalculate all games
+    if ( a_settings == m_settings ) return;
+    m_settings = a_settings;
+    m_vGameCalc     .clear();
+    m_vSessionRaw   .clear();
+    m_vFrequencyInfo.clear();
+    m_vGameTops     .clear();
+    m_vDatumScores  .clear();
+    m_vButlerFkw    .clear();
+    m_vCrossImps    .clear();
+}   // SetSettings()
+
+void CalcContext::SetScoreData(const vvScoreData* a_pScoreData)
+{
+    m_pScoreData = a_pScoreData;
+}   // SetScoreData()
+
+void CalcContext::SetSchema(const std::vector<PairSchema>& a_schema)
+{
+    m_vSchema = a_schema;
+}   // SetSchema()
+
+const cor::CORRECTION_SESSION* CalcContext::GetSessionCorrection(UINT a_sessionPair) const
+{
+    auto it = m_corSessionValidated.find(a_sessionPair);
+    return it == m_corSessionValidated.end() ? nullptr : &it->second;
+}   // GetSessionCorrection()
+
+void CalcContext::AddContributions(const std::vector<PairContribution>& a_contributions, bool a_bAdd)
+{   // add (or remove) the results of one game to/from the uncorrected session result
+    for (const auto& it : a_contributions)
+    {
+        auto& total = m_vSessionRaw[it.pair];
+        if (a_bAdd)
+        {
+            total.maxScore += it.maxScore;
+            total.nrOfGames++;
+            (m_settings.bButler ? total.butlerMp : total.points) += it.points;
+        }
+        else
+        {
+            total.maxScore -= it.maxScore;
+            total.nrOfGames--;
+            (m_settings.bButler ? total.butlerMp : total.points) -= it.points;
+        }
+    }
+}   // AddContributions()
+
+void CalcContext::CalcGame(UINT a_game)
+{   // (re)calculate one game: frequency table, tops/datum and the contributions for all pairs
+    // Runs in a worker thread: only data of 'a_game' may be changed here!
+    const auto NS_SCORE = true;
+    auto& gameCalc      = m_vGameCalc[a_game];
+
+    gameCalc.sets = (*m_pScoreData)[a_game];
+    gameCalc.contributions.clear();
+    m_vGameTops[a_game] = TopsPerGame();
+    if (m_settings.bCrossImps)
+    {
+        m_vCrossImps[a_game] = CrossImpsGame();
+        CalcGameCrossImps(a_game,  NS_SCORE, gameCalc.contributions);
+        CalcGameCrossImps(a_game, !NS_SCORE, gameCalc.contributions);
+    }
+    else if (m_settings.bButler)
+    {
+        m_vDatumScores[a_game] = DatumScore();
+        m_vButlerFkw  [a_game].clear();
+        CalcGameButler (a_game,  NS_SCORE, gameCalc.contributions);
+        CalcGameButler (a_game, !NS_SCORE, gameCalc.contributions);
+        CalcButlerFkw  (a_game);
+    }
+    else
+    {
+        FS_INFO fsInfoEW;
+        m_vFrequencyInfo[a_game].clear();
+        CalcGamePercent(a_game,  NS_SCORE, m_vFrequencyInfo[a_game], gameCalc.contributions);  // first scores for NS
+        CalcGamePercent(a_game, !NS_SCORE, fsInfoEW                , gameCalc.contributions);  // then for EW
+        MergeFrqTables (m_vFrequencyInfo[a_game], fsInfoEW);        // merge ew to main table frequencyInfo
+    }
+    gameCalc.bValid = true;
+}   // CalcGame()
+
+UINT CalcContext::CalcSession(std::stop_token a_stop, const Progress& a_progress)
+{   // Only games with changed scores are (re)calculated: their old contributions are removed
+    // from the session result and the new ones are added.
+    UINT maxGame      = m_pScoreData ? score::GetNumberOfGames(*m_pScoreData) : 0;   // highest gamenr, only of the scores given by SetScoreData()
+    UINT sessionPairs = m_settings.sessionPairs;
+
+    if ( m_vSessionRaw.size() != sessionPairs+1ULL )
+    {   // start from scratch
+        m_vGameCalc  .clear();
+        m_vSessionRaw.clear();
+        m_vSessionRaw.resize(sessionPairs+1ULL);
+    }
+
+    bool bNewIndex = m_vPairGames.size() != sessionPairs+1ULL || m_vGameCalc.size() != maxGame+1ULL;
+    for (size_t game = maxGame+1ULL; game < m_vGameCalc.size(); ++game)
+        AddContributions(m_vGameCalc[game].contributions, false);     // game not present anymore
+
+    m_vGameCalc     .resize(maxGame+1ULL);
+    m_vFrequencyInfo.resize(maxGame+1ULL);
+    m_vGameTops     .resize(maxGame+1ULL);
+    if (m_settings.bCrossImps)
+        m_vCrossImps.resize(maxGame+1ULL);
+    else if (m_settings.bButler)
+    {
+        m_vDatumScores.resize(maxGame+1ULL);
+        m_vButlerFkw  .resize(maxGame+1ULL);
+    }
+
+    std::vector<UINT> changedGames;
+    for (UINT game=1; game <= maxGame; ++game)
+    {
+        const auto& gameCalc = m_vGameCalc[game];
+        if ( gameCalc.bValid && gameCalc.sets == (*m_pScoreData)[game] )
+            continue;   // nothing changed for this game
+        AddContributions(gameCalc.contributions, false);
+        m_vGameCalc[game].bValid = false;   // set again when calculated
+        changedGames.push_back(game);
+    }
+    if (bNewIndex || !changedGames.empty())
+        MakePairIndex(maxGame);     // only when the scores are changed
+
+    // games are independent: each calculation only writes the data of its own game
+    UINT              total = (UINT)changedGames.size();
+    std::atomic<UINT> done{0};
+    ParallelFor(total, [this, &changedGames, &a_stop, &a_progress, &done, total](UINT a_index)
+        {
+            if (a_stop.stop_requested()) return;    // remaining games stay invalid
+            CalcGame(changedGames[a_index]);
+            if (a_progress) a_progress(++done, total);
+        });
+
+    for (auto game : changedGames)      // add results in a fixed (game) order
+    {
+        auto& gameCalc = m_vGameCalc[game];
+        if (gameCalc.bValid)
+            AddContributions(gameCalc.contributions, true);
+        else
+            gameCalc.contributions.clear();     // stopped: already removed from the session result
+    }
+    if (a_stop.stop_requested()) return done.load();
+
+    m_vSessionResult = m_vSessionRaw;   // corrections are applied on a copy
+    ApplySessionCorrections();
+    return total;
+}   // CalcSession()
+
+namespace { // anonymous namespace for the (de)serialization of the session state
+    class StateWriter
+    {   // the state as a flat byte sequence: a vector is stored as its size followed by its elements
+    public:
+        template <typename T> void Put(const T& a_value)
+        {
+            static_assert(std::is_trivially_copyable_v<T>);
+            m_data.append(reinterpret_cast<const char*>(&a_value), sizeof(T));
+        }
+        template <typename T> void Put(const std::vector<T>& a_vector)
+        {
+            static_assert(std::is_trivially_copyable_v<T>);
+            Put(static_cast<UINT>(a_vector.size()));
+            m_data.append(reinterpret_cast<const char*>(a_vector.data()), a_vector.size() * sizeof(T));
+        }
+        std::string Take() {return std::move(m_data);}
+    private:
+        std::string m_data;
+    };  // class StateWriter
+
+    class StateReader
+    {   // reads what StateWriter has written, each Get() returns false if the data is too short
+    public:
+        explicit StateReader(const std::string& a_data) : m_data(a_data) {}
+        template <typename T> bool Get(T& a_value)
+        {
+            static_assert(std::is_trivially_copyable_v<T>);
+            if (m_data.size() - m_pos < sizeof(T)) return false;
+            std::memcpy(&a_value, m_data.data() + m_pos, sizeof(T));
+            m_pos += sizeof(T);
+            return true;
+        }
+        template <typename T> bool Get(std::vector<T>& a_vector)
+        {
+            static_assert(std::is_trivially_copyable_v<T>);
+            UINT size = 0;
+            if (!Get(size) || (m_data.size() - m_pos) / sizeof(T) < size) return false;
+            a_vector.resize(size);
+            if (size) std::memcpy(a_vector.data(), m_data.data() + m_pos, size * sizeof(T));
+            m_pos += size * sizeof(T);
+            return true;
+        }
+        bool AtEnd() const {return m_pos == m_data.size();}
+    private:
+        const std::string&  m_data;
+        size_t              m_pos = 0;
+    };  // class StateReader
+}   // anonymous namespace
+
+std::string CalcContext::GetSessionState() const
+{   // only the results of the games are stored: the pair index, the corrections and the ranks follow from them and the input
+    StateWriter state;
+    state.Put(static_cast<UINT>(m_vGameCalc.size()));
+    for (size_t game = 1; game < m_vGameCalc.size(); ++game)
+    {
+        state.Put(m_vGameCalc[game].contributions);
+        state.Put(m_vGameTops[game]);
+        if (m_settings.bCrossImps)
+        {
+            state.Put(m_vCrossImps[game].ns);
+            state.Put(m_vCrossImps[game].ew);
+        }
+        else if (m_settings.bButler)
+        {
+            state.Put(m_vDatumScores[game]);
+            state.Put(m_vButlerFkw  [game]);
+        }
+        else
+            state.Put(m_vFrequencyInfo[game]);
+    }
+    state.Put(m_vSessionRaw);
+    return state.Take();
+}   // GetSessionState()
+
+bool CalcContext::SetSessionState(const std::string& a_state)
+{   // the input must be set and be the same as the input of the calculation that made a_state
+    UINT        maxGame   = m_pScoreData ? score::GetNumberOfGames(*m_pScoreData) : 0;
+    UINT        gameCount = 0;
+    StateReader state(a_state);
+    bool        bOk       = state.Get(gameCount) && gameCount == maxGame+1ULL;
+    if (bOk)
+    {
+        m_vGameCalc     .assign(maxGame+1ULL, GameCalc());
+        m_vFrequencyInfo.assign(maxGame+1ULL, FS_INFO());
+        m_vGameTops     .assign(maxGame+1ULL, TopsPerGame());
+        if (m_settings.bCrossImps)
+            m_vCrossImps.assign(maxGame+1ULL, CrossImpsGame());
+        else if (m_settings.bButler)
+        {
+            m_vDatumScores.assign(maxGame+1ULL, DatumScore());
+            m_vButlerFkw  .assign(maxGame+1ULL, ButlerFkwTable());
+        }
+    }
+    for (UINT game = 1; bOk && game <= maxGame; ++game)
+    {
+        auto& gameCalc = m_vGameCalc[game];
+        bOk = state.Get(gameCalc.contributions) && state.Get(m_vGameTops[game]);
+        if (m_settings.bCrossImps)
+            bOk = bOk && state.Get(m_vCrossImps[game].ns) && state.Get(m_vCrossImps[game].ew);
+        else if (m_settings.bButler)
+            bOk = bOk && state.Get(m_vDatumScores[game]) && state.Get(m_vButlerFkw[game]);
+        else
+            bOk = bOk && state.Get(m_vFrequencyInfo[game]);
+        for (const auto& it : gameCalc.contributions)
+            bOk = bOk && it.pair <= m_settings.sessionPairs;
+        gameCalc.sets   = (*m_pScoreData)[game];
+        gameCalc.bValid = true;
+    }
+    bOk = bOk && state.Get(m_vSessionRaw) && m_vSessionRaw.size() == m_settings.sessionPairs+1ULL && state.AtEnd();
+    if (!bOk)
+    {   // damaged: the next CalcSession() starts from scratch
+        m_vGameCalc  .clear();
+        m_vSessionRaw.clear();
+        return false;
+    }
+
+    MakePairIndex(maxGame);
+    m_vSessionResult = m_vSessionRaw;   // corrections are applied on a copy
+    ApplySessionCorrections();
+    return true;
+}   // SetSessionState()
+
+static CalcContext::FrequencyState GetScorePoints(int a_score, UINT a_equalCount, MatchpointInfo& a_mpInfo)
+{   // matchpoints for a score, called for each different score from high to low
+    CalcContext::FrequencyState fs;
+    fs.nrOfEqualScores = a_equalCount;
+    fs.score = a_score;
+    /*
+    * Till now all scores are 'normal' integers. To prevent calculation errors when using floatingpoint,
+    * we use from now on a special FixedDecimalPoint class (Fdp) that has a fixed number of fractional
+    * digits (for now 3). It behaves like a floating point type.
+    * All normal operations are available: conversion from/to string, * / + - and all comparison operators.
+    */
+    Fdp points;
+    if (score::IsProcent(a_score))
+    {
+        points = a_mpInfo.normalTop*Fdp::FromProcent(score::Procentscore2Procent(a_score));
+        if ( a_mpInfo.bNeuberg )
+            points = points.Round(1);   // round to .1
+        else
+            points = points.Round(0);   // round to 0 decimals
+    }
+    else
+    {
+        points=1LL+a_mpInfo.top-a_equalCount;
+        a_mpInfo.top-=a_equalCount*2;                               // new 'top'
+        if ( a_mpInfo.adjustedScoreCount && a_mpInfo.bNeuberg )     // recalc points with special formule
+            points = NeubergPoints(points, a_mpInfo.sets, a_mpInfo.neubergCount);
+    }
+
+    fs.points=points;
+    fs.pointsEW = 0;
+    return fs;
+}   // GetScorePoints()
+
+void RankScoresSorted(std::vector<int>& a_scores, MatchpointInfo a_mpInfo, CalcContext::FS_INFO& a_fsInfo)
+{   // generic method: sort the scores and count equal scores
+    std::ranges::sort(a_scores, [](int a, int b){return a > b;});  // from high to low
+    size_t maxIndex = a_scores.size();
+    size_t index = 0;
+    do
+    {   // determine the different scores and there appearance count
+        int score = a_scores[index++];
+        UINT equalCount = 1;
+        while (index < maxIndex && score == a_scores[index] )
+        {
+            ++equalCount;
+            ++index;
+        }
+        a_fsInfo.push_back(GetScorePoints(score, equalCount, a_mpInfo));
+    } while (index  < maxIndex);
+}   // RankScoresSorted()
+
+bool RankScoresCompact(const std::vector<int>& a_scores, MatchpointInfo a_mpInfo, CalcContext::FS_INFO& a_fsInfo)
+{   // count the scores in the compact domain: return false (nothing done) if a score is outside the domain
+    thread_local std::vector<UINT> count(DOMAIN_SIZE);  // All 0 between calls
+
+    for (auto score : a_scores)
+    {
+        if (DomainIndex(score) == DOMAIN_INVALID) return false;
+    }
+
+    UINT low  = DOMAIN_SIZE;
+    UINT high = 0;
+    for (auto score : a_scores)
+    {
+        UINT index = DomainIndex(score);
+        ++count[index];
+        low  = std::min(low , index);
+        high = std::max(high, index);
+    }
+
+    for (UINT index = high+1; index-- > low; )
+    {   // from high to low score
+        if (count[index] == 0) continue;
+        int score = index >= DOMAIN_PROCENT_BASE
+                    ? score::Procent2Procentscore(static_cast<int>(index - DOMAIN_PROCENT_BASE))
+                    : static_cast<int>(index*10) - DOMAIN_REAL_MAX;
+        a_fsInfo.push_back(GetScorePoints(score, count[index], a_mpInfo));
+        count[index] = 0;   // ready for next call
+    }
+    return true;
+}   // RankScoresCompact()
+
+void CalcContext::CalcGamePercent(UINT game, bool bNs, FS_INFO& fsInfo, std::vector<PairContribution>& a_contributions)
+{
+    auto sets = (UINT)((*m_pScoreData)[game].size());
+    if (sets == 0) return;      // nothing to do, not played yet
+
+    UINT  adjustedScoreCount = 0;
+    std::vector<int> tmpScores;
+    for ( const auto& it : (*m_pScoreData)[game])
+    {
+        if (it.pairNS > m_settings.sessionPairs || it.pairEW > m_settings.sessionPairs)
+            continue;   // just ignore scores with a bad pair involved
+        if ( it.scoreNS == SCORE_NP || it.scoreEW == SCORE_NP )
+            continue;   // ignore explicitly non-played games!
+
+        int score = bNs ? it.scoreNS : it.scoreEW;
+        score = score::Score2Real(score);   //we only want/need real scores or %
+        tmpScores.push_back(score);
+        if (score::IsProcent(score))      // determine adjustedscore count
+            ++adjustedScoreCount;
+    }
+
+    MatchpointInfo mpInfo;
+    mpInfo.sets               = sets;
+    mpInfo.normalTop          = (sets-1)*2;
+    mpInfo.top                = mpInfo.normalTop-adjustedScoreCount;
+    mpInfo.adjustedScoreCount = adjustedScoreCount;
+    mpInfo.bNeuberg           = m_settings.bNeuberg;
+    if (mpInfo.bNeuberg)
+    {
+        mpInfo.neubergCount = sets-adjustedScoreCount;    // nr of comparable scores
+        mpInfo.top         -= adjustedScoreCount;         // == sets-1-adjustedScoreCount*2
+    }
+
+    if (bNs)
+        m_vGameTops[game].topNS = mpInfo.normalTop;
+    else
+        m_vGameTops[game].topEW = mpInfo.normalTop;
+
+    if ( tmpScores.empty() )
+        return;    // no scores ??, return to prevent outOfRange vector access
+
+    if ( !RankScoresCompact(tmpScores, mpInfo, fsInfo) )
+        RankScoresSorted(tmpScores, mpInfo, fsInfo);    // some score outside the compact domain
+
+    // now determine the results for the pairs
+    ScoreLookup lookup(fsInfo);
+    for ( const auto& it : (*m_pScoreData)[game])
+    {   // contribution for each pair that played this game
+        if (it.pairNS > m_settings.sessionPairs || it.pairEW > m_settings.sessionPairs)
+            continue;   // just ignore scores with a bad pair involved
+        PairContribution contribution;
+        contribution.pair     = bNs ? it.pairNS  : it.pairEW;
+        contribution.maxScore = (int)mpInfo.normalTop;
+        int score = bNs ? it.scoreNS : it.scoreEW;
+        score = score::Score2Real(score);   //we only want/need real scores or %
+        auto pScore = lookup.Find(score);
+        if ( pScore ) // should always be the case....
+            contribution.points = pScore->points;
+        a_contributions.push_back(contribution);
+    }
+}   // CalcGamePercent()
+
+void CalcContext::CalcGameButler(UINT a_game, bool a_bNs, std::vector<PairContribution>& a_contributions)
+{
+    auto sets = (UINT)((*m_pScoreData)[a_game].size());
+    if (sets == 0) return;      // nothing to do, not played yet
+
+    std::vector<int> tmpScores;
+    for ( const auto& it : (*m_pScoreData)[a_game])
+    {
+        if (it.pairNS > m_settings.sessionPairs || it.pairEW > m_settings.sessionPairs)
+            continue;   // just ignore scores with a bad pair involved
+        if ( it.scoreNS == SCORE_NP || it.scoreEW == SCORE_NP )
+            continue;   // ignore explicitly non-played games!
+        int score = a_bNs ? it.scoreNS : it.scoreEW;
+        if (!score::IsProcent(score))
+        {   //we only want/need real scores, percent-scores will be converted to imps lateron
+            score = score::Score2Real(score);
+            tmpScores.push_back(score);
+        }
+    }
+    if (tmpScores.size() > sButlerMinimumScores + 2)
+    {   // want at least 'sButlerMinimumScores' scores after removal of highest/lowest scores
+        // We ALWAYS round-up! So 10 scores -> 1, 11 -> 2 scores to remove
+        auto removeCount = (tmpScores.size()*sButlerRemoveScoresPercent+90)/100;
+        if (removeCount == 0) removeCount = 1;
+        // only the sum of the remaining scores is needed, so partitioning is enough: no sort
+        auto first = tmpScores.begin() + static_cast<std::ptrdiff_t>(removeCount);
+        auto last  = tmpScores.end()   - static_cast<std::ptrdiff_t>(removeCount);
+        std::ranges::nth_element(tmpScores, first, std::greater<>());          // [begin, first) : highest scores
+        std::nth_element(first, last, tmpScores.end(), std::greater<>());     // [last  , end  ) : lowest scores
+        tmpScores.erase(last, tmpScores.end());
+        tmpScores.erase(tmpScores.begin(), first);
+    }
+    // now determine datum-score
+    // int sumTest = std::accumulate(tmpScores.begin(), tmpScores.end(), 0);
+    auto count = static_cast<int>(tmpScores.size());
+    if ( count == 0 )
+        return;    // no scores ??, return to prevent outOfRange vector access or divide zero
+    int sum = 0;
+    for (auto it : tmpScores) sum += it;
+    int datumScore = sum/count; // remark: DON'T round here! -> 4.9 -> 4 -> 0 and not 4.9 -> 5 -> 10 as datum score!
+    datumScore = ((datumScore + ((datumScore<0)?-5:+5))/10)*10;   //round to nearest multiple of 10
+//    MyLogDebug("butler: %s, game=%u, scoreCount=%u, datumScore = %i", a_bNs?"NS":"EW", a_game, (UINT)count, datumScore);
+    if (a_bNs)
+        m_vDatumScores[a_game].dsNS = datumScore;
+    else
+        m_vDatumScores[a_game].dsEW = datumScore;
+    // now determine the mps for all boards/players
+    std::vector<UINT> pairs;
+    std::vector<int>  scores;
+    for ( const auto& it : (*m_pScoreData)[a_game])
+    {
+        if (it.pairNS > m_settings.sessionPairs || it.pairEW > m_settings.sessionPairs)
+            continue;   // just ignore scores with a bad pair involved
+        pairs .push_back(a_bNs ? it.pairNS  : it.pairEW);
+        scores.push_back(a_bNs ? it.scoreNS : it.scoreEW);
+    }
+    std::vector<int> imps(scores.size());
+    ButlerGetMpsFromScores(scores, datumScore, imps);   // %scores are handled in there
+    for (size_t index = 0; index < pairs.size(); ++index)
+    {
+        PairContribution contribution;
+        contribution.pair   = pairs[index];
+        contribution.points = imps[index];
+        a_contributions.push_back(contribution);
+    }
+}   // CalcGameButler()
+
+static void CalcCrossImpsTable(const std::vector<int>& a_sortedScores, CrossImpsTable& a_table)
+{   // a_sortedScores: all compared scores of a game, from low to high.
+    // The imps are constant within a bracket of suImpTable, so for a score 'x' only the number of
+    // scores in [x-high, x-low] (won) and [x+low, x+high] (lost) of each bracket is needed.
+    // As the scores are handled from low to high, the bounds of these ranges only move forward:
+    // O(scores*brackets) i.s.o. O(scores^2) for comparing each score with all other scores.
+    constexpr size_t BRACKETS = std::size(suImpTable);
+    std::array<size_t, BRACKETS> wonFirst{}, wonEnd{}, lostFirst{}, lostEnd{};
+    const size_t size   = a_sortedScores.size();
+    auto advance        = [&a_sortedScores, size](size_t& a_index, auto a_bBelow)
+        { while (a_index < size && a_bBelow(a_sortedScores[a_index])) ++a_index; };
+
+    a_table.clear();
+    for (size_t index = 0; index < size; )
+    {
+        const int score = a_sortedScores[index];
+        long long total = 0;
+        for (size_t bracket = 0; bracket < BRACKETS; ++bracket)
+        {
+            const auto& imp = suImpTable[bracket];
+            if (imp.mp == 0) continue;
+            advance(wonFirst [bracket], [score, &imp](int a_other){return a_other <  score - imp.high;});
+            advance(wonEnd   [bracket], [score, &imp](int a_other){return a_other <= score - imp.low ;});
+            advance(lostFirst[bracket], [score, &imp](int a_other){return a_other <  score + imp.low ;});
+            advance(lostEnd  [bracket], [score, &imp](int a_other){return a_other <= score + imp.high;});
+            auto won  = static_cast<long long>(wonEnd [bracket] - wonFirst [bracket]);
+            auto lost = static_cast<long long>(lostEnd[bracket] - lostFirst[bracket]);
+            total    += imp.mp * (won - lost);
+        }
+        CrossImps crossImps;
+        crossImps.score = score;
+        if (size > 1)   // average against all other scores
+            crossImps.imps = (Fdp(total)/static_cast<long long>(size-1)).Round(2);
+        a_table.push_back(crossImps);
+        while (index < size && a_sortedScores[index] == score) ++index;     // next different score
+    }
+}   // CalcCrossImpsTable()
+
+static Fdp CrossImpsFromScore(const CrossImpsTable& a_table, int a_score)
+{   // percent scores as for butler, non-played scores get 0 imps
+    if (score::IsProcent(a_score))
+        return ButlerGetMpsFromScore(a_score, 0);
+    if (a_score == SCORE_NP || a_score == SCORE_NONE)
+        return Fdp();
+    int score = score::Score2Real(a_score);
+    auto it = std::ranges::lower_bound(a_table, score, {}, &CrossImps::score);
+    return (it != a_table.end() && it->score == score) ? it->imps : Fdp();
+}   // CrossImpsFromScore()
+
+void CalcContext::CalcGameCrossImps(UINT a_game, bool a_bNs, std::vector<PairContribution>& a_contributions)
+{   // cross-imps: each score is compared with all other scores of the game, result is the average of these imps
+    const auto& sets = (*m_pScoreData)[a_game];
+    if (sets.empty()) return;   // nothing to do, not played yet
+
+    std::vector<int> tmpScores;
+    for (const auto& it : sets)
+    {
+        if (it.pairNS > m_settings.sessionPairs || it.pairEW > m_settings.sessionPairs)
+            continue;   // just ignore scores with a bad pair involved
+        if ( it.scoreNS == SCORE_NP || it.scoreEW == SCORE_NP )
+            continue;   // ignore explicitly non-played games!
+        int score = a_bNs ? it.scoreNS : it.scoreEW;
+        if (!score::IsProcent(score))   // percent-scores are not compared
+            tmpScores.push_back(score::Score2Real(score));
+    }
+    std::ranges::sort(tmpScores);
+    auto& table = a_bNs ? m_vCrossImps[a_game].ns : m_vCrossImps[a_game].ew;
+    CalcCrossImpsTable(tmpScores, table);
+
+    for (const auto& it : sets)
+    {
+        if (it.pairNS > m_settings.sessionPairs || it.pairEW > m_settings.sessionPairs)
+            continue;   // just ignore scores with a bad pair involved
+        PairContribution contribution;
+        contribution.pair   = a_bNs ? it.pairNS : it.pairEW;
+        contribution.points = CrossImpsFromScore(table, a_bNs ? it.scoreNS : it.scoreEW);
+        a_contributions.push_back(contribution);
+    }
+}   // CalcGameCrossImps()
+
+Fdp CalcContext::GetGameResult(UINT a_game, bool a_bNs, int a_score) const
+{
+    if (m_settings.bCrossImps)
+        return CrossImpsFromScore(a_bNs ? m_vCrossImps[a_game].ns : m_vCrossImps[a_game].ew, a_score);
+    if (m_settings.bButler)
+    {
+        int datumScore = a_bNs ? m_vDatumScores[a_game].dsNS : m_vDatumScores[a_game].dsEW;
+        return ButlerGetMpsFromScore(a_score, datumScore);
+    }
+
+    Fdp gameResult;
+    int score = a_bNs ? a_score : score::ScoreEwToNs(a_score);
+    score = score::Score2Real(score);
+    const auto& frqInfo = m_vFrequencyInfo[a_game];
+    auto it = std::ranges::find_if(frqInfo, [score](const auto& info){return info.score == score;});
+    if (it != frqInfo.end()) gameResult = a_bNs ? it->points : it->pointsEW;
+    return gameResult;
+}   // GetGameResult()
+
+Fdp CalcContext::GetSetResult(UINT pair, UINT firstGame, UINT nrOfGames, UINT* a_pGamesPlayed) const
+{
+    Fdp setResult;
+
+    if (a_pGamesPlayed) *a_pGamesPlayed = 0;    // nr of games played for the requested count
+    const auto& pairGames = GetPairGames(pair);
+    auto it = std::ranges::lower_bound(pairGames, firstGame, {}, &PairGame::game);
+    for (; it != pairGames.end() && it->game < firstGame+nrOfGames; ++it)
+    {   // pair has played game, so get its matchpoints
+        const auto& setInfo = (*m_pScoreData)[it->game][it->set];
+        int score = it->bNs ? setInfo.scoreNS : setInfo.scoreEW;
+        setResult += GetGameResult(it->game, it->bNs, score);
+        if (a_pGamesPlayed) (*a_pGamesPlayed )++;
+    }
+    return setResult;
+}   // GetSetResult()
+
+void CalcContext::MakePairIndex(UINT a_maxGame)
+{   // one pass over all scores, so the games of a pair can be found without searching
+    m_vPairGames.clear();
+    m_vPairGames.resize(m_settings.sessionPairs+1ULL);
+    auto addGame = [this](UINT a_pair, UINT a_game, UINT a_set, bool a_bNs)
+        {
+            if (a_pair == 0 || a_pair >= m_vPairGames.size()) return;     // bad pairnr
+            auto& pairGames = m_vPairGames[a_pair];
+            if (pairGames.empty() || pairGames.back().game != a_game)  // only the first set, if a pair is found more then once
+                pairGames.push_back({a_game, a_set, a_bNs});
+        };
+
+    for (UINT game = 1; game <= a_maxGame; ++game)
+    {
+        const auto& sets = (*m_pScoreData)[game];
+        for (UINT set = 0; set < sets.size(); ++set)
+        {
+            addGame(sets[set].pairNS, game, set, true );
+            addGame(sets[set].pairEW, game, set, false);
+        }
+    }
+}   // MakePairIndex()
+
+const std::vector<CalcContext::PairGame>& CalcContext::GetPairGames(UINT a_sessionPair) const
+{
+    static const std::vector<PairGame> svNoGames;
+    return a_sessionPair < m_vPairGames.size() ? m_vPairGames[a_sessionPair] : svNoGames;
+}   // GetPairGames()
+
+const CalcContext::PairGame* CalcContext::FindPairGame(UINT a_sessionPair, UINT a_game) const
+{
+    const auto& pairGames = GetPairGames(a_sessionPair);
+    auto it = std::ranges::lower_bound(pairGames, a_game, {}, &PairGame::game);
+    return (it != pairGames.end() && it->game == a_game) ? &*it : nullptr;
+}   // FindPairGame()
+
+static Fdp NeubergPoints(const Fdp& points, UINT gameCount, UINT comparableCount)
+{   // https://www.bridgeservice.nl/NBB-rekenprogramma/Vraag%20&%20Antwoord%2003.pdf
+    //SN = (Sn + 1) * N/n - 1    // Sn=points, N=gameCount, n=comparableCount
+    Fdp tmp = ((points+1)*gameCount)/comparableCount - 1;
+    tmp.Round(1);   // TOODO: check if we need round/trunc for some values, see original function
+    return tmp;
+}   // NeubergPoints()
+
+#if 0
+long CalcScore::NeubergPoints(long points, UINT gameCount, UINT comparableCount)
+{   // https://www.bridgeservice.nl/NBB-rekenprogramma/Vraag%20&%20Antwoord%2003.pdf
+    //SN = (Sn + 1) * N/n - 1    // Sn=points, N=gamecCount, n=comparableCount
+    long nbpoints;
+    long temp;
+    // input 'points' are the 'real' points, return value = points*10: so 10.1 --> 101
+    switch (comparableCount)
+    {
+    case 2: // (points/10.0+1.1)*(gameCount-1);
+        nbpoints = (points+11L)*(gameCount-1);
+        break;
+    case 3: // (points/10.0+1.0)*(gameCount-1);
+        nbpoints = (points+10L)*(gameCount-1);
+        break;
+    default:// (points+1)*gameCount/comparable - 1;
+        temp = 100L*(points+1)*gameCount;
+        nbpoints = temp/comparableCount - 100L;
+        if ((temp % comparableCount) == 0)  //multiples!
+            if (((temp/comparableCount) % 10) == 5) // x.x5!!!
+                if (nbpoints > 100L*((long)gameCount-1)) //above medium
+                    nbpoints -= 5;  // ?.?5 --> ?.?0
+                                    //above medium: medium multiples of .05 get a cutoff!
+        nbpoints = (nbpoints+5)/10; //round to 1 digit after dp
+    }
+    return nbpoints;
+}   // NeubergPoints()
+#endif
+
+void CalcContext::ApplySessionCorrections()
+{
+    m_maxPair = 1;
+
+    for (UINT pair = 1; pair < m_vSessionResult.size(); ++pair)
+    {
+        if (m_vSessionResult[pair].nrOfGames == 0)  // valid for percent AND butler score
+            continue;    // pair did not play any game, so no corrections possible
+        if ( !m_settings.bButler && m_vSessionResult[pair].maxScore == 0 )
+            continue;   // ??? will get divide by zero: not enough data present
+
+        Fdp     correctionProcent;
+        auto    it            = m_corSessionValidated.find(pair);
+        Fdp     butlerCorImps;  // corrections in imps for butler
+
+        m_maxPair = pair;
+        if (it != m_corSessionValidated.end())
+        {
+            cor::CORRECTION_SESSION cs = it->second;
+            // now handle the different types of correction
+            if (cs.correction)
+            {   // some correction in 'mp' or '% '
+                if (cs.type == '%')
+                {
+                    correctionProcent = cs.correction;
+                    //butlerCorImps = cs.correction*sButlerImpsPer10Procent;
+                }
+                else
+                {   // assume imps in % calculation. If butler, then .points is ignored...
+                    m_vSessionResult[pair].points += cs.correction;
+                    butlerCorImps = cs.correction;
+                }
+            }
+
+            if (cs.maxExtra)    // can ONLY be true, if no butler!
+            {   // from a combi-table, calculated separately!
+                UINT combiTop  = 2 * (m_vSchema[pair].rounds - 1);
+                UINT normalTop = m_settings.sessionPairs - 2 - 2;
+                Fdp  extra     = ((normalTop*cs.extra)/combiTop).Round(1);
+                int  maxExtra  = RoundLong(normalTop * (long)cs.maxExtra, combiTop);    // CodeQL
+                m_vSessionResult[pair].points   += extra;
+                m_vSessionResult[pair].maxScore += maxExtra;
+            }
+            else
+                butlerCorImps += cs.extra;
+
+            m_vSessionResult[pair].nrOfGames += cs.games;
+        }   // end of correction calculation
+
+        //  now all corrections are handled: mp and combinationtables are in (max)points, the '%' waits in scoreProcent
+        if (m_settings.bButler)
+        {
+            m_vSessionResult[pair].procentScore = // for now: too many things depend on it
+            m_vSessionResult[pair].mpPerGame = ((butlerCorImps + m_vSessionResult[pair].butlerMp)/ (int)m_vSessionResult[pair].nrOfGames).Round(2);
+            m_vSessionResult[pair].butlerMp += butlerCorImps;
+        }
+        else
+            m_vSessionResult[pair].procentScore = correctionProcent + ((100*m_vSessionResult[pair].points)/m_vSessionResult[pair].maxScore).Round(2);
+    }
+    m_maxPair = std::min(m_maxPair, m_settings.sessionPairs);    // no more then we have active players!
+    RankColumn rankColumn(m_maxPair+1ULL);
+    for (UINT pair = 0; pair <= m_maxPair; ++pair)
+        rankColumn[pair] = {m_vSessionResult[pair].procentScore, m_vSessionResult[pair].nrOfGames != 0};
+    SortOnRank(m_vSessionRankToPair, rankColumn);
+    UINT lastPair = m_vSessionRankToPair[m_maxPair];
+    if (m_vSessionResult[lastPair].nrOfGames == 0)
+        m_vSessionRankToPair[m_maxPair] = 0; // pair is absent, so no rank
+    InitPairToRankVector(m_vSessionRankToPair, m_vSessionPairToRank, [&rankColumn](UINT pair){return rankColumn[pair].score;});
+}   // ApplySessionCorrections()
+
+static void CalcTotalSub(ScoreInfo& a_pairResult, UINT a_absentCount, const Fdp& a_maxMean, bool& a_bBonus)
+{   // CalcTotal() helper: calc real totals and averages
+    auto  sessionCount = a_pairResult.nrOfSessions;
+    a_pairResult.avgW.Round(2);     // need 2 decimals, else we could get differences when 
+    a_pairResult.avgN.Round(2);     //  multiplied by 2 or more (a_absentCount or sessioncount)
+
+    if ( a_absentCount != 0 )
+    {   // correct average/total if not always present
+        auto  presentCount  = sessionCount-a_absentCount;
+        const auto& MAX_MEAN = a_maxMean;
+
+        // Weighted stuf : *W
+        if ( a_pairResult.avgW > MAX_MEAN )
+        {
+            a_pairResult.avgAbsentW = MAX_MEAN;
+            a_pairResult.totalW     = a_pairResult.avgW*presentCount + MAX_MEAN*a_absentCount;
+            a_pairResult.avgW       = a_pairResult.totalW/sessionCount;
+        }
+        else
+        {
+            a_pairResult.avgAbsentW = a_pairResult.avgW;
+            a_pairResult.totalW     = a_pairResult.avgW*sessionCount;
+        }
+
+        // Normal/non-weighted stuf
+        if ( a_pairResult.avgN > MAX_MEAN ) // too big: take max average
+        {
+            a_pairResult.avgAbsentN = MAX_MEAN;
+            a_pairResult.totalN    += MAX_MEAN*a_absentCount;
+            a_pairResult.avgN       = a_pairResult.totalN/sessionCount;
+        }
+        else
+        {
+            a_pairResult.avgAbsentN = a_pairResult.avgN;
+            a_pairResult.totalN    += a_pairResult.avgN*a_absentCount;
+        }
+    }   // end of not always present
+    else
+    {   // always present
+        //a_pairResult.totalN; this is already correct, so do nothing
+        a_pairResult.totalW     = a_pairResult.avgW*sessionCount;
+        a_pairResult.avgAbsentW = a_pairResult.avgW;    // not used anymore, but nice to have an overview
+        a_pairResult.avgAbsentN = a_pairResult.avgN;    // not used anymore, but nice to have an overview
+    }
+
+    if ( a_pairResult.bonus )
+    {   // adjust total and running average
+        a_pairResult.totalN  += a_pairResult.bonus;
+        a_pairResult.avgN     = a_pairResult.totalN/a_pairResult.nrOfSessions;
+        a_pairResult.totalW  += a_pairResult.bonus;
+        a_pairResult.avgW     = a_pairResult.totalW/a_pairResult.nrOfSessions;
+        a_bBonus              = true;
+    }
+    else
+        a_bBonus = false;
+}   // CalcTotalSub()
+
+/* static */ void CalcContext::AddSessionToTotal(cor::CUMULATIVE_TOTAL& a_total, const cor::CORRECTION_END& a_sessionResult, UINT a_gamesInSession)
+{   // CalcTotal() helper: add the (corrected) result of one session to the running totals of a pair
+    const Fdp& score = a_sessionResult.score;
+    if (score == SCORE_NO_TOTAL)
+    {
+        ++a_total.noTotalCount;
+        return;
+    }
+    UINT games = a_sessionResult.games;
+    if (games == 0)
+        ++a_total.absentCount;
+    else
+    {
+        ++a_total.activeSessions;
+        if ( a_gamesInSession != games )    // not played all games, so weighted avg can/will be different
+            a_total.bWeightedAvg = true;
+        a_total.totalN          += score;
+        a_total.totalGameScoreW += games*score;
+        a_total.gameCount       += games;
+    }
+    a_total.bonus += a_sessionResult.bonus;
+}   // AddSessionToTotal()
+
+bool CalcContext::CalcTotal(const cor::mCumulativeTotals& a_totals, UINT a_maxSession, UINT a_globalPairs, const TotalSettings& a_settings)
+{   // total/end result from the running totals of sessions 1..a_maxSession
+    m_vTotalResult.clear();
+    m_vTotalResult.resize(a_globalPairs+1ULL);
+    bool bBonus4Display = false;
+    for (UINT pair=1; pair <= a_globalPairs; ++pair)   // calc total+average
+    {
+        auto itTotal = a_totals.find(pair);
+        const auto& total       = itTotal != a_totals.end() ? itTotal->second : cor::CUMULATIVE_TOTAL();
+        UINT absentCount        = total.absentCount;
+        auto& pairResult        = m_vTotalResult[pair];
+        pairResult.nrOfSessions = a_maxSession - total.noTotalCount;  // played sessions that account to end/total result
+        pairResult.activeSessions   = total.activeSessions;
+        pairResult.bHasPlayed       = total.activeSessions != 0;    // at least played once in all sessions
+        pairResult.bWeightedAvg     = total.bWeightedAvg;
+        pairResult.totalN           = total.totalN;
+        pairResult.totalGameScoreW  = total.totalGameScoreW;
+        pairResult.gameCount        = total.gameCount;
+        pairResult.bonus            = total.bonus;
+        if (pairResult.activeSessions)
+            pairResult.avgN = pairResult.totalN/pairResult.activeSessions;
+        if (pairResult.gameCount)
+            pairResult.avgW = pairResult.totalGameScoreW/pairResult.gameCount;
+
+        if ( absentCount > a_settings.maxAbsent || absentCount == a_maxSession || pairResult.gameCount == 0 )
+        {   // if too often or always absent, don't rank pair
+            pairResult.totalN        = 0;
+            pairResult.avgN          = 0;
+            pairResult.avgAbsentN    = 0;
+            pairResult.totalW        = 0;
+            pairResult.avgW          = 0;
+            pairResult.avgAbsentW    = 0;
+            pairResult.bNoTotal      = true;
+            continue;
+        }
+
+        CalcTotalSub(pairResult, absentCount, a_settings.maxMean, bBonus4Display);  // do the magic
+    }   // end for all pairs
+
+    RankColumn rankColumn(a_globalPairs+1ULL);
+    for (UINT pair = 0; pair <= a_globalPairs; ++pair)
+    {
+        const auto& pairResult = m_vTotalResult[pair];
+        rankColumn[pair] = {a_settings.bWeightedAvg ? pairResult.totalW : pairResult.totalN, pairResult.bHasPlayed};
+    }
+    SortOnRank(m_vTotalRankToPair, rankColumn);
+
+    for (auto it = m_vTotalRankToPair.rbegin(); it != m_vTotalRankToPair.rend(); ++it)
+    {
+        if (m_vTotalResult[*it].bHasPlayed) break;  // from here on, all pairs have played
+        *it = 0;    // set pair-id to 0 if pair has not played yet, so has no rank yet
+    }
+
+    InitPairToRankVector(m_vTotalRankToPair, m_vTotalPairToRank, [this](UINT pair){return m_vTotalResult[pair].totalN;});
+    return bBonus4Display;
+}   // CalcTotal()
+
+static long GetDelta(long score, long datum)
+{
+    return score::IsProcent(score) ? 0 : score::Score2Real(score)-datum;
+}   // GetDelta()
+
+void CalcContext::CalcButlerFkw(UINT a_game)
+{   // called when 'agame' is calculated, so datum-scores are available
+    const auto& sets = (*m_pScoreData)[a_game];
+    if ( sets.empty() )
+        return; // game not played
+
+    std::vector<int> scoresNs, scoresEw;
+    for (const auto& it : sets)
+    {
+        scoresNs.push_back(it.scoreNS);
+        scoresEw.push_back(it.scoreEW);
+    }
+    std::vector<int> impsNs(sets.size());
+    std::vector<int> impsEw(sets.size());
+    ButlerGetMpsFromScores(scoresNs, m_vDatumScores[a_game].dsNS, impsNs);
+    ButlerGetMpsFromScores(scoresEw, m_vDatumScores[a_game].dsEW, impsEw);
+
+    ButlerFkwTable table;
+    for (size_t index = 0; index < sets.size(); ++index)
+    {
+        ButlerFkw fkw;
+        fkw.bInit   = true;
+        fkw.scoreNs = scoresNs[index];
+        fkw.deltaNs = GetDelta(fkw.scoreNs, m_vDatumScores[a_game].dsNS);
+        fkw.impsNs  = impsNs[index];
+        fkw.scoreEw = scoresEw[index];
+        fkw.deltaEw = GetDelta(fkw.scoreEw, m_vDatumScores[a_game].dsEW);
+        fkw.impsEw  = impsEw[index];
+        table.push_back(fkw);
+    }
+
+    // order on NS score, for equal NS scores only the last one is kept
+    std::ranges::stable_sort(table, {}, &ButlerFkw::scoreNs);
+    auto& gameTable = m_vButlerFkw[a_game];
+    gameTable.clear();
+    for (size_t index = 0; index < table.size(); ++index)
+    {
+        if (index+1 == table.size() || table[index+1].scoreNs != table[index].scoreNs)
+            gameTable.push_back(table[index]);
+    }
+
+    if (0) for ( const auto& data : gameTable)
+        MyLogDebug("Game=%2u, scoreNs=%6s, delta=%5ld, imps=%3i, scoreEw=%6s, delta=%5ld, imps=%3i"
+            , a_game
+            , score::ScoreToString(data.scoreNs)
+            , data.deltaNs
+            , data.impsNs
+            , score::ScoreToString(data.scoreEw)
+            , data.deltaEw
+            , data.impsEw
+        );
+
+}   //CalcButlerFkw()
+
+wxString CalcContext::SetSessionCorrections(const cor::mCorrectionsSession& a_nonValidatedCorrections)
+{   // validate session corrections once, so we don't constantly need to check its validity
+    bool bButler       = m_settings.bButler;
+    m_bHaveValidCombi  = false;
+    m_bHaveValidNormal = false;
+    m_corSessionValidated.clear();
+    wxString errorMsg;
+
+    for (const auto& [pair, correction] : a_nonValidatedCorrections)
+    {
+        constexpr auto OK_NORMAL = 1;
+        constexpr auto OK_COMBI  = 2;
+        UINT state = 0;
+        cor::CORRECTION_SESSION cs;
+
+        if ( pair > 0 && pair <= m_settings.sessionPairs )
+            cs = correction;
+        if ( cs.correction )
+        {   // 'normal' correction
+            if ( cs.type == '%' && bButler )
+            {   // butler can't have % correction
+                cs.correction = 0;
+            }
+            else
+                state |= OK_NORMAL;    // set valid normal state
+        }
+
+        if ( cs.maxExtra || cs.extra || cs.games )
+        {   // combi data
+            do
+            {
+                if ( pair >= m_vSchema.size() || !m_vSchema[pair].bCombiCandidate )
+                {
+                    cs.extra = cs.maxExtra = cs.games = 0;
+                    break;
+                }
+                if ( cs.games == 0 )
+                {
+                    cs.extra = cs.maxExtra =  0;
+                    break;
+                }
+                if ( bButler )
+                {
+                    if ( cs.maxExtra )
+                        cs.extra = cs.maxExtra = cs.games = 0;
+                    else
+                        state |= OK_COMBI;
+                    break;
+                }
+                if ( (cs.maxExtra < cs.extra) || (cs.maxExtra == 0) || (cs.extra < 0) )
+                    cs.extra = cs.maxExtra = cs.games = 0;
+                else
+                    state |= OK_COMBI;
+            } while (false);
+        }
+
+        if ( state )    // some valid data
+        {
+            m_bHaveValidNormal |= 0 != (state & OK_NORMAL);
+            m_bHaveValidCombi  |= 0 != (state & OK_COMBI);
+            m_corSessionValidated[pair] = cs;
+        }
+
+        if ( cs != correction )
+        {   // some bad data ignored, accumulate errors and show them all at once
+            errorMsg += FMT("\n: '%u, %+i%c, %s,%i,%u'"
+                                , pair
+                                , correction.correction
+                                , correction.type
+                                , correction.extra.AsString1E()
+                                , correction.maxExtra
+                                , correction.games
+                            );
+        }
+    }   // for()
+
+    return errorMsg;
+}   // SetSessionCorrections()
+
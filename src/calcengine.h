@@ -0,0 +1,234 @@
+﻿// Copyright(c) 2024-present, BusyHarry/h.levels & BridgeWx contributors.
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#if !defined _CALC_ENGINE_H_
+#define _CALC_ENGINE_H_
+#pragma once
+
+#include <vector>
+#include <string>
+#include <functional>
+#include <stop_token>
+#include <wx/string.h>
+#include "utils.h"
+#include "fdp.h"
+#include "score.h"
+#include "corrections.h"
+
+struct Total                    // session-results for a player
+{
+    int  maxScore       = 0;    // in MP for % calculation
+    UINT nrOfGames      = 0;    // total played games
+    Fdp  points            ;    // earned MP     (x.y)
+    Fdp  procentScore      ;    // score in %    (x.yy)
+    Fdp  butlerMp          ;    // butler: total of imps voor all games
+    Fdp  mpPerGame         ;    // butler: imps/game, used for session result
+};
+
+struct ScoreInfo
+{   // 'N' = normal, non-weighted, 'W' = weighted calculation
+    Fdp  totalN;                                // total for non-weighted avg
+    Fdp  totalW;                                // sum of sessionwAvg[i], corrected for absent session(s)
+    Fdp  avgN;                                  // real          avg over played games
+    Fdp  avgW;                                  // real weighted avg over played games
+    Fdp  avgAbsentN;                            // avg for absent sessions for non-weighted
+    Fdp  avgAbsentW;                            // avg for absent sessions for weighted
+    Fdp  bonus;                                 // sum of bonusses
+    bool bWeightedAvg       = false;            // true, if not always played all games
+    bool bHasPlayed         = false;            // true, if played at least 1 game
+    UINT nrOfSessions       = 0;                // number of sessions included in total/end result
+    Fdp  totalGameScoreW;                       // sum of sessionResult[i]*sessionGames[i] for weighted calculation
+    UINT gameCount          = 0;                // sum of sessionGames[i]
+    UINT activeSessions     = 0;                // sessions with data
+    bool bNoTotal           = false;            // if set, pair is not ranked in total
+};
+
+struct TopsPerGame
+{
+    UINT topNS = 0;
+    UINT topEW = 0;
+};
+
+struct DatumScore{int dsNS=0; int dsEW=0;};
+
+struct ButlerFkw{bool bInit = false; long scoreNs=0;long deltaNs=0; int impsNs=0; long scoreEw=0; long deltaEw=0;int impsEw=0;};
+using ButlerFkwTable = std::vector<ButlerFkw>;    // ordered on scoreNs from low to high, each scoreNs only once
+
+struct CrossImps{int score=0; Fdp imps;};           // average imps of 'score' against all other scores of a game
+using CrossImpsTable = std::vector<CrossImps>;      // ordered on score from low to high, each score only once
+struct CrossImpsGame{CrossImpsTable ns; CrossImpsTable ew;};
+
+int ButlerGetMpsFromScore(int score, int datumScore);   // imps for a score against the datum score
+
+class CalcContext
+{   // The calculation engine: owns all state of a session- and total-calculation.
+    // Input is given explicitly (settings, scores, schema, corrections), there is no access to
+    // the ui or the global configuration. So more contexts can calculate at the same time.
+public:
+    struct Settings
+    {   // all settings, besides the scores, that determine the result of a game
+        bool bButler      = false;
+        bool bCrossImps   = false;  // butler: cross-imps i.s.o. a datum score
+        bool bNeuberg     = false;
+        UINT sessionPairs = 0;      // sum of pairs in all groups
+        bool operator == (const Settings&) const = default;
+    };
+
+    struct TotalSettings
+    {   // settings for the total/end result
+        UINT maxAbsent    = 0;      // max times allowed to be not present
+        Fdp  maxMean;               // max mean when absent
+        bool bWeightedAvg = false;  // rank on the weighted average
+    };
+
+    struct PairSchema
+    {   // info from the schema of a session pair, needed for combi corrections
+        UINT rounds          = 0;       // number of rounds according schema for this pair
+        bool bCombiCandidate = false;   // true, if pair plays against 'absent pair'
+    };
+
+    using FrequencyState = struct FrequencyState
+    {
+        int     score           = 0;
+        UINT    nrOfEqualScores = 0;
+        Fdp     points;
+        Fdp     pointsEW;
+    };
+
+    struct PairGame
+    {   // a game played by a session pair: where to find its score
+        UINT game = 0;
+        UINT set  = 0;              // index in the scores of this game
+        bool bNs  = false;
+    };
+
+    using FS_INFO = std::vector<FrequencyState>;
+    using FS      = std::vector<FS_INFO>;
+    using Progress= std::function<void(UINT done, UINT total)>;    // called from worker threads!
+
+    // input: set before calculating. Settings must be set before the corrections are validated
+    void        SetSettings             (const Settings& settings);
+    void        SetScoreData            (const vvScoreData* pScoreData);    // scores must stay valid while using this context
+    void        SetSchema               (const std::vector<PairSchema>& schema);    // [sessionPair]
+    wxString    SetSessionCorrections   (const cor::mCorrectionsSession& corrections);  // validate and keep ONLY correct (combi-)data, returns info on ignored data
+
+    // calculations
+    UINT        CalcSession             (std::stop_token stop = {}, const Progress& progress = nullptr);   // (re)calculate changed games and the session result, returns nr of calculated games
+                                                // if stopped, the session result is not updated: the next call continues with the remaining games
+    bool        CalcTotal               (const cor::mCumulativeTotals& totals, UINT maxSession, UINT globalPairs, const TotalSettings& settings);    // returns true if a pair has a bonus
+    static void AddSessionToTotal       (cor::CUMULATIVE_TOTAL& total, const cor::CORRECTION_END& sessionResult, UINT gamesInSession);
+
+    // stored results: a session with unchanged input need not be calculated again
+    std::string GetSessionState         () const;                   // results of the last complete CalcSession(), to store them
+    bool        SetSessionState         (const std::string& state); // results of a CalcSession() with the same input, false if damaged
+
+    // results
+    const Settings&                 GetSettings         () const {return m_settings;}
+    const vvScoreData&              GetScoreData        () const {return *m_pScoreData;}
+    UINT                            GetMaxPair          () const {return m_maxPair;}        // highest pairnr played in this session
+    const std::vector<Total>&       GetSessionResult    () const {return m_vSessionResult;}
+    const std::vector<UINT>&        GetSessionRankToPair() const {return m_vSessionRankToPair;}
+    const std::vector<UINT>&        GetSessionPairToRank() const {return m_vSessionPairToRank;}
+    const std::vector<ScoreInfo>&   GetTotalResult      () const {return m_vTotalResult;}
+    const std::vector<UINT>&        GetTotalRankToPair  () const {return m_vTotalRankToPair;}
+    const std::vector<UINT>&        GetTotalPairToRank  () const {return m_vTotalPairToRank;}
+    const FS_INFO&                  GetFrequencyInfo    (UINT game) const {return m_vFrequencyInfo[game];}
+    const TopsPerGame&              GetGameTops         (UINT game) const {return m_vGameTops[game];}
+    const DatumScore&               GetDatumScore       (UINT game) const {return m_vDatumScores[game];}
+    const ButlerFkwTable&           GetButlerFkw        (UINT game) const {return m_vButlerFkw[game];}
+    const cor::CORRECTION_SESSION*  GetSessionCorrection(UINT sessionPair) const;  // validated correction, nullptr if none
+    const std::vector<PairGame>&    GetPairGames        (UINT sessionPair) const;  // all games played by a pair, ordered on game
+    const PairGame*                 FindPairGame        (UINT sessionPair, UINT game) const;   // nullptr if not played
+    bool                            HaveValidCombi      () const {return m_bHaveValidCombi;}
+    bool                            HaveValidNormal     () const {return m_bHaveValidNormal;}
+    Fdp                             GetGameResult       (UINT game, bool bNs, int score) const;    // mp/imps for a score of a game
+    Fdp                             GetSetResult        (UINT pair, UINT firstGame, UINT nrOfGames, UINT* pGamesPlayed = nullptr) const;  // earned match-points for wanted games
+
+private:
+    struct PairContribution
+    {   // what one game adds to the (uncorrected) session result of one pair
+        UINT pair       = 0;
+        int  maxScore   = 0;    // %     : top of this game
+        Fdp  points;            // %     : earned MP, butler: imps
+    };
+
+    struct GameCalc
+    {   // calculation state of one game, kept so only changed games need a recalculation
+        bool                                bValid = false;     // false -> game must be (re)calculated
+        std::vector<score::GameSetData>     sets;               // scores used for the last calculation of this game
+        std::vector<PairContribution>       contributions;      // per set and direction: result for a pair
+    };
+
+    void        AddContributions        (const std::vector<PairContribution>& contributions, bool bAdd);
+    void        CalcGame                (UINT game);
+    void        CalcGamePercent         (UINT game, bool bNs, FS_INFO& fsInfo, std::vector<PairContribution>& contributions);
+    void        CalcGameButler          (UINT game, bool bNs, std::vector<PairContribution>& contributions);
+    void        CalcGameCrossImps       (UINT game, bool bNs, std::vector<PairContribution>& contributions);
+    void        CalcButlerFkw           (UINT game);
+    void        ApplySessionCorrections ();     // apply corrections to the session result
+    void        MakePairIndex           (UINT maxGame);
+
+    Settings                        m_settings;                 // settings used for the games in m_vGameCalc
+    const vvScoreData*              m_pScoreData = nullptr;
+    std::vector<PairSchema>         m_vSchema;                  // [sessionPair]
+    cor::mCorrectionsSession        m_corSessionValidated;      // contains ONLY correct (combi-)data
+    bool                            m_bHaveValidCombi  = false;
+    bool                            m_bHaveValidNormal = false;
+
+    std::vector<GameCalc>           m_vGameCalc;                // per game: last calculation state
+    std::vector<Total>              m_vSessionRaw;              // sum of all game contributions, before corrections
+    FS                              m_vFrequencyInfo;           // combined frq table for all games
+    std::vector<TopsPerGame>        m_vGameTops;                // max points per game for NS/EW
+    std::vector<DatumScore>         m_vDatumScores;
+    std::vector<ButlerFkwTable>     m_vButlerFkw;
+    std::vector<CrossImpsGame>      m_vCrossImps;               // per game: cross-imps for all NS and EW scores
+    std::vector<std::vector<PairGame> > m_vPairGames;           // [sessionPair] -> games played, index on the scores
+
+    UINT                            m_maxPair = 1;              // highest pairnr played in this session
+    std::vector<Total>              m_vSessionResult;           // session result for all pairs
+    std::vector<UINT>               m_vSessionRankToPair;       // index array for session results: [a]=b -> at rank 'a' is sessionpair 'b'
+    std::vector<UINT>               m_vSessionPairToRank;       // index array for session results: [a]=b -> sessionpair 'a' has rank 'b'
+    std::vector<ScoreInfo>          m_vTotalResult;             // total result for all pairs
+    std::vector<UINT>               m_vTotalRankToPair;         // index array for total results: [a]=b -> at rank 'a' is globalpair 'b'
+    std::vector<UINT>               m_vTotalPairToRank;         // index array for total results: [a]=b -> globalpair 'a' has rank 'b'
+};
+
+// The matchpoint and ranking kernels of the calculation. Public for the comparisons with the generic code in benchmarks.cpp
+struct MatchpointInfo
+{   // info needed to convert a ranked score of a game to matchpoints
+    UINT sets               = 0;        // number of sets that played the game
+    UINT normalTop          = 0;        // top without any adjusted scores
+    UINT top                = 0;        // points for the next (lower) score, updated by GetScorePoints()
+    UINT adjustedScoreCount = 0;        // number of %-scores
+    UINT neubergCount       = 0;        // nr of comparable scores when using neuberg
+    bool bNeuberg           = false;
+};
+
+struct RankKey
+{   // only the data needed for ranking, in one dense column: sorting does not touch the (large) result structs
+    Fdp  score;
+    bool bRanked = false;       // false: pair has not played (yet)
+};
+using RankColumn = std::vector<RankKey>;
+
+void SortOnRank         (std::vector<UINT>& rankToPair, const RankColumn& column);                                 // rankToPair[0] stays 0, the pairs are sorted on decreasing score
+void RankScoresSorted   (std::vector<int>& scores, MatchpointInfo mpInfo, CalcContext::FS_INFO& fsInfo);           // generic: sort the scores and count equal scores
+bool RankScoresCompact  (const std::vector<int>& scores, MatchpointInfo mpInfo, CalcContext::FS_INFO& fsInfo);     // count in the compact domain, false (nothing done) if a score is outside it
+
+class ScoreLookup
+{   // find the entry of a score in a frequency table: direct index if possible, else a linear search
+public:
+    explicit ScoreLookup(const CalcContext::FS_INFO& fsInfo);
+   ~ScoreLookup();
+    ScoreLookup(const ScoreLookup&) = delete;
+    ScoreLookup& operator=(const ScoreLookup&) = delete;
+
+    const CalcContext::FrequencyState* Find(int score) const;   // nullptr if not present
+
+private:
+    const CalcContext::FS_INFO&           m_fsInfo;
+    bool                                m_bCompact = false;
+    static thread_local std::vector<UINT> smPos;  // position+1 in m_fsInfo, 0 -> not present. All 0 when not in use
+};
+
+#endif
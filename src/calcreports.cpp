@@ -0,0 +1,1449 @@
+﻿// Copyright(c) 2024-present, BusyHarry/h.levels & BridgeWx contributors.
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#include <wx/intl.h>
+#include <wx/filename.h>
+#include <wx/base64.h>
+
+#include "cfg.h"
+#include "score.h"
+#include "calcreports.h"
+#include "corrections.h"
+#include "names.h"
+#include "fileio.h"
+
+static void AddHeader(MyTextFile& a_file);
+static bool IsCombiCandidate (UINT sessionPair);    // true, if pair plays against 'absent pair'
+static UINT GetNumberOfRounds(UINT sessionPair);    // number of rounds according schema for this pair
+
+void CalcReports::GetSessionCorrectionStrings(UINT a_sessionPair, wxString& a_sCombiResult, wxString& a_sCorrectionResult) const
+{   // get combi/corrections for a sessionPair as strings
+    a_sCombiResult.Clear();
+    a_sCorrectionResult.Clear();
+    auto pCorrection = m_calc.GetSessionCorrection(a_sessionPair);
+    if ( pCorrection == nullptr ) return;                   // no results, if pair has no corrections
+
+    if ( pCorrection->games )
+    {   // combi
+        Fdp  tmp   = pCorrection->extra;
+        long extra = tmp.Trunc(0).AsLong();
+        a_sCombiResult = m_bButler
+            ? FMT("%ldi"  , extra) // don't show fractional value!
+            : FMT("%ld/%d", extra, pCorrection->maxExtra);
+    }
+
+    int correction = pCorrection->correction;
+    if ( correction )
+    {   // only non-zero is a real correction
+        a_sCorrectionResult = FMT("%d%s", correction
+                                        , pCorrection->type == '%'
+                                            ? "%"
+                                            : ( m_bButler
+                                                    ? "i"
+                                                    : "mp"
+                                              )
+                                 );
+    }
+}   // GetSessionCorrectionStrings()
+
+bool CalcReports::Calculate()
+{
+    if (!Prepare()) return false;
+    (void)CalcGames();
+    MakeReports();
+    return true;
+}   // Calculate()
+
+bool CalcReports::Prepare()
+{
+    (void)PrepareInput();
+    return !m_bReportsValid;
+}   // Prepare()
+
+bool CalcReports::PrepareInput()
+{   // only the input that is in memory is copied here, CalcGames() reads the rest without using any global data
+    if (!ConfigChanged() && m_bInputValid) return false;
+    m_vMessages.clear();                            // only the messages of the last calculation
+    m_bInputValid          = true;
+    m_bInputRead           = false;
+    m_bReportsValid        = false;
+    m_bCalculated          = false;
+    m_bScriptTesting       = cfg::IsScriptTesting();
+    m_session              = cfg::GetActiveSession();
+    m_bButler              = cfg::GetButler();
+    m_bCrossImps           = m_bButler && cfg::GetCrossImps();
+    m_numberOfSessionPairs = cfg::GetNrOfSessionPairs();
+
+    m_vSchema.assign(m_numberOfSessionPairs+1ULL, CalcContext::PairSchema());
+    for (UINT pair = 1; pair <= m_numberOfSessionPairs; ++pair)
+    {   // the schema info the engine needs for combi corrections
+        m_vSchema[pair].rounds          = GetNumberOfRounds(pair);
+        m_vSchema[pair].bCombiCandidate = IsCombiCandidate (pair);
+    }
+
+    m_calc.SetSettings  ({m_bButler, m_bCrossImps, cfg::GetNeuberg(), m_numberOfSessionPairs});
+    m_scoreData = *score::GetScoreData();           // the scores can change while calculating
+    m_calc.SetScoreData (&m_scoreData);
+    m_calc.SetSchema    (m_vSchema);
+    return true;
+}   // PrepareInput()
+
+void CalcReports::ReadInput()
+{   // the input from the database, so it may run in a worker thread: the database access is serialized by io::
+    m_correctionsSession.clear();
+    (void)io::CorrectionsSessionRead(m_correctionsSession, m_session);
+    wxString errorMsg = m_calc.SetSessionCorrections(m_correctionsSession);
+    if ( errorMsg.Len() && !m_bScriptTesting )
+    {   // some bad data ignored, show them all at once
+        m_vMessages.push_back({_("Bad data or combi-table results for non-combi player(s) ignored") + errorMsg, _("Warning")});
+    }
+    m_inputHash = CalcInputHash();
+    if (m_inputHash == m_engineHash)
+    {   // the engine has the results of this input already
+        m_calculatedGames = 0;
+        m_bCalculated     = true;
+    }
+    else
+        m_bCalculated = m_bCacheStored = LoadCache();   // stored results of an unchanged session: nothing to calculate
+}   // ReadInput()
+
+bool CalcReports::CalcGames(std::stop_token a_stop, const CalcContext::Progress& a_progress)
+{   // no ui and no global data: may run in a worker thread
+    if (!m_bInputRead)
+    {
+        m_bInputRead = true;
+        ReadInput();
+    }
+    if (m_bCalculated) return true;     // the results of this input are known already
+    m_engineHash      = 0;              // until ready, the engine has results of mixed input
+    m_calculatedGames = m_calc.CalcSession(a_stop, a_progress);
+    if (a_stop.stop_requested()) return false;
+    m_bCalculated  = true;
+    m_bCacheStored = false;
+    m_engineHash   = m_inputHash;
+    return true;
+}   // CalcGames()
+
+void CalcReports::MakeReports()
+{   // only the results that are needed outside this page are saved here, the lists are created when asked for
+    names::InitializePairNames();       // get all nameinfo
+    MyLogDebug("MakeReports(): %u of %u games (re)calculated", m_calculatedGames, score::GetNumberOfGames(&m_scoreData));
+    m_maxPair = m_calc.GetMaxPair();
+    score::WriteSessionRank(m_calc.GetSessionRankToPair());
+    SaveSessionResultShort();
+    CalcTotal();
+    m_bReportMade.fill(false);
+    m_vGroupRankSession.clear();
+    m_vGroupRankFinal  .clear();
+    m_vFrqStringTable.clear();
+    m_vFrqStringTable.resize(score::GetNumberOfGames()+1ULL);
+    m_vFrqStringMade.assign(m_vFrqStringTable.size(), false);
+    m_bReportsValid = true;
+}   // MakeReports()
+
+void CalcReports::MakeReport(Report a_report)
+{
+    switch (a_report)
+    {
+        case ReportSession:
+        case ReportSessionName:
+            SaveSessionResults();       // both lists at once
+            m_bReportMade[ReportSession] = m_bReportMade[ReportSessionName] = true;
+            break;
+        case ReportTotal:       SaveTotalResult();      break;
+        case ReportFrqTable:    SaveFrequencyTable();   break;
+        case ReportGroup:       SaveGroupResult();      break;
+        case ReportClubSession: CalcClub(false);        break;
+        case ReportClubTotal:   if (m_bHaveTotal) CalcClub(true); break;
+        default:                                        break;
+    }
+}   // MakeReport()
+
+const MyTextFile& CalcReports::GetReport(Report a_report)
+{
+    if (m_bReportsValid && a_report < ReportMax && !m_bReportMade[a_report])
+    {   // not yet created for the current results
+        m_bReportMade[a_report] = true;
+        MakeReport(a_report);
+    }
+    return GetReportFile(a_report);
+}   // GetReport()
+
+MyTextFile& CalcReports::GetReportFile(Report a_report)
+{
+    switch (a_report)
+    {
+        case ReportSessionName: return m_txtFileResultOnName;
+        case ReportTotal:       return m_txtFileResultTotal;
+        case ReportFrqTable:    return m_txtFileFrqTable;
+        case ReportGroup:       return m_txtFileResultGroup;
+        case ReportClubSession: return m_txtFileResultClubSession;
+        case ReportClubTotal:   return m_txtFileResultClubTotal;
+        case ReportSession:
+        default:                return m_txtFileResultSession;
+    }
+}   // GetReportFile()
+
+const std::vector<wxString>& CalcReports::GetFrequencyTable(UINT a_game)
+{
+    if (m_bReportsValid && !m_vFrqStringMade[a_game])
+    {
+        m_vFrqStringMade[a_game] = true;
+        MakeFrequenceTable(a_game, m_vFrqStringTable[a_game]);
+    }
+    return m_vFrqStringTable[a_game];
+}   // GetFrequencyTable()
+
+std::vector<CalcReports::Message> CalcReports::TakeMessages()
+{
+    std::vector<Message> messages;
+    messages.swap(m_vMessages);
+    return messages;
+}   // TakeMessages()
+
+void CalcReports::Flush()
+{   // each list is written to disk when it is created, only the session results are left to store
+    SaveCache();
+}   // Flush()
+
+bool CalcReports::SaveReports(const wxString& a_folder)
+{   // write all lists of the last calculation to a_folder, using the same (file)names as in the matchfolder
+    bool bOk = wxFileName::Mkdir(a_folder, wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL);
+    for (int report = ReportSession; report < ReportMax; ++report)
+    {
+        const MyTextFile& source = GetReport(static_cast<Report>(report));
+        if (!source.IsOpened()) continue;   // list not (yet) created for this match/session
+        wxFileName target(source.GetName());
+        target.SetPath(a_folder);
+        bOk = source.WriteTo(target.GetFullPath()) && bOk;  // streamed, no copy of the list
+    }
+    SaveCache();
+    return bOk;
+}   // SaveReports()
+
+static constexpr auto CALC_CACHE_ID = "calc-cache-3";   // change it if the stored results or the hashed input change
+
+struct InputHash
+{   // FNV-1a, 64 bits
+    uint64_t value = 14695981039346656037ULL;
+
+    void Add(const void* a_pData, size_t a_size)
+    {
+        auto pByte = static_cast<const unsigned char*>(a_pData);
+        for (size_t index = 0; index < a_size; ++index)
+        {
+            value ^= pByte[index];
+            value *= 1099511628211ULL;
+        }
+    }
+    void Add(UINT a_value)              {Add(&a_value, sizeof(a_value));}
+    void Add(int  a_value)              {Add(&a_value, sizeof(a_value));}
+    void Add(bool a_value)              {Add(a_value ? 1U : 0U);}
+    void Add(const Fdp& a_value)        {Add(a_value.AsString3());}
+    void Add(const wxString& a_value)   {Add((UINT)a_value.length()); Add(a_value.wx_str(), a_value.length() * sizeof(wxChar));}
+};  // InputHash
+
+static wxString CacheHeader(uint64_t a_hash)
+{
+    return FMT("%s %016llx", CALC_CACHE_ID, static_cast<unsigned long long>(a_hash));
+}   // CacheHeader()
+
+uint64_t CalcReports::CalcInputHash() const
+{   // only the input of the engine: if this is unchanged, a calculation would give the same session results.
+    // The lists are made from these results with the names/settings of that moment and the total is always calculated.
+    InputHash hash;
+    const auto& settings = m_calc.GetSettings();
+    hash.Add(wxString(CALC_CACHE_ID));
+    hash.Add(m_session);
+    hash.Add(settings.bButler);
+    hash.Add(settings.bCrossImps);
+    hash.Add(settings.bNeuberg);
+    hash.Add(settings.sessionPairs);
+    for (const auto& pair : m_vSchema)
+    {
+        hash.Add(pair.rounds);
+        hash.Add(pair.bCombiCandidate);
+    }
+    for (const auto& game : m_scoreData)
+    {
+        hash.Add((UINT)game.size());
+        for (const auto& set : game)
+        {   // the contracts are not used by the engine
+            hash.Add(set.pairNS);
+            hash.Add(set.pairEW);
+            hash.Add(set.scoreNS);
+            hash.Add(set.scoreEW);
+        }
+    }
+    for (const auto& [pair, correction] : m_correctionsSession)
+    {
+        hash.Add(pair);
+        hash.Add(correction.type);
+        hash.Add(correction.correction);
+        hash.Add(correction.extra);
+        hash.Add(correction.maxExtra);
+        hash.Add(correction.games);
+    }
+    return hash.value;
+}   // CalcInputHash()
+
+void CalcReports::SaveCache()
+{   // store the session results of the engine, so an unchanged session is not calculated again when revisited
+    if (!m_bReportsValid || m_bCacheStored) return;
+    m_bCacheStored = true;
+    std::string state = m_calc.GetSessionState();
+    (void)io::CalcCacheWrite(CacheHeader(m_inputHash) + '\n' + wxBase64Encode(state.data(), state.size()), m_session);
+}   // SaveCache()
+
+bool CalcReports::LoadCache()
+{   // returns false if there are no stored results for this input, then a calculation is needed
+    wxString cache;
+    wxString header = CacheHeader(m_inputHash) + '\n';
+    if (!io::CalcCacheRead(cache, m_session) || !cache.StartsWith(header)) return false;  // none, or made from other input
+
+    wxMemoryBuffer state = wxBase64Decode(cache.Mid(header.length()));
+    if (state.IsEmpty() || !m_calc.SetSessionState(std::string(static_cast<const char*>(state.GetData()), state.GetDataLen())))
+    {
+        MyLogError(_("Stored results of session %u are damaged, they are calculated again"), m_session);
+        m_engineHash = 0;       // the engine starts from scratch
+        return false;
+    }
+    m_calculatedGames = 0;
+    m_engineHash      = m_inputHash;
+    MyLogDebug("Prepare(): stored results of session %u are used", m_session);
+    return true;
+}   // LoadCache()
+
+static wxString DottedName(const wxString& a_name)
+{   // return string with size MAX_NAME_SIZE and a_name padded with " ."
+    char dots[]=" . . . . . . . . . . . . . . . . . . . . . . . . .";
+    size_t nLen = a_name.Len(); if (nLen >= cfg::MAX_NAME_SIZE) return a_name;
+    size_t dLen = sizeof(dots);
+    size_t neededChars = cfg::MAX_NAME_SIZE - nLen;
+    wxString dottedName = a_name+&dots[dLen-neededChars-1];
+    if (dottedName[nLen] == '.') dottedName[nLen] = ' ';
+    return dottedName;
+}   // DottedName()
+
+void CalcReports::SaveGroupResult()
+{
+    const auto& sessionResult     = m_calc.GetSessionResult();
+    UINT session            = cfg::GetActiveSession();
+    UINT setSize            = cfg::GetSetSize();
+    UINT sets               = cfg::GetNrOfGames()/setSize;
+    UINT offsetFirstGame    = cfg::GetFirstGame() - 1;
+
+    m_txtFileResultGroup.MyCreate(cfg::ConstructFilename(cfg::EXT_RESULT_GROUP), MyTextFile::WRITE);
+    m_txtFileResultGroup.AddLine(ES);
+
+    wxString tmp;
+    if (session) tmp.Printf(_(", session %u"), session);
+    tmp = FMT(_("Group-result of match '%s'%s"), cfg::GetDescription(),  tmp);
+    m_txtFileResultGroup.AddLine(tmp);
+    m_txtFileResultGroup.AddLine(ES);
+
+    const size_t SIZE_GRP_PAIR       (4);
+    const size_t SIZE_GRP_NAME       (cfg::MAX_NAME_SIZE);
+    const size_t SIZE_GRP_SCORE      (5);
+    const size_t SIZE_GRP_COMBI      (6);
+    const size_t SIZE_GRP_CORRECTION (6);
+    const size_t SIZE_GRP_GAMES      (7);
+    const size_t SIZE_GRP_TOTAL      (6);
+
+    #define GRP_INSERT_POS ((size_t)2)   /*start index to insert set-info*/
+    std::vector<FormBuilder::ColumnInfoRow> formInfo =
+        {
+              {SIZE_GRP_PAIR         , FormBuilder::Align::RIGHT       , ES, true}
+            , {SIZE_GRP_NAME         , FormBuilder::Align::LEFT        , ES, true}
+                // setinfo added later
+            , {SIZE_GRP_COMBI        , FormBuilder::Align::CENTER      , ES, m_calc.HaveValidCombi()}
+            , {SIZE_GRP_CORRECTION   , FormBuilder::Align::RIGHT_SPACE1, ES, m_calc.HaveValidNormal()}
+            , {SIZE_GRP_GAMES        , FormBuilder::Align::RIGHT_SPACE2, ES, true}
+            , {SIZE_GRP_TOTAL        , FormBuilder::Align::RIGHT       , ES, true}
+            , {SIZE_GRP_SCORE        , FormBuilder::Align::RIGHT       , ES, true}
+        };
+    FormBuilder::Align alignScore = m_bButler ? FormBuilder::Align::RIGHT : FormBuilder::Align::RIGHT_SPACE2;
+    std::vector<FormBuilder::ColumnInfoHeader> headerInfo =
+    {   // as it says: info for the header, columnsize is taken from the form-info
+          {FormBuilder::Align::RIGHT  , ES, ES          }
+        , {FormBuilder::Align::RIGHT  , ES, _("games") + " :"}
+            // setinfo added later
+        , {FormBuilder::Align::RIGHT  , ES, _("combi"  )}
+        , {FormBuilder::Align::RIGHT  , ES, _("corr."  )}
+        , {FormBuilder::Align::CENTER , ES, _("games"  )}
+        , {alignScore                 , ES, _("tot"    )}
+        , {FormBuilder::Align::LEFT   , ES, _("score"  )}
+    };
+
+    for (UINT ii = 0; ii < sets; ++ii)
+    {   // add set-info for form and header
+        wxString tmp2 = FMT("%u-%u", offsetFirstGame + setSize * ii + 1, offsetFirstGame + setSize * ii + setSize);
+        headerInfo.emplace(headerInfo.begin() + GRP_INSERT_POS + ii, FormBuilder::Align::CENTER, ES, tmp2);
+        formInfo  .emplace(formInfo  .begin() + GRP_INSERT_POS + ii, SIZE_GRP_SCORE, FormBuilder::Align::RIGHT, ES, true);
+////        headerInfo.insert(headerInfo.begin() + GRP_INSERT_POS + ii, {FormBuilder::Align::CENTER, ES, tmp2});
+////        formInfo  .insert(formInfo  .begin() + GRP_INSERT_POS + ii, {SIZE_GRP_SCORE, FormBuilder::Align::RIGHT, ES, true});
+    }
+
+    FormBuilder group(formInfo);
+    wxString tmp2 = group.CreateHeader(headerInfo);
+    tmp2 += " " + (m_bButler ? _("(imps/game)") : wxString("(%)"));
+    m_txtFileResultGroup.AddLine(tmp2);
+    for (UINT pair=1; pair <= m_maxPair; ++pair)
+    {
+        if (sessionResult[pair].nrOfGames == 0)
+        {
+            if (cfg::IsSessionPairAbsent(pair))
+                tmp.Printf("%*s --> %s", (int)SIZE_GRP_PAIR, names::PairnrSession2SessionText(pair,true),  _("absent"));
+            else
+                tmp.Printf("%*s %s --> %s", (int)SIZE_GRP_PAIR, names::PairnrSession2SessionText(pair), names::PairnrSession2GlobalText(pair), _("NOT PLAYED"));  // ???? not possible if session ready!
+            m_txtFileResultGroup.AddLine(tmp);
+            continue;                   // pair didn't play
+        }
+        std::vector<wxString> rowInfo = {names::PairnrSession2SessionText(pair), DottedName(names::PairnrSession2GlobalText(pair))};
+
+        for (UINT ii = 0; ii < sets; ++ii)
+        {
+            UINT gamesPlayed = 0;
+            Fdp points = m_calc.GetSetResult(pair, offsetFirstGame + setSize * ii + 1, setSize, &gamesPlayed);
+            if (gamesPlayed)    // if at least played once in this set, show score
+                rowInfo.push_back( points.AsString1E() );
+            else
+                rowInfo.emplace_back("-----");
+        }
+
+        wxString combi;
+        wxString correction;
+        GetSessionCorrectionStrings(pair, combi, correction);
+        rowInfo.push_back(combi);
+        rowInfo.push_back(correction);
+        rowInfo.push_back(U2String(sessionResult[pair].nrOfGames));
+        if (m_bButler)
+            rowInfo.push_back(m_bCrossImps ? sessionResult[pair].butlerMp.AsString1() : sessionResult[pair].butlerMp.AsString());
+        else
+            rowInfo.push_back(sessionResult[pair].points.AsString1E());
+        rowInfo.push_back(sessionResult[pair].procentScore.AsString2F());
+        m_txtFileResultGroup.AddLine(group.CreateRow(rowInfo));
+    }
+
+    m_txtFileResultGroup.Flush();
+}   // SaveGroupResult()
+
+void CalcReports::SaveSessionResultsProcent()
+{
+    const auto& sessionResult     = m_calc.GetSessionResult();
+    const auto& sessionRankToPair = m_calc.GetSessionRankToPair();
+    const auto& sessionPairToRank = m_calc.GetSessionPairToRank();
+    const size_t SIZE_RP_RANK        (4);
+    const size_t SIZE_RP_PAIR        (4);
+    const size_t SIZE_RP_NAME        (cfg::MAX_NAME_SIZE);
+    const size_t SIZE_RP_TOTAL       (6);
+    const size_t SIZE_RP_MAX         (5);
+    const size_t SIZE_RP_SCORE       (6);
+    const size_t SIZE_RP_COMBI       (6);
+    const size_t SIZE_RP_CORRECTION  (6);
+    const size_t SIZE_RP_GROUPRESULT (FormBuilder::NO_LIMIT);
+
+    std::vector<FormBuilder::ColumnInfoRow> formInfo =
+    {
+          {SIZE_RP_RANK       , FormBuilder::Align::RIGHT       , ES , true}
+        , {SIZE_RP_PAIR       , FormBuilder::Align::RIGHT       , ES , true}
+        , {SIZE_RP_NAME       , FormBuilder::Align::LEFT        , ES , true}
+        , {SIZE_RP_TOTAL      , FormBuilder::Align::RIGHT       , ES , true}
+        , {SIZE_RP_MAX        , FormBuilder::Align::RIGHT       , ES , true}
+        , {SIZE_RP_SCORE      , FormBuilder::Align::RIGHT       , '%', true}
+        , {SIZE_RP_COMBI      , FormBuilder::Align::CENTER      , ES , m_calc.HaveValidCombi()}
+        , {SIZE_RP_CORRECTION , FormBuilder::Align::RIGHT_SPACE1, ES , m_calc.HaveValidNormal()}
+        , {SIZE_RP_GROUPRESULT, FormBuilder::Align::LEFT        , ES , true}
+    };
+
+    std::vector<FormBuilder::ColumnInfoHeader> headerInfo =
+    {
+          {FormBuilder::Align::RIGHT , ES , _("rank"    )}
+        , {FormBuilder::Align::RIGHT , ES , _("pair"    )}
+        , {FormBuilder::Align::LEFT  , ES , _("pairname")}
+        , {FormBuilder::Align::CENTER, ES , _("tot."    )}
+        , {FormBuilder::Align::RIGHT , ES , _("max"     )}
+        , {FormBuilder::Align::RIGHT , ' ', _("score"   )}
+        , {FormBuilder::Align::RIGHT , ES , _("combi"   )}
+        , {FormBuilder::Align::RIGHT , ES , _("corr."   )}
+        , {FormBuilder::Align::LEFT  , ES , GetGroupResultString(0, &sessionRankToPair, GROUPRESULT_SESSION)}
+    };
+
+    FormBuilder percentResult(formInfo);
+    wxString tmp = percentResult.CreateHeader(headerInfo);
+
+    m_txtFileResultSession.AddLine(tmp);m_txtFileResultOnName.AddLine(tmp);
+    auto startLine = (UINT)m_txtFileResultSession.GetLineCount();    //from here the pairinfo is addded
+    // pre-create empty lines for result on name-order
+    for (UINT lc = 1; lc <= m_maxPair;++lc) m_txtFileResultOnName.AddLine(ES);
+
+    std::vector<wxString> rowInfo(formInfo.size()); // reused for all rows: the strings keep their buffers
+    for (UINT rank=1; rank < sessionRankToPair.size(); ++rank)
+    {
+        UINT pair   = sessionRankToPair[rank];
+        Fdp  score  = sessionResult[pair].procentScore;
+        if (sessionResult[pair].maxScore == 0)
+            continue;                   // pair didn't play
+
+        U2String(sessionPairToRank[pair], rowInfo[0]);
+        rowInfo[1] = names::PairnrSession2SessionText(pair);
+        rowInfo[2] = DottedName(names::PairnrSession2GlobalText(pair));
+        sessionResult[pair].points.AsString1E(rowInfo[3]);
+        U2String(sessionResult[pair].maxScore, rowInfo[4]);
+        score.AsString2F(rowInfo[5]);
+        GetSessionCorrectionStrings(pair, rowInfo[6], rowInfo[7]);  // combi, correction
+        rowInfo[8] = GetGroupResultString(pair, nullptr, GROUPRESULT_SESSION);
+        percentResult.CreateRow(rowInfo, tmp);
+        m_txtFileResultSession.AddLine(tmp);                       // rank order
+        m_txtFileResultOnName[0 - 1ULL + pair + startLine] = tmp;  // pair order
+    }
+}   // SaveSessionResultsProcent()
+
+void CalcReports::SaveSessionResultsButler()
+{
+    const auto& sessionResult     = m_calc.GetSessionResult();
+    const auto& sessionRankToPair = m_calc.GetSessionRankToPair();
+    const auto& sessionPairToRank = m_calc.GetSessionPairToRank();
+    const size_t SIZE_RI_RANK        (4);
+    const size_t SIZE_RI_PAIR        (4);
+    const size_t SIZE_RI_NAME        (cfg::MAX_NAME_SIZE);
+    const size_t SIZE_RI_IMPS        (m_bCrossImps ? 6 : 4);   // cross-imps: 1 decimal
+    const size_t SIZE_RI_GAMES       (7);
+    const size_t SIZE_RI_SCORE       (6);
+    const size_t SIZE_RI_COMBI       (6);
+    const size_t SIZE_RI_CORRECTION  (6);
+    const size_t SIZE_RI_GROUPRESULT (FormBuilder::NO_LIMIT);
+
+    std::vector<FormBuilder::ColumnInfoRow> formInfo =
+    {   // column-size definition and info for all lines (except header)
+          {SIZE_RI_RANK       , FormBuilder::Align::RIGHT       , ES , true}
+        , {SIZE_RI_PAIR       , FormBuilder::Align::RIGHT       , ES , true}
+        , {SIZE_RI_NAME       , FormBuilder::Align::LEFT        , ES , true}
+        , {SIZE_RI_IMPS       , FormBuilder::Align::RIGHT       , ES , true}
+        , {SIZE_RI_GAMES      , FormBuilder::Align::RIGHT_SPACE2, ES , true}
+        , {SIZE_RI_SCORE      , FormBuilder::Align::RIGHT       , ES , true}
+        , {SIZE_RI_COMBI      , FormBuilder::Align::CENTER      , ES , m_calc.HaveValidCombi()}
+        , {SIZE_RI_CORRECTION , FormBuilder::Align::RIGHT_SPACE1, ES , m_calc.HaveValidNormal()}
+        , {SIZE_RI_GROUPRESULT, FormBuilder::Align::LEFT        , ES , true}
+    };
+
+    std::vector<FormBuilder::ColumnInfoHeader> headerInfo =
+    {   // as it says: info for the header, size is taken from the form-info
+          {FormBuilder::Align::RIGHT , ES , _("rank"    )}
+        , {FormBuilder::Align::RIGHT , ES , _("pair"    )}
+        , {FormBuilder::Align::LEFT  , ES , _("pairname")}
+        , {FormBuilder::Align::CENTER, ES , _("imps"    )}
+        , {FormBuilder::Align::RIGHT , ES , _("games"   )}
+        , {FormBuilder::Align::RIGHT , ES , _("score"   )}
+        , {FormBuilder::Align::RIGHT , ES , _("combi"   )}
+        , {FormBuilder::Align::RIGHT , ES , _("corr."   )}
+        , {FormBuilder::Align::LEFT  , ES , GetGroupResultString(0, &sessionRankToPair, GROUPRESULT_SESSION)}
+    };
+
+    FormBuilder impsResult(formInfo);
+    wxString tmp = impsResult.CreateHeader(headerInfo);
+
+    m_txtFileResultSession.AddLine(tmp);m_txtFileResultOnName.AddLine(tmp);
+    auto startLine = m_txtFileResultSession.GetLineCount();    //from here the pairinfo is addded
+    // pre-create empty lines for result on name-order
+    for (UINT lc = 1; lc <= m_maxPair;++lc) m_txtFileResultOnName.AddLine(ES);
+
+    std::vector<wxString> rowInfo(formInfo.size()); // reused for all rows: the strings keep their buffers
+    for (UINT rank=1; rank < sessionRankToPair.size(); ++rank)
+    {
+        UINT pair   = sessionRankToPair[rank];
+        Fdp  score  = sessionResult[pair].mpPerGame;
+        if (sessionResult[pair].nrOfGames == 0)
+            continue;                   // pair didn't play
+
+        U2String(sessionPairToRank[pair], rowInfo[0]);
+        rowInfo[1] = names::PairnrSession2SessionText(pair);
+        rowInfo[2] = DottedName(names::PairnrSession2GlobalText(pair));
+        if (m_bCrossImps)
+            sessionResult[pair].butlerMp.AsString1(rowInfo[3]);
+        else
+            sessionResult[pair].butlerMp.AsString (rowInfo[3]);
+        U2String(sessionResult[pair].nrOfGames, rowInfo[4]);
+        score.AsString2F(rowInfo[5]);
+        GetSessionCorrectionStrings(pair, rowInfo[6], rowInfo[7]);  // combi, correction
+        rowInfo[8] = GetGroupResultString(pair, nullptr, GROUPRESULT_SESSION);
+        impsResult.CreateRow(rowInfo, tmp);
+
+        m_txtFileResultSession.AddLine(tmp);                       // rank order
+        m_txtFileResultOnName[0 - 1ULL + pair + startLine] = tmp;  // pair order
+    }
+}   // SaveSessionResultsButler()
+
+void CalcReports::SaveSessionResults()
+{
+    m_txtFileResultSession.MyCreate(cfg::ConstructFilename(cfg::EXT_RESULT_SESSION_RANK), MyTextFile::WRITE);
+    m_txtFileResultOnName .MyCreate(cfg::ConstructFilename(cfg::EXT_RESULT_SESSION_NAME), MyTextFile::WRITE);
+    AddHeader(m_txtFileResultSession);
+    AddHeader(m_txtFileResultOnName);
+    m_txtFileResultSession.AddLine(ES); m_txtFileResultOnName.AddLine(ES);
+
+    if (m_bButler)
+        SaveSessionResultsButler();
+    else
+        SaveSessionResultsProcent();
+
+    m_txtFileResultSession.Flush();        // write to disk
+    m_txtFileResultOnName.Flush();
+}   // SaveSessionResults()
+
+void CalcReports::MakeFrequenceTable(UINT a_game, std::vector<wxString>& a_stringTable) const
+{
+    a_stringTable.clear();
+    wxString tmp;
+    tmp.Printf("%s %u", _("game"), a_game + cfg::GetFirstGame() - 1);
+    a_stringTable.push_back(tmp);
+    if (m_bCrossImps)
+    {
+        a_stringTable.push_back(_("cross-imps"));
+        // form definitions
+        const size_t SIZE_FT_SCORE  (5);
+        const size_t SIZE_FT_IMPS   (7);
+
+        std::vector<FormBuilder::ColumnInfoRow> formInfo =
+        {   // column-size definition and info for all rows
+              {SIZE_FT_SCORE, FormBuilder::Align::RIGHT, ES , true}
+            , {SIZE_FT_IMPS , FormBuilder::Align::RIGHT, ' ', true}
+            , {SIZE_FT_SCORE, FormBuilder::Align::RIGHT, ES , true}
+            , {SIZE_FT_IMPS , FormBuilder::Align::RIGHT, ES , true}
+        };
+
+        std::vector<FormBuilder::ColumnInfoHeader> headerInfo =
+        {   // as it says: info for the header, columnsize is taken from the form-info
+              {FormBuilder::Align::RIGHT, ES , _("NS"   )}
+            , {FormBuilder::Align::RIGHT, ' ', _("imps" )}
+            , {FormBuilder::Align::RIGHT, ES , _("EW"   )}
+            , {FormBuilder::Align::RIGHT, ES , _("imps" )}
+        };
+
+        FormBuilder frequencyTable(formInfo);
+        a_stringTable.push_back(frequencyTable.CreateHeader(headerInfo));
+        std::vector<score::GameSetData> sets;
+        for (const auto& it : m_calc.GetScoreData()[a_game])
+        {
+            if (it.pairNS <= m_numberOfSessionPairs && it.pairEW <= m_numberOfSessionPairs)
+                sets.push_back(it);
+        }
+        std::ranges::stable_sort(sets, std::greater<>(), &score::GameSetData::scoreNS);
+        for (auto it = sets.begin(); it != sets.end(); ++it)
+        {   //scores high to low overview, each NS score only once
+            if (it != sets.begin() && (it-1)->scoreNS == it->scoreNS) continue;
+            std::vector<wxString> rowInfo = {     score::ScoreToString(it->scoreNS)
+                                                , m_calc.GetGameResult(a_game, true , it->scoreNS).AsString2F()
+                                                , score::ScoreToString(it->scoreEW)
+                                                , m_calc.GetGameResult(a_game, false, it->scoreEW).AsString2F()
+                                            };
+            a_stringTable.push_back(frequencyTable.CreateRow(rowInfo));
+        }
+    }
+    else if (m_bButler)
+    {
+        a_stringTable.push_back(FMT("%s %s: %i, %s: %i", _("datumscore"), _("NS"), m_calc.GetDatumScore(a_game).dsNS, _("EW"), m_calc.GetDatumScore(a_game).dsEW));
+        // form definitions
+        const size_t SIZE_FT_SCORE  (5);
+        const size_t SIZE_FT_DELTA  (5);
+        const size_t SIZE_FT_IMPS   (4);
+
+        std::vector<FormBuilder::ColumnInfoRow> formInfo =
+        {   // column-size definition and info for all rows
+              {SIZE_FT_SCORE, FormBuilder::Align::RIGHT, ES , true}
+            , {SIZE_FT_DELTA, FormBuilder::Align::RIGHT, ES , true}
+            , {SIZE_FT_IMPS , FormBuilder::Align::RIGHT, ' ', true}
+            , {SIZE_FT_SCORE, FormBuilder::Align::RIGHT, ES , true}
+            , {SIZE_FT_DELTA, FormBuilder::Align::RIGHT, ES , true}
+            , {SIZE_FT_IMPS , FormBuilder::Align::RIGHT, ES , true}
+        };
+
+        std::vector<FormBuilder::ColumnInfoHeader> headerInfo =
+        {   // as it says: info for the header, columnsize is taken from the form-info
+              {FormBuilder::Align::RIGHT, ES , _("NS"   )}
+            , {FormBuilder::Align::RIGHT, ES , _("delta")}
+            , {FormBuilder::Align::RIGHT, ' ', _("imps" )}
+            , {FormBuilder::Align::RIGHT, ES , _("EW"   )}
+            , {FormBuilder::Align::RIGHT, ES , _("delta")}
+            , {FormBuilder::Align::RIGHT, ES , _("imps" )}
+        };
+
+        FormBuilder frequencyTable(formInfo);
+        tmp = frequencyTable.CreateHeader(headerInfo);
+        a_stringTable.push_back(tmp);
+        for (auto it = m_calc.GetButlerFkw(a_game).rbegin(); it != m_calc.GetButlerFkw(a_game).rend(); ++it)
+        {   //scores high to low overview
+            std::vector<wxString> rowInfo = {     score::ScoreToString(it->scoreNs)
+                                                , L2String(it->deltaNs)
+                                                , I2String(it->impsNs)
+                                                , score::ScoreToString(it->scoreEw)
+                                                , L2String(it->deltaEw)
+                                                , I2String(it->impsEw)
+                                            };
+            a_stringTable.push_back(frequencyTable.CreateRow(rowInfo));
+        }
+    }
+    else
+    {
+        // form definitions
+        const size_t SIZE_FT_SCORE  (7);
+        const size_t SIZE_FT_MP     (5);
+
+        std::vector<FormBuilder::ColumnInfoRow> formInfo =
+        {   // column-size definition and info for all rows
+              {SIZE_FT_SCORE, FormBuilder::Align::RIGHT, ES, true}
+            , {SIZE_FT_MP   , FormBuilder::Align::RIGHT, ES, true}
+            , {SIZE_FT_MP   , FormBuilder::Align::RIGHT, ES, true}
+        };
+
+        std::vector<FormBuilder::ColumnInfoHeader> headerInfo =
+        {   // as it says: info for the header, columnsize is taken from the form-info
+              {FormBuilder::Align::RIGHT , ES, _("scoreNS")}
+            , {FormBuilder::Align::CENTER, ES, _("NS"     )}
+            , {FormBuilder::Align::CENTER, ES, _("EW"     )}
+        };
+
+        FormBuilder frequencyTable(formInfo);
+        a_stringTable.push_back(frequencyTable.CreateHeader(headerInfo));
+        std::vector<wxString> rowInfo = { _("top:"), U2String(m_calc.GetGameTops(a_game).topNS)+"  ", U2String(m_calc.GetGameTops(a_game).topEW)+"  "};
+        a_stringTable.push_back(frequencyTable.CreateRow(rowInfo));
+
+        const auto& frqInfo = m_calc.GetFrequencyInfo(a_game);
+        for (const auto& it : frqInfo)
+        {
+            rowInfo = {score::ScoreToString(it.score), it.points.AsString1E(), it.pointsEW.AsString1E()};
+            a_stringTable.push_back(frequencyTable.CreateRow(rowInfo));
+        }
+    }
+}   // MakeFrequenceTable()
+
+void CalcReports::SaveFrequencyTable()
+{
+    UINT maxGame = score::GetNumberOfGames();
+    std::vector<size_t> tableSize;  // the size of each frq table
+    tableSize.resize(maxGame+1ULL);
+
+    for (UINT game = 1; game <= maxGame; ++game)
+    {   // fkw per game, tables already shown are not created again
+        tableSize[game] = GetFrequencyTable(game).size();
+    }
+
+    m_txtFileFrqTable.MyCreate(cfg::ConstructFilename(cfg::EXT_FKW), MyTextFile::WRITE);
+    AddHeader(m_txtFileFrqTable);
+    size_t linesOnPage          = m_txtFileFrqTable.GetLineCount();
+    const UINT suFrqStringSize  = m_bButler ? 40 : 19;  // size of each line in a frq table
+    const UINT suNrOfFrqColumns = m_bButler ?  2 :  4;  // number of frq tables next to eachother
+
+    // now add all tables in 'suNrOfFrqColumns' columns
+    for (UINT game = 1; game <= maxGame; game += suNrOfFrqColumns)
+    {
+        size_t maxLines = 0;
+        for (UINT ii = 0; ii < suNrOfFrqColumns && game + ii <= maxGame; ++ii)
+        {
+            maxLines = std::max(maxLines,tableSize[static_cast<size_t>(game)+ii]);
+        }
+
+        if (linesOnPage + 2ULL + maxLines > cfg::GetLinesPerPage())
+        {   // doesn't fit on current page, so give a formfeed ('\f')
+            m_txtFileFrqTable.AddLine('\f');
+            linesOnPage = 0;
+        }
+        linesOnPage += 2ULL + maxLines;
+        m_txtFileFrqTable.AddLine(ES); m_txtFileFrqTable.AddLine(ES);
+        for (size_t line = 0; line < maxLines; ++line)
+        {
+            wxString tmp;
+            for (UINT ii = 0; ii < suNrOfFrqColumns && game + ii <= maxGame; ++ii)
+            {
+//                tmp += line < tableSize[0ULL+game+ii] ? m_vFrqStringTable[0ULL+game+ii][line] : wxString('.',suFrqStringSize);
+                tmp += FMT("%-*s", suFrqStringSize,  (line < tableSize[0ULL+game+ii]) ? m_vFrqStringTable[0ULL + game + ii][line] : ES);
+            }
+            m_txtFileFrqTable.AddLine(tmp);
+        }
+
+    }
+    m_txtFileFrqTable.Flush();
+}   // SaveFrequencyTable()
+
+static void AddHeader(MyTextFile& a_file)
+{
+    a_file.AddLine('\'' + cfg::GetDescription() + '\'');
+
+    wxString tmp;
+    if (cfg::GetActiveSession() >= 1)
+        tmp.Printf(_("result of session %u"), cfg::GetActiveSession());
+    else
+        tmp = _("result");
+    a_file.AddLine(tmp);
+}   // AddHeader()
+
+void CalcReports::SaveSessionResultShort()
+{
+    const auto& sessionResult     = m_calc.GetSessionResult();
+    if (cfg::GetActiveSession()==0)
+        return;         // 0 ==> stand-alone session: this data would only be used in next session!
+
+    cor::mCorrectionsEnd mce;    // transform data to write into same format as its being read
+    for (UINT pair = 1; pair < sessionResult.size(); ++pair)          // save score of all pairs
+    {
+        if (sessionResult[pair].nrOfGames != 0)                       // check if pair has played
+        {   // pair has played
+            auto globalPair = names::PairnrSession2GlobalPairnr(pair);
+            if (globalPair == 0)
+            {   // can't store this result (for possible use in next session), because we do not know to whom it belongs...
+                // remark: no scoring-data lost!
+                wxString infoMsg = wxString::Format(_("Pair '%s' has played, but was NOT assigned to a global name"), names::PairnrSession2SessionText(pair));
+                MyLogError("%s", infoMsg);  // log as error!
+                m_vMessages.push_back({infoMsg, _("Warning")});
+                continue;
+            }
+            cor::CORRECTION_END ce;
+            ce.score = sessionResult[pair].procentScore;
+            ce.games = sessionResult[pair].nrOfGames;
+            mce[globalPair] = ce;           // need global pairnr!
+        }
+    }
+
+    io::SessionResultWrite(mce, cfg::GetActiveSession());
+}   // SaveSessionResultShort()
+
+Fdp CalcReports::GetResultScore(UINT a_sessionPairnr, bool a_bSession) const
+{   // just for use in GetGroupResultString() to find equal scores (and so ranks)
+    if (a_bSession) return m_calc.GetSessionResult()[a_sessionPairnr].procentScore;
+    return m_calc.GetTotalResult()[names::PairnrSession2GlobalPairnr(a_sessionPairnr)].totalN;
+}   // GetResultScore()
+
+wxString CalcReports::GetGroupResultString(UINT a_sessionPair, const std::vector<UINT>* a_pRankIndex, bool a_bSession)
+{
+    // on init: 3 chars per group, empty if only one group:  " BL YE RE GR" for group BLue YEllow REd and GReen
+    // for a pair: the rank in its group, a '.' if none   :  "  .  .  7  ." for pair being rank 7 in group 'RE'
+    const auto& groupInfo  = *cfg::GetGroupData();
+
+    if ( groupInfo.size() <= 1 || !cfg::GetGroupResult() ) return ES;   // if only 1 group, or cfg says no grp-info, then ES
+
+    wxString result;
+    auto& groupRank = a_bSession ? m_vGroupRankSession : m_vGroupRankFinal;
+    if (a_pRankIndex != nullptr)
+    {   // init of data: get string of all group characters and the group ranks, once per calculation
+        if (groupRank.empty())
+            CalcGroupRanks(*a_pRankIndex, a_bSession, groupRank);
+        // also init the group-string
+        for (const auto& it : groupInfo) {result += FMT("%3s", it.groupChars);}
+        return result;  // " BL GR YE OR" : 3 chars per group
+    }
+
+    // create string showing rank within group:  "  .  .  5  .  ." --> 3 chars per group: rank or "  ."
+    for (const auto& itGroup : groupInfo)
+    {
+        auto minPair = itGroup.groupOffset;
+        auto maxPair = minPair + itGroup.pairs;
+        result += ( (a_sessionPair > minPair) && (a_sessionPair <= maxPair) ) ?
+            FMT("%3u", groupRank[a_sessionPair]) : wxString("  .");
+    }
+
+    return result;
+}   // GetGroupResultString()
+
+void CalcReports::CalcGroupRanks(const std::vector<UINT>& a_rankIndex, bool a_bSession, std::vector<UINT>& a_groupRank) const
+{   // one pass over the ranked pairs: each group counts its own pairs, equal scores get an equal rank
+    const auto& groupInfo = *cfg::GetGroupData();
+    std::vector<UINT> pairToGroup;      // [sessionPair] -> 1 + index in groupInfo, 0 if not in a group
+    for (size_t group = 0; group < groupInfo.size(); ++group)
+    {
+        UINT minPair = groupInfo[group].groupOffset;
+        UINT maxPair = minPair + groupInfo[group].pairs;
+        if (pairToGroup.size() <= maxPair) pairToGroup.resize(maxPair+1ULL, 0);
+        for (UINT pair = minPair+1; pair <= maxPair; ++pair)    // so these are session-pairnumbers!
+            pairToGroup[pair] = static_cast<UINT>(group+1);
+    }
+    a_groupRank.assign(pairToGroup.size(), 0);
+
+    std::vector<UINT> rank    (groupInfo.size()+1ULL, 1);   // per group: rank of its next pair
+    std::vector<UINT> runRank (groupInfo.size()+1ULL, 1);   // per group: rank of its pairs in the current run of equal scores
+    std::vector<UINT> runOfRank(groupInfo.size()+1ULL, 0);  // per group: the run that runRank belongs to
+    UINT run            = 0;
+    Fdp  previousScore  = -1;
+    for (auto rankPair : a_rankIndex)
+    {
+        Fdp score = GetResultScore(rankPair, a_bSession);
+        if (score != previousScore) ++run;          // check for equal scores-->equal rank
+        previousScore = score;
+        UINT group = rankPair < pairToGroup.size() ? pairToGroup[rankPair] : 0;
+        if (group == 0) continue;                   // not a session pair
+        if (runOfRank[group] != run)
+        {   // first pair of this group in the current run of equal scores
+            runOfRank[group] = run;
+            runRank  [group] = rank[group];
+        }
+        if (a_groupRank[rankPair] == 0)
+            a_groupRank[rankPair] = runRank[group];  // rank within group
+        ++rank[group];      // next pair of this group has a lower ranking
+    }
+}   // CalcGroupRanks()
+
+UINT CalcReports::ReadSessionResult(cor::mCorrectionsEnd& a_result, UINT a_session, UINT a_globalPairs) const
+{   // result of a session for all global pairs, including end-corrections. Returns the max number of games played
+    a_result.clear();
+    cor::CORRECTION_END ce; // preset pairnr's
+    for (UINT pair = 0; pair <= a_globalPairs; ++pair) a_result[pair] = ce;
+    (void)io::SessionResultRead(a_result, a_session);
+    UINT games = 0;
+    for ( auto const& it : a_result )
+    {   // determine max number of games played in this session, needed for average calculation
+        if ( games < it.second.games )
+            games = it.second.games;
+    }
+    (void)io::CorrectionsEndRead(a_result, a_session, false);   // append end-corrections
+    return games;
+}   // ReadSessionResult()
+
+static bool IsCompleteTotal(const cor::mCumulativeTotals& a_totals, UINT a_globalPairs)
+{   // true, if there are running totals for exactly the global pairs 1..a_globalPairs
+    return a_totals.size() == a_globalPairs && a_totals.begin()->first == 1 && a_totals.rbegin()->first == a_globalPairs;
+}   // IsCompleteTotal()
+
+void CalcReports::CalcTotal()
+{   // the total result itself is always needed: its rankorder is used for the pair-assignments in the next session
+    m_bHaveTotal = false;
+    UINT maxSession = cfg::GetActiveSession();
+    if (maxSession == 0) return;       // no total result: session result == end result
+
+    UINT globalPairs = names::GetNumberOfGlobalPairs();
+    if (globalPairs == 0)
+    {
+        if (!cfg::IsScriptTesting())
+            m_vMessages.push_back({_("No names entered yet!"), ES});
+        return;  // no names yet
+    }
+    // running totals: start with the stored totals of the last session that still has valid ones
+    // and only read/add the sessions after it. Totals of a session are removed when its data changes.
+    cor::mCumulativeTotals totals;
+    UINT validSession = maxSession;
+    for (; validSession > 0; --validSession)
+    {
+        (void)io::SessionTotalsRead(totals, validSession);
+        if (IsCompleteTotal(totals, globalPairs)) break;
+    }
+    if (validSession == 0) totals.clear();
+    for (UINT session = validSession+1; session <= maxSession; ++session)
+    {
+        cor::mCorrectionsEnd correctionsEnd;
+        GetValidatedEndCorrections4Session(correctionsEnd, session);    // only to report invalid end-corrections
+        cor::mCorrectionsEnd sessionResult;
+        UINT games = ReadSessionResult(sessionResult, session, globalPairs);
+        for (UINT pair = 1; pair <= globalPairs; ++pair)
+            CalcContext::AddSessionToTotal(totals[pair], sessionResult[pair], games);
+        (void)io::SessionTotalsWrite(totals, session);
+    }
+
+    CalcContext::TotalSettings totalSettings{cfg::GetMaxAbsent(), cfg::GetMaxMean(), cfg::GetWeightedAvg()};
+    m_bBonus4Display = m_calc.CalcTotal(totals, maxSession, globalPairs, totalSettings);
+    m_bHaveTotal     = true;
+    score::WriteTotalRank(m_calc.GetTotalRankToPair());  // rankorder for support of pair-assignments in next session
+}   // CalcTotal()
+
+void CalcReports::SaveTotalResult()
+{
+    if (!m_bHaveTotal) return;
+    UINT maxSession             = cfg::GetActiveSession();
+    bool bWeightedAvg           = cfg::GetWeightedAvg();
+    bool bBonus4Display         = m_bBonus4Display;
+    UINT globalPairs            = names::GetNumberOfGlobalPairs();
+    std::vector<cor::mCorrectionsEnd> sessionResults(maxSession+1ULL);   // only needed for the session columns of this list
+    for (UINT session = 1; session <= maxSession; ++session)
+        (void)ReadSessionResult(sessionResults[session], session, globalPairs);
+    const auto& totalResult     = m_calc.GetTotalResult();
+    const auto& totalRankToPair = m_calc.GetTotalRankToPair();
+    const auto& totalPairToRank = m_calc.GetTotalPairToRank();
+
+    std::vector<UINT> indexSessionPairnr;    // index with session pairnrs in it for getting group-string if wanted
+    indexSessionPairnr.resize(totalRankToPair.size());
+    for ( UINT ii = 1; ii < indexSessionPairnr.size(); ++ii)
+    {
+        indexSessionPairnr[ii] = names::PairnrGlobal2SessionPairnr(totalRankToPair[ii]);
+    }
+    indexSessionPairnr[0] = 0;
+
+    m_txtFileResultTotal.MyCreate(cfg::ConstructFilename(cfg::EXT_RESULT_TOTAL), MyTextFile::WRITE);
+    m_txtFileResultTotal.AddLine(cfg::GetDescription());
+    m_txtFileResultTotal.AddLine(FMT(_("Final result%s"), bWeightedAvg ? _(" (weighted average)") : ES));
+    m_txtFileResultTotal.AddLine(ES);
+
+    // form definitions
+    const size_t SIZE_RT_RANK        (4);
+    const size_t SIZE_RT_NAME        (cfg::MAX_NAME_SIZE);
+    const size_t SIZE_RT_SESSION     (5);
+    const size_t SIZE_RT_BONUS       (7);
+    const size_t SIZE_RT_TOTAL       (7);
+    const size_t SIZE_RT_AVG         (5);
+    const size_t SIZE_RI_SCORE       (6);
+    const size_t SIZE_RT_CORRECTION  (5);
+    const size_t SIZE_RT_GROUPRESULT (FormBuilder::NO_LIMIT);
+
+    #define RT_INSERT_POS ((size_t)2)   /*start index to insert session info*/
+    std::vector<FormBuilder::ColumnInfoRow> formInfo =
+    {   // column-size definition and info for all rows
+          {SIZE_RT_RANK       , FormBuilder::Align::RIGHT, ES , true}
+        , {SIZE_RT_NAME       , FormBuilder::Align::LEFT , ' ', true}
+        // session info added later
+        , {SIZE_RT_BONUS      , FormBuilder::Align::RIGHT, ES , bBonus4Display}
+        , {SIZE_RT_TOTAL      , FormBuilder::Align::RIGHT, ES , true}
+        , {SIZE_RT_AVG        , FormBuilder::Align::RIGHT, ES , true}
+        , {SIZE_RT_GROUPRESULT, FormBuilder::Align::LEFT , ES , true}
+    };
+
+    std::vector<FormBuilder::ColumnInfoHeader> headerInfo =
+    {   // as it says: info for the header, columnsize is taken from the form-info
+          {FormBuilder::Align::LEFT , ES , _("rank"    )}
+        , {FormBuilder::Align::LEFT , ' ', _("pairname")}
+        // session info added later
+        , {FormBuilder::Align::RIGHT, ES , _("bonus"   )}      //xgettext:TRANSLATORS: "total", translation max length = 7
+        , {FormBuilder::Align::RIGHT, ES , _("total"   )}      //xgettext:TRANSLATORS: "avg.", translation max length = 5
+        , {FormBuilder::Align::RIGHT, ES , _("avg."    )}
+        , {FormBuilder::Align::LEFT , ES , GetGroupResultString(0, &indexSessionPairnr, GROUPRESULT_FINAL)}
+    };
+
+    for (UINT session=1; session <= maxSession; ++session)
+    {
+        formInfo  .emplace(formInfo.begin()   + RT_INSERT_POS + session - 1, SIZE_RT_SESSION, FormBuilder::Align::RIGHT, ES, true);
+        //xgettext:TRANSLATORS: 'S' is first character of 'Session'
+        headerInfo.emplace(headerInfo.begin() + RT_INSERT_POS + session - 1, FormBuilder::Align::CENTER, ' ', FMT(_("S%u"), session));
+    }
+
+    FormBuilder totalForm(formInfo);
+    wxString tmp = totalForm.CreateHeader(headerInfo);
+    m_txtFileResultTotal.AddLine(tmp);
+
+    std::vector<wxString> rowInfo(formInfo.size()); // reused for all rows: the strings keep their buffers
+    for (UINT rank = 1; rank < totalRankToPair.size(); ++rank)
+    {
+        UINT pair       = totalRankToPair[rank];
+        if (!totalResult[pair].bHasPlayed)
+            break;  // all global players that have not played yet, should be at end of rank-array!
+        Fdp totalScore  = bWeightedAvg ? totalResult[pair].totalW : totalResult[pair].totalN;
+        Fdp average     = bWeightedAvg ? totalResult[pair].avgW   : totalResult[pair].avgN;
+        Fdp avgAbsent   = bWeightedAvg ? totalResult[pair].avgAbsentW : totalResult[pair].avgAbsentN;
+        size_t column   = 0;
+        U2String(totalPairToRank[pair], rowInfo[column++]);
+        rowInfo[column++] = DottedName(names::PairnrGlobal2GlobalText(pair));
+
+        for (UINT session=1; session <= maxSession; ++session)
+        {
+            char extra = ' ';
+            Fdp score = sessionResults[session][pair].score;
+            if ( score == SCORE_NO_TOTAL )
+                rowInfo[column] = "-----";
+            else if (sessionResults[session][pair].games == 0)
+            {
+                avgAbsent.AsString2F(rowInfo[column]);
+                extra = 'a';
+            }
+            else
+                score.AsString2F(rowInfo[column]);
+            ++column;
+
+            formInfo[RT_INSERT_POS + session - 1].extra = extra;
+        }
+        if ( totalResult[pair].bonus )    // yes, this pair has a bonus!
+            totalResult[pair].bonus.AsString2F(rowInfo[column++]);
+        else
+            rowInfo[column++].clear();
+        wxString& totalString = rowInfo[column++];
+        totalScore.AsString2F(totalString);
+        if ( bWeightedAvg )
+        {   // some pairs did have non-playing table(s)
+            if (totalResult[pair].bWeightedAvg)
+                totalString += '+';     // this pair did have non-playing table(s)
+            else
+                totalString += ' ';
+        }
+        average.AsString2F(rowInfo[column++]);
+        rowInfo[column++] = totalResult[pair].bNoTotal ? ES : GetGroupResultString(names::PairnrGlobal2SessionPairnr(pair));
+        totalForm.CreateRow(rowInfo, tmp);
+        m_txtFileResultTotal.AddLine(tmp);
+    }   // end for all ranks
+
+    m_txtFileResultTotal.Flush();
+}   // SaveTotalResult()
+
+struct CLUB_DATA
+{
+    Fdp     score;              // accumulated (session) scores, up to max nr of allowed pairs
+    Fdp     totalScore;         // accumulated scores for all pairs
+    UINT    clubCount   = 0;    // nr of pairs playing for this club
+    UINT    clubId      = 0;    // the id of the club, from name-info
+    Fdp     average;            // average of upto cfg::GetMaxClubcount() pairs;
+};
+
+static bool CompareClubs(const CLUB_DATA& left, const CLUB_DATA& right)
+{   // compare function for sorting the club-results
+    UINT state = 0;
+    if (left.clubCount >= cfg::GetMinClubcount())
+        state  = 1;
+    if (right.clubCount >= cfg::GetMinClubcount())
+        state |= 2;
+    switch (state)
+    {
+        case 1: return true;    // left  within limits, right not: so left  is larger!
+        case 2: return false;   // right within limits, left  not: so right is larger!
+        case 3:                 // both within limits, so simply compare (inrange) averages (== scores)
+            // comparing averages is much more 'fair' then scores/totals: more pairs are favored!
+            return left.average > right.average;    // return left.score > right.score;
+        default:                // both NOT within limits, compare averages (totalscores)
+            return left.average > right.average;    //return left.totalScore > right.totalScore;
+    }
+}   // CompareClubs()
+
+void CalcReports::CalcClub( bool a_bTotal)
+{   // results for clubs, if you have assigned pairnames to a club
+    UINT                maxClubIndex= 0;
+    const auto&         rankToPair  = a_bTotal ? m_calc.GetTotalRankToPair() : m_calc.GetSessionRankToPair();
+    MyTextFile&         txtFile     = a_bTotal ? m_txtFileResultClubTotal : m_txtFileResultClubSession;
+    UINT                session     = cfg::GetActiveSession();
+    UINT                maxSession  = a_bTotal ? session : 1;
+    wxString            header      = a_bTotal ? _("Final result") : session ? FMT(_("Result of session %u"), session): _("Session result");
+    wxString            fileName    = cfg::ConstructFilename(a_bTotal ? cfg::EXT_CLUB_TOTAL : cfg::EXT_SESSION_CLUB);
+    txtFile.Close();                    // no clubs: no list, not the one of a previous calculation
+
+    std::vector<CLUB_DATA> club;
+    club.resize(cfg::MAX_CLUBNAMES+1ULL);
+
+    UINT maxClubCount = cfg::GetMaxClubcount();
+    UINT minClubCount = cfg::GetMinClubcount();
+    for (UINT rank = 1; rank < rankToPair.size(); ++rank)   // sum first N scores per club
+    {
+        UINT pair = rankToPair[rank];
+        if (pair)                                           // a pair that has played
+        {
+            // for total, use sum of session-results for better accuracy
+            // like: (x.01+x.00)/2 = x.01   and (x.01+x.01)/2=x.01, but its 'more'!
+            Fdp score = a_bTotal ? m_calc.GetTotalResult()[pair].totalN : m_calc.GetSessionResult()[pair].procentScore;   // score bepalen
+            if (score)
+            {
+                if (!a_bTotal) pair = names::PairnrSession2GlobalPairnr(pair);
+                UINT clubId =  names::GetGlobalPairInfo(pair).clubIndex;         // club-id
+                if (clubId > maxClubIndex)
+                    maxClubIndex = clubId;
+                if (club[clubId].clubCount < maxClubCount)
+                {
+                    club[clubId].score += score;        // sum allowable scores
+                    club[clubId].clubId = clubId;       // and remember its id
+                    // only use 'average' for sorting: arbitrairy *100, so we have 2 extra significant digits
+                    club[clubId].average= (100*club[clubId].score)/(int)(1+club[clubId].clubCount);
+                }
+                club[clubId].totalScore += score;       // sum ALL scores
+                club[clubId].clubCount++;               // and adjust clubCount
+            }
+        }
+    }
+    // now we have all scores
+    if (maxClubIndex == 0) return;      // without clubs, no clubresults!
+
+    std::sort(club.begin()+1, club.begin()+maxClubIndex+1, CompareClubs);
+    txtFile.MyCreate(fileName, MyTextFile::WRITE);
+    txtFile.AddLine(ES);
+
+    wxString tmp = FMT(_("%s of the clubs for '%s'"), header, cfg::GetDescription());
+    txtFile.AddLine(tmp);
+
+    tmp = FMT(_("minimum number of pairs : %u"),minClubCount);
+    txtFile.AddLine(tmp);
+
+    tmp = FMT(_("maxsimum number of pairs: %u"),maxClubCount);
+    txtFile.AddLine(tmp);
+    txtFile.AddLine(m_bButler ? _("Scores are in imps, results and average in imps/pair") : _("Scores, results and average are in %"));
+    txtFile.AddLine(ES);
+
+    const size_t SIZE_CR_RANK        (4);
+    const size_t SIZE_CR_COUNT       (6);
+    const size_t SIZE_CR_CLUB        (cfg::MAX_CLUB_SIZE);
+    const size_t SIZE_CR_SCORE       (7);
+    const size_t SIZE_CR_AVG         (5);
+    const size_t SIZE_CR_TOTAL       (FormBuilder::NO_LIMIT);
+
+
+    std::vector<FormBuilder::ColumnInfoRow> formInfo =
+    {
+          {SIZE_CR_RANK , FormBuilder::Align::RIGHT_SPACE1, ES, true}
+        , {SIZE_CR_COUNT, FormBuilder::Align::RIGHT_SPACE2, ES, true}
+        , {SIZE_CR_CLUB , FormBuilder::Align::LEFT        , ES, true}
+        , {SIZE_CR_SCORE, FormBuilder::Align::RIGHT       , ES, true}
+        , {SIZE_CR_AVG  , FormBuilder::Align::RIGHT       , ES, true}
+        , {SIZE_CR_TOTAL, FormBuilder::Align::RIGHT       , ES, true}
+    };
+
+    std::vector<FormBuilder::ColumnInfoHeader> headerInfo =
+    {   // as it says: info for the header, columnsize is taken from the form-info
+          {FormBuilder::Align::RIGHT, ES , _("rank"      )}
+        , {FormBuilder::Align::RIGHT, ES , _("count"     )}
+        , {FormBuilder::Align::LEFT , ES , _("club-name" )}
+        , {FormBuilder::Align::RIGHT, ES , _("score"     )}
+        , {FormBuilder::Align::RIGHT, ' ', _("avg."      )}
+        , {FormBuilder::Align::LEFT , ES , _("totalscore")}
+    };
+
+    FormBuilder clubResult(formInfo);
+    wxString tmp2 = clubResult.CreateHeader(headerInfo);
+
+    txtFile.AddLine(tmp2);
+
+
+    UINT rank               = 1;
+    UINT actualRank         = 1;
+    Fdp  previousAvgScore   = 99999;    // just some impossible score..
+
+    for (UINT clubIndex = 1; clubIndex <= maxClubIndex; ++clubIndex)
+    {
+        UINT clubCount = club[clubIndex].clubCount;
+        if (clubCount == 0) continue;      // this club was not present in match
+
+        if (clubCount > maxClubCount)
+            clubCount = maxClubCount;
+        Fdp avgScore = club[clubIndex].score/(clubCount * maxSession);
+        if (avgScore != previousAvgScore)
+        {   // check if previous score is equal, and then emit equal rank
+            actualRank = rank;
+            previousAvgScore = avgScore;
+        }
+        std::vector<wxString> rowInfo =
+        {
+              U2String(actualRank)
+            , U2String(clubCount)
+            , names::GetClubName(club[clubIndex].clubId)
+            , club[clubIndex].score.AsString2F()
+            , avgScore.AsString2F()
+            , FMT("%7s (%2u, %5s)"
+                , club[clubIndex].totalScore.AsString2F()
+                , club[clubIndex].clubCount
+                , (club[clubIndex].totalScore/(club[clubIndex].clubCount * maxSession)).Round(2).AsString2F())
+        };
+        tmp2 = clubResult.CreateRow(rowInfo);
+        txtFile.AddLine(tmp2);
+
+        ++rank;
+    }
+
+    if (club[0].clubCount)
+    {   // pairs, not a member of a club
+        txtFile.AddLine(ES);
+        tmp = FMT(_("individual pairs: %u, score: %6s (%5s)"),
+            club[0].clubCount,
+            club[0].totalScore.AsString2F(),
+            (club[0].totalScore/(club[0].clubCount*maxSession)).Round(2).AsString2F()
+        );
+        txtFile.AddLine(tmp);
+    }
+
+    txtFile.Flush();    // write to disk
+}   // CalcClub()
+
+bool CalcReports::FindBadGameData(wxString& a_info) const
+{   // check if there are pair numbers greater then max number of players according schema
+    // calculation of the results would assert (invalid array-index)
+    bool bBadGameData= false;
+    a_info = _("In game results:\n\n");
+    std::vector<UINT> badPairs;
+#define CHECK_PAIR(pair) \
+        if ( (pair > m_numberOfSessionPairs) && badPairs.end() == std::find(badPairs.begin(), badPairs.end(), pair )) \
+        {\
+            a_info += FMT(_("Pairnr out of range:%3u, score(s) found for this pair.\n"), pair);\
+            badPairs.push_back(pair);\
+            bBadGameData = true;\
+        }
+
+    for (const auto& gamesData : m_calc.GetScoreData())
+    {   // for all games
+        for (const auto& result : gamesData)
+        {   // for all gameresults
+            CHECK_PAIR(result.pairNS);
+            CHECK_PAIR(result.pairEW);
+        }
+    }
+
+    if (bBadGameData)
+    {
+        a_info +=     _("\nDid you lower the number of players in any group?");
+        a_info += FMT(_("\nMaximum pair nr: %u (== sum of pairs in all groups)."), m_numberOfSessionPairs);
+        a_info +=     _("\nBetter remove scores of pairs you want to remove.");
+        a_info +=     _("\nResults are NOT reliable!");
+    }
+    return bBadGameData;
+#undef CHECK_PAIR
+}   // FindBadGameData()
+
+static bool IsCombiCandidate(UINT a_sessionPair)
+{
+    auto        pGroupData = cfg::GetGroupDataFromSessionPair(a_sessionPair);
+    SchemaInfo  si(pGroupData->schemaId);
+    return si.AreOpponents(a_sessionPair - pGroupData->groupOffset, pGroupData->absent);
+}   // IsCombiCandidate()
+
+void CalcReports::GetValidatedEndCorrections4Session(cor::mCorrectionsEnd& a_ce, UINT a_session)
+{
+    (void)io::CorrectionsEndRead( a_ce, a_session, true);
+    wxString errorMsg;
+    cor::mCorrectionsEnd ceTemp;
+    bool bTesting= cfg::IsScriptTesting();
+
+    for (const auto& [globalPair, ce] : a_ce)
+    {
+        auto realScore = (ce.score == SCORE_IGNORE || ce.score == SCORE_NO_TOTAL) ? 0 : ce.score;
+        if (
+               (ce.score < (m_bButler ? -100 : 0 ))
+            || ((ce.score  > 100) && realScore) // between 0 and 100%
+            || (ce.bonus   <= -100)
+            || (ce.bonus   >= +100) // between -99.99% and +99.99% or imps
+            || (globalPair < 1)
+            || (globalPair > names::GetNumberOfGlobalPairs())
+            || (ce.games   > cfg::GetNrOfGames())
+            || (ce.bonus && (ce.games || realScore))
+            )
+        {   // (some) incorrect value(s)
+            if ( !bTesting )
+            {
+                errorMsg += FMT("\n:  '%u,%s,%s,%u'"
+                                    , globalPair
+                                    , ce.score.AsString2F()
+                                    , ce.bonus.AsString2F()
+                                    , ce.games
+                               );
+            }
+        }
+        else
+            ceTemp[globalPair] = ce;
+    }   // for
+
+    if ( errorMsg.Len() )
+    {
+        m_vMessages.push_back({_("Invalid total-correction/end data, will be ignored") + errorMsg, _("Warning")});
+    }
+
+    a_ce = ceTemp;  // copy to destination what we have...
+}   // GetValidatedEndCorrections4Session()
+
+static UINT GetNumberOfRounds(UINT a_sessionPair)
+{
+    auto        pGroupData = cfg::GetGroupDataFromSessionPair(a_sessionPair);
+    SchemaInfo  si(pGroupData->schemaId);
+    return si.GetNumberOfRounds();
+}   // GetNumberOfRounds()
+
+wxString FormBuilder::CreateHeader(const std::vector<ColumnInfoHeader>& a_headerInfo) const
+{   // creation of the header, called once
+    auto size = a_headerInfo.size();
+    if (size != m_rowInfo.size())   // no translation: error should popup during development!
+        return "Error: mismatch in size of headerInfo and rowInfo";
+    wxString result;
+    auto rowInfo = m_rowInfo.begin();
+    for (const auto& column : a_headerInfo)
+    {
+        if (rowInfo->active)
+        {
+            if (FormBuilder::NO_LIMIT == rowInfo->size)
+                result += column.header;
+            else
+                AppendColumn(result, column.header, rowInfo->size, column.align);
+            result += column.extra;
+        }
+        result += FormBuilder::SEPERATOR;   // add a separator between colums
+        ++rowInfo;
+    }
+    return result.RemoveLast(); // remove last separator
+}   // CreateHeader()
+
+wxString FormBuilder::CreateRow(const std::vector<wxString>& a_columsContent) const
+{
+    wxString result;
+    CreateRow(a_columsContent, result);
+    return result;
+}   // CreateRow()
+
+void FormBuilder::CreateRow(const std::vector<wxString>& a_columsContent, wxString& a_result) const
+{   // called for each data-row: a_result keeps its buffer, so reusing it for all rows saves allocations
+    a_result.clear();
+    size_t size = a_columsContent.size();
+    if (size != m_rowInfo.size())   // no translation: error should popup during development!
+    {
+        a_result = "Error: mismatch in size of columnInfo and rowInfo";
+        return;
+    }
+    auto content = a_columsContent.begin();
+    for (const auto& column : m_rowInfo)
+    {
+        if (column.active)
+        {
+            if (FormBuilder::NO_LIMIT == column.size)
+                a_result += *content;
+            else
+                AppendColumn(a_result, *content, column.size, column.align);
+            a_result += column.extra;
+        }
+        a_result += FormBuilder::SEPERATOR;   // add a separator between colums
+        ++content;
+    }
+    a_result.RemoveLast(); // remove last separator
+}   // CreateRow()
+
+wxString FormBuilder::CreateColumn(const wxString& a_input, size_t a_len, Align a_align)
+{   // create a string with the wanted columnsize and alignment
+    wxString result;
+    AppendColumn(result, a_input, a_len, a_align);
+    return result;
+}   // CreateColumn()
+
+void FormBuilder::AppendColumn(wxString& a_result, const wxString& a_input, size_t a_len, Align a_align)
+{   // append a_input with the wanted columnsize and alignment
+    #define _TEST_ 0
+    #if _TEST_
+        constexpr auto FILL_LEFT = '<';
+        constexpr auto FILL_RIGHT = '>';
+    #else
+        constexpr auto FILL_LEFT  = ' ';
+        constexpr auto FILL_RIGHT = ' ';
+    #endif
+    size_t len = a_input.Len();
+    if (len >= a_len)
+    {   // no room for alignment
+        a_result.append(a_input, 0, a_len);
+        return;
+    }
+
+    size_t before = 0;      // the xxx_SPACEn alignments: extra spaces before/after a_input
+    size_t after  = 0;
+    switch (a_align)
+    {
+        using enum FormBuilder::Align;
+        case LEFT_SPACE1:  before = 1; a_align = LEFT;  break;
+        case LEFT_SPACE2:  before = 2; a_align = LEFT;  break;
+        case RIGHT_SPACE1: after  = 1; a_align = RIGHT; break;
+        case RIGHT_SPACE2: after  = 2; a_align = RIGHT; break;
+        default:                                        break;
+    }
+
+    len += before + after;
+    if (len >= a_len)
+    {   // no room for alignment: the first a_len characters of the spaces and a_input
+        size_t count = std::min(before, a_len);
+        a_result.append(count, ' ');
+        size_t remaining = a_len - count;
+        count = std::min(a_input.Len(), remaining);
+        a_result.append(a_input, 0, count);
+        a_result.append(remaining - count, ' ');    // part of 'after'
+        return;
+    }
+
+    size_t fill     = a_len - len;
+    size_t fillLeft = 0;
+    switch (a_align)
+    {
+        using enum FormBuilder::Align;
+        case CENTER: fillLeft = fill/2; break;
+        case RIGHT:  fillLeft = fill;   break;
+        default:                        break;
+    }
+    a_result.append(fillLeft, FILL_LEFT);
+    a_result.append(before  , ' ');
+    a_result += a_input;
+    a_result.append(after   , ' ');
+    a_result.append(fill - fillLeft, FILL_RIGHT);
+}   // AppendColumn()
@@ -0,0 +1,162 @@
+﻿// Copyright(c) 2024-present, BusyHarry/h.levels & BridgeWx contributors.
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#if !defined _CALC_REPORTS_H_
+#define _CALC_REPORTS_H_
+#pragma once
+
+#include <vector>
+#include <array>
+#include <cstdint>
+#include <stop_token>
+#include <wx/string.h>
+#include "mytextfile.h"
+#include "calcengine.h"
+
+class CalcReports
+{   // Calculates the results of the active match/session and creates the result lists.
+    // No ui is used: messages for the user are collected and can be taken by the caller.
+    // So it can be used by the CalcScore page and by the (console) batch calculator.
+public:
+    enum Report
+    {
+          ReportSession
+        , ReportSessionName
+        , ReportTotal
+        , ReportFrqTable
+        , ReportGroup
+        , ReportClubSession
+        , ReportClubTotal
+        , ReportMax
+    };
+
+    struct Message
+    {
+        wxString message;
+        wxString caption;
+    };
+
+    CalcReports () = default;
+    ~CalcReports() = default;
+    bool                            Calculate           ();     // (re)calculate and create the lists, returns false if nothing changed since last call
+
+    // Calculate() in steps, so the calculation can be done in a worker thread
+    bool                            Prepare             ();     // ui thread : PrepareInput(), returns false if nothing changed since last MakeReports()
+    bool                            PrepareInput        ();     // ui thread : copy the input that is in memory, returns false if it did not change
+    bool                            CalcGames           (std::stop_token stop = {}, const CalcContext::Progress& progress = nullptr);    // any thread: read the rest of the input, use the stored results
+                                                                //             if made from the same input, else calculate. Returns false if stopped
+    bool                            IsCalculated        () const {return m_bCalculated;}    // CalcGames() is ready for the current input
+    void                            MakeReports         ();     // ui thread : make the results final and write them to the database, only after CalcGames() returned true
+    const MyTextFile&               GetReport           (Report report);    // the list is created on first use after MakeReports()
+    const CalcContext&              GetContext          () const {return m_calc;}  // session results of the engine
+    const std::vector<wxString>&    GetFrequencyTable   (UINT game);        // created on first use after MakeReports()
+    void                            GetSessionCorrectionStrings(UINT sessionPair, wxString& sCombiResult, wxString& sCorrectionResult) const;
+    bool                            FindBadGameData     (wxString& info) const;    // return true if invalid pairnrs found in gamedata
+    std::vector<Message>            TakeMessages        ();     // messages collected during the last calculation
+    void                            Flush               ();     // store the session results with the hash of their input
+    bool                            SaveReports         (const wxString& folder);   // create and write all lists to 'folder'
+
+private:
+    void        MakeReport              (Report report);    // create one list
+    MyTextFile& GetReportFile           (Report report);    // the list, as it is now
+    void        ReadInput               ();     // CalcGames() helper: the input from the database and its hash
+    uint64_t    CalcInputHash           () const;           // hash of all input of the engine
+    bool        LoadCache               ();     // use the stored session results, if made from the same input
+    void        SaveCache               ();     // store the session results with the hash of their input
+    void        CalcTotal               ();     // sum of results for all sesssions upto current session
+    void        SaveTotalResult         ();
+    void        CalcClub                (bool a_bTotal);     // results for clubs, if pairs have assigned clubs(total or session)
+    void        SaveSessionResults      ();
+    void        SaveSessionResultsProcent();
+    void        SaveSessionResultsButler();
+    void        SaveGroupResult         ();
+    void        SaveFrequencyTable      ();
+    void        MakeFrequenceTable      (UINT a_game, std::vector<wxString>& a_stringTable) const;
+    void        SaveSessionResultShort  ();
+    void        GetValidatedEndCorrections4Session(cor::mCorrectionsEnd& ce, UINT session);
+    UINT        ReadSessionResult       (cor::mCorrectionsEnd& result, UINT session, UINT globalPairs) const;   // returns max games played
+    Fdp         GetResultScore          (UINT sessionPairnr, bool bSession) const;
+    static const bool GROUPRESULT_SESSION = true;
+    static const bool GROUPRESULT_FINAL   = false;
+    wxString    GetGroupResultString    (UINT pair, const std::vector<UINT>* a_pIndex = nullptr, bool bSession = GROUPRESULT_FINAL);    // get groupstring or rank in group "BLYEGR" / " . 1 ."
+    void        CalcGroupRanks          (const std::vector<UINT>& rankIndex, bool bSession, std::vector<UINT>& groupRank) const;
+
+    CalcContext m_calc;                         // kept between calculations, so only changed games are recalculated
+    vvScoreData m_scoreData;                    // copy of the scores used by m_calc
+    std::vector<CalcContext::PairSchema> m_vSchema; // [sessionPair]: schema info used by m_calc
+    cor::mCorrectionsSession m_correctionsSession;  // corrections used by m_calc, before validation
+    UINT        m_calculatedGames = 0;          // games (re)calculated by the last CalcGames()
+    bool        m_bInputValid   = false;        // PrepareInput() has copied the input of the current configuration
+    bool        m_bInputRead    = false;        // CalcGames() has read the rest of the input
+    bool        m_bCalculated   = false;        // the engine has the session results of the current input
+    bool        m_bReportsValid = false;        // false: (last) calculation not finished, so the lists are not up-to-date
+    bool        m_bCacheStored  = false;        // the session results are stored for the current input
+    UINT        m_session       = 0;            // active session of the input
+    bool        m_bScriptTesting= false;        // no messages for ignored corrections
+    uint64_t    m_inputHash     = 0;            // hash of the input of the last Prepare()
+    uint64_t    m_engineHash    = 0;            // hash of the input of the session results in m_calc
+    std::array<bool, ReportMax> m_bReportMade{};    // list is created after the last MakeReports()
+    std::vector<bool>           m_vFrqStringMade;   // frq table of a game is created after the last MakeReports()
+    bool        m_bHaveTotal    = false;        // total result is calculated
+    bool        m_bBonus4Display= false;        // total: a pair has a bonus
+    MyTextFile  m_txtFileResultSession;
+    MyTextFile  m_txtFileResultOnName;
+    MyTextFile  m_txtFileFrqTable;
+    MyTextFile  m_txtFileResultGroup;
+    MyTextFile  m_txtFileResultTotal;
+    MyTextFile  m_txtFileResultClubTotal;
+    MyTextFile  m_txtFileResultClubSession;
+    std::vector<std::vector<wxString> > m_vFrqStringTable;  // for each (internal) gamenr its string representation
+    std::vector<UINT>       m_vGroupRankSession;        // rank within group for sessionPair, session result
+    std::vector<UINT>       m_vGroupRankFinal;          // rank within group for sessionPair, final result
+    std::vector<Message>    m_vMessages;                // info for the user, collected while calculating
+    UINT        m_numberOfSessionPairs = 0;     // sum of pairs in all groups
+    bool        m_bButler       = false;
+    bool        m_bCrossImps    = false;        // butler: cross-imps i.s.o. a datum score
+    UINT        m_maxPair       = 1;            // highest pairnr played in this session
+};  // CalcReports
+
+class FormBuilder
+{   // class to create a table with a header and one or more rows of data
+public:
+    enum class Align
+    {   // alignment in the columns of the header/rows
+          LEFT          // fillup with spaces after till wanted size
+        , CENTER        // as much spaces before and after till wanted size
+        , RIGHT         // as much spaces before till wanted size
+        , LEFT_SPACE1   // add one space in front, then LEFT
+        , LEFT_SPACE2   // add two spaces in front, then LEFT
+        , RIGHT_SPACE1  // add one space after, then RIGHT
+        , RIGHT_SPACE2  // add two spaces after, then RIGHT
+    };
+    static const size_t NO_LIMIT = ((size_t)-1);    // don't apply alignment for this column (mostly the last column)
+    static const char SEPERATOR = ' ';              // separator between columns
+    struct ColumnInfoHeader
+    {
+        Align       align;  // Can be different from row-alignment
+        wxString    extra;  // append this string to the constructed string
+        wxString    header; // column label
+    };
+
+    struct ColumnInfoRow
+    {
+        size_t      size;   // size of this column            , also used for the header
+        Align       align;  // alignment for the data-columns
+        wxString    extra;  // append this string to the constructed string
+        bool        active; // if not set, ignore this column , also used for the header
+    };
+
+    explicit FormBuilder(const std::vector<ColumnInfoRow>& a_rowInfo) : m_rowInfo(a_rowInfo) {}
+    ~FormBuilder() = default;
+
+    wxString        CreateHeader(const std::vector<ColumnInfoHeader>& headerInfo) const;
+    wxString        CreateRow   (const std::vector<wxString>& columsContent) const;
+    void            CreateRow   (const std::vector<wxString>& columsContent, wxString& result) const;  // into a caller-owned buffer
+    static wxString CreateColumn(const wxString& input, size_t len, Align align);
+    static void     AppendColumn(wxString& result, const wxString& input, size_t len, Align align);   // no temporary strings
+
+private:
+    const std::vector<ColumnInfoRow>& m_rowInfo;  // reference, so one can apply runtime updates
+};  // FormBuilder
+
+#endif
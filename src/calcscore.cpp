@@ -2,165 +2,97 @@
 // Distributed under the MIT License (http://opensource.org/licenses/MIT)
 
 #include <wx/wx.h>
-#include <numeric>
+#include <algorithm>
+#include <atomic>
 
 #include "cfg.h"
 #include "score.h"
 #include "calcscore.h"
-#include "corrections.h"
 #include "names.h"
 #include "printer.h"
-#include "fileio.h"
 #include "main.h"
 
-static const auto sButlerRemoveScoresPercent = 10;  // remove N % of highest/lowest scores
-static const auto sButlerMinimumScores       = 3;   // we want atleast N scores after removal
-static const auto sButlerImpsPer10Procent    = 2;   // referee scores: each 10% above/below 50% equals N imps, ASSUME scores are multiple of 5%
-
-struct ButlerFkw{bool bInit = false; long scoreNs=0;long deltaNs=0; int impsNs=0; long scoreEw=0; long deltaEw=0;int impsEw=0;};
-
-using ButlerFkwMap = std::map<long, ButlerFkw>;
-static std::vector<ButlerFkwMap> svButlerFkw;
-
-struct DatumScore{int dsNS=0; int dsEW=0;};
-static std::vector<DatumScore> svDatumScores;
-struct lowHighImp { int low; int high; int mp; };
-static const lowHighImp suImpTable[]=
-{
-    {0   , 10  , 0 }, {20  , 40  , 1 }, {50  , 80  , 2 }, {90  , 120 , 3 }, {130 , 160 , 4 }, {170 , 210 , 5 },
-    {220 , 260 , 6 }, {270 , 310 , 7 }, {320 , 360 , 8 }, {370 , 420 , 9 }, {430 , 490 , 10}, {500 , 590 , 11},
-    {600 , 740 , 12}, {750 , 890 , 13}, {900 , 1090, 14}, {1100, 1290, 15}, {1300, 1490, 16}, {1500, 1740, 17},
-    {1750, 1990, 18}, {2000, 2240, 19}, {2250, 2490, 20}, {2500, 2990, 21}, {3000, 3490, 22}, {3500, 3990, 23},
-    {4000, 99999,24}
+static CalcReports ssReports;   // kept between pages, so only changed games are recalculated
+static std::atomic<bool> ssbEngineBusy{false};  // a worker uses ssReports: no new Prepare() allowed
+static bool         ssbPageActive    = false;   // the page is shown and does its own calculations
+static std::jthread ssIdleThread;               // speculative calculation, started from CalcScoreOnIdle()
+static int          ssIdleConfigHash = -1;      // confighash of the data of the last idle calculation
+
+void CalcScoreStopIdle()
+{
+    if (ssIdleThread.joinable())
+    {
+        ssIdleThread.request_stop();
+        ssIdleThread.join();        // stop is checked for each game, so this is short
+    }
+}   // CalcScoreStopIdle()
+
+void CalcScoreOnIdle()
+{   // scores or corrections changed: calculate in the background and stage the engine results for the page.
+    // Only the input in memory is copied here, the worker reads the rest. The page makes the lists and writes the results.
+    if (ssbPageActive || ssbEngineBusy || cfg::IsScriptTesting()) return;
+    if (cfg::GetConfigHash() == ssIdleConfigHash) return;  // nothing changed since the last idle calculation
+    if (ssIdleThread.joinable()) ssIdleThread.join();       // finished, its result is staged
+
+    (void)ssReports.PrepareInput();
+    ssIdleConfigHash = cfg::GetConfigHash();
+    if (ssReports.IsCalculated()) return;   // staged results are still up-to-date
+
+    ssbEngineBusy = true;
+    ssIdleThread  = std::jthread([](std::stop_token a_stop)
+        {   // stopped: the page (or the next idle) continues with the remaining games
+            if (ssReports.CalcGames(a_stop)) MyLogDebug("Idle calculation ready, results are staged");
+            ssbEngineBusy = false;
+        });
+}   // CalcScoreOnIdle()
+
+class ReportListView final : public wxListView
+{   // virtual list: the lines are taken from the report when they are shown, nothing is copied
+public:
+    ReportListView(wxWindow* a_pParent, long a_style)
+        : wxListView(a_pParent, wxID_ANY, wxDefaultPosition, wxDefaultSize, a_style | wxLC_REPORT | wxLC_VIRTUAL) {}
+    void                SetReport   (const MyTextFile* pReport, const wxString& title);    // nullptr: empty list
+    const MyTextFile*   GetReport   () const {return m_pReport;}
+    long                GetLineCount() const {return m_pReport ? (long)m_pReport->GetLineCount() : 0;}
+protected:
+    wxString            OnGetItemText(long item, long column) const final;
+private:
+    const MyTextFile*   m_pReport = nullptr;
 };
 
-static Fdp NeubergPoints(const Fdp& points, UINT gameCount, UINT comparableCount);
-
-int ButlerGetMpsFromScore(int a_score, int a_datumScore)
+void ReportListView::SetReport(const MyTextFile* a_pReport, const wxString& a_title)
 {
-    if (score::IsProcent(a_score))
-    {   // for now, assume a procentscore is a multiple of 5%
-        auto deltaProcent = score::Procentscore2Procent(a_score) - 50;
-        return sButlerImpsPer10Procent*deltaProcent/10;
-    }
+    m_pReport = a_pReport;
+    ClearAll();
+    InsertColumn(0, a_title);   // only one column
+    long lineCount = GetLineCount();
+    SetItemCount(lineCount);
 
-    // now we have a 'normal' score
-    a_score = score::Score2Real(a_score);  //convert (possible) real adjusted score to a normal score
-    auto        diff    = a_score - a_datumScore;
-    auto        absDiff = std::abs(diff);
-    int         sign    = diff < 0 ? -1 : 1;
-
-    for (const auto& score : suImpTable)
+    size_t widest = 0;          // fixed font: the longest line is the widest, no need to measure all lines
+    for (long line = 1; line < lineCount; ++line)
     {
-        if (absDiff >= score.low && absDiff <= score.high)
-            return sign*score.mp;   // could have done: return sign*index
+        if (m_pReport->GetLine(line).length() > m_pReport->GetLine(widest).length())
+            widest = line;
     }
-    return 0;   // should not happen....
-}   // ButlerGetMpsFromScore()
-
-struct ScoreInfo
-{   // 'N' = normal, non-weighted, 'W' = weighted calculation
-    Fdp  totalN;                                // total for non-weighted avg
-    Fdp  totalW;                                // sum of sessionwAvg[i], corrected for absent session(s)
-    Fdp  avgN;                                  // real          avg over played games
-    Fdp  avgW;                                  // real weighted avg over played games
-    Fdp  avgAbsentN;                            // avg for absent sessions for non-weighted
-    Fdp  avgAbsentW;                            // avg for absent sessions for weighted
-    Fdp  bonus;                                 // sum of bonusses
-    bool bWeightedAvg       = false;            // true, if not always played all games
-    bool bHasPlayed         = false;            // true, if played at least 1 game
-    UINT nrOfSessions       = 0;                // number of sessions included in total/end result
-    Fdp  totalGameScoreW;                       // sum of sessionResult[i]*sessionGames[i] for weighted calculation
-    UINT gameCount          = 0;                // sum of sessionGames[i]
-    UINT activeSessions     = 0;                // sessions with data
-    bool bNoTotal           = false;            // if set, pair is not ranked in total
-};
+    int width = GetTextExtent(a_title).x;
+    if (lineCount)
+        width = std::max(width, GetTextExtent(m_pReport->GetLine(widest)).x);
+    SetColumnWidth(0, width + 2 * GetCharWidth());
+    Refresh();
+}   // SetReport()
 
-struct TopsPerGame
+wxString ReportListView::OnGetItemText(long a_item, long /*column*/) const
 {
-    UINT topNS = 0;
-    UINT topEW = 0;
-};
-
-static const vvScoreData*               spvGameSetData;
-static       cor::mCorrectionsSession   smCorSessionValidated;          // contains ONLY correct (combi-)data, created in ValidateSessionCorrections()
-static bool                             sbHaveValidCombi { false };     // (re)set in ValidateSessionCorrections() for combi results
-static bool                             sbHaveValidNormal{ false };     // (re)set in ValidateSessionCorrections() for normal corrections
-
-static std::vector<Total>               svSessionResult;        // session result for all pairs
-static std::vector<UINT>                svSessionRankToPair;    // index array for session results: [a]=b -> at rank 'a' is sessionpair 'b'
-static std::vector<UINT>                svSessionPairToRank;    // index array for session results: [a]=b -> sessionpair 'a' has rank 'b'
-static std::vector<ScoreInfo>           svTotalResult;          // total result for all pairs
-static std::vector<UINT>                svTotalRankToPair;      // index array for total results: [a]=b -> at rank 'a' is globalpair 'b'
-static std::vector<UINT>                svTotalPairToRank;      // index array for total results: [a]=b -> globalpair 'a' has rank 'b'
-static std::vector<TopsPerGame>         svGameTops;             // max points per game for NS/EW
-
-static CalcScore::FS                    svFrequencyInfo;        // combined frq table for all games
-static std::vector<std::vector<wxString> > svFrqstringTable;    // for each (internal) gamenr its string representation
-
-static void AddHeader(MyTextFile& a_file);
-static bool IsCombiCandidate (UINT sessionPair);    // true, if pair plays against 'absent pair'
-static UINT GetNumberOfRounds(UINT sessionPair);    // number of rounds according schema for this pair
-static void ValidateSessionCorrections(const cor::mCorrectionsSession* pNonvalidatedCorrections);   // create a validated set of corrections
-static void GetValidatedEndCorrections4Session(cor::mCorrectionsEnd& ce, UINT session);
-
-static void GetSessionCorrectionStrings(UINT a_sessionPair, wxString& a_sCombiResult, wxString& a_sCorrectionResult)
-{   // get combi/corrections for a sessionPair as strings
-    a_sCombiResult.Clear();
-    a_sCorrectionResult.Clear();
-    if ( !smCorSessionValidated.size() ) return;           // no results, if no corrections at all
-    auto it = smCorSessionValidated.find(a_sessionPair);
-    if ( it == smCorSessionValidated.end() ) return;       // no results, if pair has no corrections
-
-    bool bButler = cfg::GetButler();
-    if ( it->second.games )
-    {   // combi
-        long extra = it->second.extra.Trunc(0).AsLong();
-        a_sCombiResult = bButler
-            ? FMT("%ldi"  , extra) // don't show fractional value!
-            : FMT("%ld/%d", extra, it->second.maxExtra);
-    }
-
-    int correction = it->second.correction;
-    if ( correction )
-    {   // only non-zero is a real correction
-        a_sCorrectionResult = FMT("%d%s", correction
-                                        , it->second.type == '%'
-                                            ? "%"
-                                            : ( bButler
-                                                    ? "i"
-                                                    : "mp"
-                                              )
-                                 );
-    }
-}   // GetSessionCorrectionStrings()
-
-static void InitPairToRankVector(bool a_bSession)
-{
-    #define SCORE(pair) (a_bSession ? svSessionResult[pair].procentScore : svTotalResult[pair].totalN)
-    std::vector<UINT>& pairToRank = a_bSession ? svSessionPairToRank : svTotalPairToRank;
-    std::vector<UINT>& rankToPair = a_bSession ? svSessionRankToPair : svTotalRankToPair;
-    pairToRank.clear();
-    pairToRank.resize(rankToPair.size());
-    for (UINT rank = 1; rank < rankToPair.size(); ++rank)
-    {   // todo? if pair == 0, skip this?
-        UINT pair       = rankToPair[rank];
-        Fdp  score      = SCORE(pair);
-        UINT realRank   = rank;
-        while ( (realRank > 1) && (score == SCORE(rankToPair[realRank-1])) )
-        {
-            --realRank; // find highest rank with equal score
-        }
-
-        pairToRank[pair] = realRank;    // if scores are equal, so the rank is
-    }
-}   // InitPairToRankVector()
+    if (a_item < 0 || a_item >= GetLineCount()) return ES;
+    return m_pReport->GetLine(a_item);
+}   // OnGetItemText()
 
 constexpr auto CHOICE_PAIR = "ChoicePair";
 constexpr auto CHOICE_GAME = "ChoiceGame";
 CalcScore::CalcScore(wxWindow* a_pParent, UINT a_pageId) : Baseframe(a_pParent, a_pageId)
 {
     m_bButler           = cfg::GetButler();
+    m_bCrossImps        = m_bButler && cfg::GetCrossImps();
     m_choiceResult      = ResultSession;
 
     wxItemAttr bb;
@@ -171,7 +103,7 @@ CalcScore::CalcScore(wxWindow* a_pParent, UINT a_pageId) : Baseframe(a_pParent,
         flags &= ~wxLC_HRULES;      // in darkmode, the h-rules disappear on mouseover
         bb.SetTextColour(*wxWHITE); // should be done by the system???
     }
-    m_pListBox = new wxListView(this, wxID_ANY, wxDefaultPosition, wxDefaultSize, flags);
+    m_pListBox = new ReportListView(this, flags);
     bool bResult = m_pListBox->SetHeaderAttr(bb); MY_UNUSED(bResult);
     int size = m_pListBox->GetFont().GetPointSize();
     wxFont  celFont (size, wxFONTFAMILY_TELETYPE, wxFONTSTYLE_NORMAL, wxFONTWEIGHT_NORMAL); //wxFONTWEIGHT_SEMIBOLD);
@@ -237,31 +169,31 @@ void CalcScore::ShowChoice()
     {
         case ResultSession:
             title = _("Session result");
-            pTextFile = &m_txtFileResultSession;
+            pTextFile = &ssReports.GetReport(CalcReports::ReportSession);
             break;
         case ResultSessionName:
             title = _("Session result on name");
-            pTextFile = &m_txtFileResultOnName;
+            pTextFile = &ssReports.GetReport(CalcReports::ReportSessionName);
             break;
         case ResultTotal:
             title = _("Final result");
-            pTextFile = &m_txtFileResultTotal;
+            pTextFile = &ssReports.GetReport(CalcReports::ReportTotal);
             break;
         case ResultFrqTable:
             title = _("Frequency tables");
-            pTextFile = &m_txtFileFrqTable;
+            pTextFile = &ssReports.GetReport(CalcReports::ReportFrqTable);
             break;
         case ResultGroup:
             title = _("Group result");
-            pTextFile = &m_txtFileResultGroup;
+            pTextFile = &ssReports.GetReport(CalcReports::ReportGroup);
             break;
         case ResultClubTotal:
             title = _("Club result total");
-            pTextFile = &m_txtFileResultClubTotal;
+            pTextFile = &ssReports.GetReport(CalcReports::ReportClubTotal);
             break;
         case ResultClubSession:
             title = _("Club result session");
-            pTextFile = &m_txtFileResultClubSession;
+            pTextFile = &ssReports.GetReport(CalcReports::ReportClubSession);
             break;
         case ResultPair:
             title = _("Result per pair");
@@ -274,26 +206,88 @@ void CalcScore::ShowChoice()
 
         default:
             title = _("Unknown type");
-            pTextFile = &m_txtFileResultSession;
+            pTextFile = &ssReports.GetReport(CalcReports::ReportSession);
             break;
     }
 
-    m_pListBox->ClearAll();
-    m_pListBox->InsertColumn(0, title); // only one column
+    m_pListBox->SetReport(pTextFile, title);
+}   // ShowChoice()
 
-    auto lineCount = (long)pTextFile->GetLineCount();
-    for (long line = 0 ; line < lineCount;  ++line)
+CalcScore::~CalcScore()
+{
+    StopCalculation();  // worker uses 'this'
+    ssbPageActive = false;
+}   // ~CalcScore()
+
+void CalcScore::StopCalculation()
+{   // a running calculation is stale: stop it and ignore its (pending) results
+    ++m_calcGeneration;
+    m_bCalculating = false;
+    if (m_calcThread.joinable())
     {
-        m_pListBox->InsertItem(line, pTextFile->GetLine(line));
+        m_calcThread.request_stop();
+        m_calcThread.join();        // stop is checked for each game, so this is short
     }
-    m_pListBox->SetColumnWidth(0, wxLIST_AUTOSIZE);
-}   // ShowChoice()
+}   // StopCalculation()
 
 void CalcScore::RefreshInfo()
 {
     m_bButler = cfg::GetButler();   // update flag
-    m_numberOfSessionPairs = cfg::GetNrOfSessionPairs();
-    InitializeAndCalcScores();
+    m_bCrossImps = m_bButler && cfg::GetCrossImps();
+    ssbPageActive = true;
+    CalcScoreStopIdle();        // a finished idle calculation is already staged, else we continue where it stopped
+    StopCalculation();
+    if (!ssReports.Prepare())
+    {   // nothing changed, show what we have
+        ShowResults();
+        return;
+    }
+
+    if (cfg::IsScriptTesting() || ssReports.IsCalculated())
+    {   // autotest expects the results when the page is shown, or they are staged by an idle calculation
+        (void)ssReports.CalcGames();
+        OnCalculationReady(m_calcGeneration);
+        return;
+    }
+
+    m_bCalculating = true;
+    ssbEngineBusy  = true;
+    m_pListBox->SetReport(nullptr, _("Calculating..."));
+    UINT generation = m_calcGeneration;
+    m_calcThread = std::jthread([this, generation](std::stop_token a_stop)
+        {   // only the engine runs here, the lists are made in the ui thread
+            auto progress = [this, generation](UINT a_done, UINT a_total)
+                {
+                    CallAfter([this, generation, a_done, a_total]
+                        {
+                            if (generation == m_calcGeneration)
+                                SetStatusbarText(FMT(_("Calculating: %u of %u games"), a_done, a_total));
+                        });
+                };
+            bool bReady = ssReports.CalcGames(a_stop, progress);
+            ssbEngineBusy = false;
+            if (bReady)
+                CallAfter([this, generation]{OnCalculationReady(generation);});
+        });
+}   // RefreshInfo()
+
+void CalcScore::OnCalculationReady(UINT a_generation)
+{
+    if (a_generation != m_calcGeneration) return;   // stale result, a newer calculation is (or will be) started
+    if (m_calcThread.joinable()) m_calcThread.join();
+    m_bCalculating = false;
+    ssReports.MakeReports();
+    SetStatusbarText(ES);
+    ShowResults();
+}   // OnCalculationReady()
+
+void CalcScore::ShowResults()
+{   // publish the results of the last calculation
+    m_pListBox->Freeze();
+    for (const auto& info : ssReports.TakeMessages())
+    {   // if not CallAfter() we get the msgbox on an empty page
+        CallAfter([info] {MyMessageBox(info.message, info.caption); });
+    }
     // initalize the result-choices
     wxArrayString choices = {_("session"), _("session on name"), _("frequencytables"), _("group")};
     m_vChoices.clear(); // indexes must match choice-array
@@ -321,6 +315,7 @@ void CalcScore::RefreshInfo()
     m_choiceResult = ResultSession;
     m_pChoices->Init(choices, ResultSession);
     ShowChoice();
+    m_pListBox->Thaw();
 
     const auto&     groupInfo = *cfg::GetGroupData();
     wxArrayString   pairNames;
@@ -337,24 +332,25 @@ void CalcScore::RefreshInfo()
     m_pGameSelect->Init(score::GetNumberOfGames(), (UINT)(-1));
     cfg::FLushConfigs();            // write all to disk
     Layout();
-    if (FindBadGameData())
+    if (ssReports.FindBadGameData(m_txtBadGameData))
     {   // show messagebox on top of the result
         CallAfter([this] {MyMessageBox(m_txtBadGameData, _("Error")); });
     }
-}   // RefreshInfo()
+}   // ShowResults()
 
 void CalcScore::PrintPage()
 {
-    auto itemCount = m_pListBox->GetItemCount();
-    if (itemCount == 0) return;     // nothing to print
+    auto lineCount = m_pListBox->GetLineCount();
+    if (lineCount == 0) return;     // nothing to print
     wxListItem result;
     result.SetMask(wxLIST_MASK_TEXT);
     bool bResult        = m_pListBox->GetColumn(0, result); MY_UNUSED(bResult);
     wxString headerTxt  = result.GetText();
     bResult             = prn::BeginPrint(headerTxt); MY_UNUSED(bResult);
-    for (int line = 0; line < itemCount; ++line)
+    const MyTextFile* pReport = m_pListBox->GetReport();
+    for (long line = 0; line < lineCount; ++line)
     {
-        wxString info = m_pListBox->GetItemText(line);
+        wxString info = pReport->GetLine(line);
         if (info.IsEmpty() || '\n' != *info.rbegin()) info += '\n';    // Last()== *info.rbegin()
         prn::PrintLine(info);
     }
@@ -365,10 +361,16 @@ void CalcScore::PrintPage()
 
 void CalcScore::BackupData()
 {
-    m_txtFileResultSession  .Flush();
-    m_txtFileResultOnName   .Flush();
-    m_txtFileFrqTable       .Flush();
+    if (m_bCalculating)
+    {   // leaving the page: don't wait, the result would be stale anyway
+        ++m_calcGeneration;
+        m_calcThread.request_stop();
+        SetStatusbarText(ES);
+        ssIdleConfigHash = -1;          // idle time continues with the remaining games
+    }
+    ssReports.Flush();
     m_pPairSelect->SetSelection(-1);    //unselect
+    ssbPageActive = false;              // from now on idle time is used for (re)calculations
 }   // BackupData()
 
 /* virtual */ void CalcScore::DoSearch(wxString& search)
@@ -376,14 +378,12 @@ void CalcScore::BackupData()
     m_pListBox->Select(m_findPos,false);
 
     search.MakeLower();
-    int itemCount = m_pListBox->GetItemCount();
-    // wxString wxListCtrl::GetItemText 	( 	long  	item,  int  	col = 0   ) 		const
-    for (long ii = 1; ii <= itemCount; ++ii)
+    const MyTextFile* pReport = m_pListBox->GetReport();    // search the report, not the (virtual) list
+    long lineCount = m_pListBox->GetLineCount();
+    for (long ii = 1; ii <= lineCount; ++ii)
     {
-        long line = (ii + m_findPos) % itemCount;
-        wxString fnd = m_pListBox->GetItemText(line, 0);
-        fnd.MakeLower();
-        if (wxNOT_FOUND != m_pListBox->GetItemText(line, 0).MakeLower().Find(search))
+        long line = (ii + m_findPos) % lineCount;
+        if (wxNOT_FOUND != pReport->GetLine(line).Lower().Find(search))
         {
             m_findPos= line;
             m_pListBox->Select(m_findPos);
@@ -393,252 +393,6 @@ void CalcScore::BackupData()
     }
 }   // DoSearch()
 
-void CalcScore::MergeFrqTables( FS_INFO& ns, const FS_INFO& ew) const
-{
-    for (const auto& itEW : ew)    // now merge ew into ns
-    {
-        int nsScore  = score::ScoreEwToNs(itEW.score); // transform ew-score to a comparable ns-score
-        auto itNS    = std::ranges::find_if(ns, [nsScore](const FrequencyState& fq){return nsScore == fq.score;});
-        if (itNS != ns.end())
-        {
-            itNS->pointsEW = itEW.points;  // already existing NS score, so just add EW points for this score
-        }
-        else
-        {   // non existing yet, so add the new info
-            FrequencyState fkw;
-            fkw.pointsEW = itEW.points;
-            fkw.score    = nsScore;
-            ns.push_back(fkw);
-        }
-    }
-    std::ranges::sort(ns, [](const auto& left, const auto& right){return left.score > right.score;});
-}   // MergeFrqTables()
-
-void CalcScore::CalcSession()
-{
-    m_maxGame = score::GetNumberOfGames();       // highest gamenr
-
-    svFrequencyInfo.clear();
-    svFrequencyInfo.resize(m_maxGame+1ULL);
-    svSessionResult.clear();
-    svSessionResult.resize(m_numberOfSessionPairs+1ULL);
-    svGameTops.resize(m_maxGame+1ULL);
-    if (m_bButler)
-    {
-        svDatumScores.resize(m_maxGame+1ULL);
-        svButlerFkw.clear();
-        svButlerFkw.resize(m_maxGame + 1ULL);
-    }
-    for (UINT game=1; game <= m_maxGame; ++game)            // calc all games
-    {
-        const auto NS_SCORE = true;
-        if (m_bButler)
-        {
-            CalcGameButler (game,  NS_SCORE);
-            CalcGameButler (game, !NS_SCORE);
-            CalcButlerFkw(game);
-        }
-        else
-        {
-            FS_INFO fsInfoEW;
-            CalcGamePercent(game,  NS_SCORE, svFrequencyInfo[game]);    // first scores for NS, add results to 'svSessionResult'
-            CalcGamePercent(game, !NS_SCORE, fsInfoEW);                 // then for EW
-            MergeFrqTables( svFrequencyInfo[game], fsInfoEW);           // merge ew to main table frequencyInfo
-        }
-    }
-
-    ApplySessionCorrections();
-    SaveSessionResults();
-    SaveGroupResult();
-    SaveFrequencyTable();
-    score::WriteSessionRank(svSessionRankToPair);
-    SaveSessionResultShort();
-    CalcClub(false);        // club-result for this session
-}   // CalcSession()
-
-void CalcScore::InitializeAndCalcScores()
-{
-    if (!ConfigChanged()) return;
-    names::InitializePairNames();                   // get all nameinfo
-    cor::InitializeCorrections();                   //   and needed corrections
-    spvGameSetData  = score::GetScoreData();        //      and scores
-    ValidateSessionCorrections(cor::GetCorrectionsSession());   // ouput in 'smCorSessionValidated'
-
-    CalcSession();
-    CalcTotal();
-}   // InitializeAndCalcScores()
-
-void CalcScore::CalcGamePercent(UINT game, bool bNs, FS_INFO& fsInfo)
-{
-    auto sets = (UINT)((*spvGameSetData)[game].size());
-    if (sets == 0) return;      // nothing to do, not played yet
-
-    UINT  adjustedScoreCount = 0;
-    std::vector<int> tmpScores;
-    for ( const auto& it : (*spvGameSetData)[game])
-    {
-        if (it.pairNS > m_numberOfSessionPairs || it.pairEW > m_numberOfSessionPairs)
-            continue;   // just ignore scores with a bad pair involved
-        if ( it.scoreNS == SCORE_NP || it.scoreEW == SCORE_NP )
-            continue;   // ignore explicitly non-played games!
-
-        int score = bNs ? it.scoreNS : it.scoreEW;
-        score = score::Score2Real(score);   //we only want/need real scores or %
-        tmpScores.push_back(score);
-        if (score::IsProcent(score))      // determine adjustedscore count
-            ++adjustedScoreCount;
-    }
-
-    std::ranges::sort(tmpScores, [](int a, int b){return a > b;});  // from high to low
-    UINT normalTop      = (sets-1)*2;
-    UINT top            = normalTop-adjustedScoreCount;
-    UINT neubergCount   = 0;
-    if (cfg::GetNeuberg())
-    {
-        neubergCount = sets-adjustedScoreCount;    // nr of comparable scores
-        top -= adjustedScoreCount;                 // == sets-1-adjustedScoreCount*2
-    }
-
-    if (bNs)
-        svGameTops[game].topNS = normalTop;
-    else
-        svGameTops[game].topEW = normalTop;
-
-    size_t maxIndex = tmpScores.size();
-    if ( maxIndex == 0 )
-        return;    // no scores ??, return to prevent outOfRange vector access
-    size_t index = 0;
-    do
-    {   // determine the different scores and there appearance count
-        int score = tmpScores[index++];
-        UINT equalCount = 1;
-        while (index < maxIndex && score == tmpScores[index] )
-        {
-            ++equalCount;
-            ++index;
-        }
-        FrequencyState fs;
-        fs.nrOfEqualScores = equalCount;
-        fs.score = score;
-        /*
-        * Till now all scores are 'normal' integers. To prevent calculation errors when using floatingpoint,
-        * we use from now on a special FixedDecimalPoint class (Fdp) that has a fixed number of fractional
-        * digits (for now 3). It behaves like a floating point type.
-        * All normal operations are available: conversion from/to string, * / + - and all comparison operators.
-        */
-        Fdp points;
-        if (score::IsProcent(score))
-        {
-            points = normalTop*Fdp::FromProcent(score::Procentscore2Procent(score));
-            if ( cfg::GetNeuberg() )
-                points = points.Round(1);   // round to .1
-            else
-                points = points.Round(0);   // round to 0 decimals
-        }
-        else
-        {
-            points=1LL+top-equalCount;
-            top-=equalCount*2;                              // new 'top'
-            if ( adjustedScoreCount && cfg::GetNeuberg() )  // recalc points with special formule
-                points = NeubergPoints(points, sets, neubergCount);
-        }
-
-        fs.points=points;
-        fs.pointsEW = 0;
-        fsInfo.push_back(fs);
-    } while (index  < maxIndex);
-
-    // now update scores for pairs
-
-    for ( const auto& it : (*spvGameSetData)[game])
-    {   // update totals for each pair that played this game
-        if (it.pairNS > m_numberOfSessionPairs || it.pairEW > m_numberOfSessionPairs)
-            continue;   // just ignore scores with a bad pair involved
-        UINT pair = bNs ? it.pairNS  : it.pairEW;
-        int score = bNs ? it.scoreNS : it.scoreEW;
-        score = score::Score2Real(score);   //we only want/need real scores or %
-        svSessionResult[pair].maxScore += normalTop;
-        svSessionResult[pair].nrOfGames++;
-        auto pScore = std::ranges::find_if(fsInfo, [score](const auto& it){return score == it.score;});
-        if ( pScore != fsInfo.end() ) // should always be the case....
-            svSessionResult[pair].points += pScore->points;
-    }
-}   // CalcGamePercent()
-
-void CalcScore::CalcGameButler(UINT a_game, bool a_bNs) const
-{
-    auto sets = (UINT)((*spvGameSetData)[a_game].size());
-    if (sets == 0) return;      // nothing to do, not played yet
-
-    std::vector<int> tmpScores;
-    for ( const auto& it : (*spvGameSetData)[a_game])
-    {
-        if (it.pairNS > m_numberOfSessionPairs || it.pairEW > m_numberOfSessionPairs)
-            continue;   // just ignore scores with a bad pair involved
-        if ( it.scoreNS == SCORE_NP || it.scoreEW == SCORE_NP )
-            continue;   // ignore explicitly non-played games!
-        int score = a_bNs ? it.scoreNS : it.scoreEW;
-        if (!score::IsProcent(score))
-        {   //we only want/need real scores, percent-scores will be converted to imps lateron
-            score = score::Score2Real(score);
-            tmpScores.push_back(score);
-        }
-    }
-    // sort the scores so we can easily remove N lowest and N highest scores
-    std::ranges::sort(tmpScores, [](int a, int b){return a > b;});  // from high to low
-
-    wxString log = FMT("butler: %s, game=%u, scoreCount=%u", a_bNs?"NS":"EW", a_game, (UINT)tmpScores.size());
-    if (tmpScores.size() > sButlerMinimumScores + 2)
-    {   // want at least 'sButlerMinimumScores' scores after removal of highest/lowest scores
-        // We ALWAYS round-up! So 10 scores -> 1, 11 -> 2 scores to remove
-        auto removeCount = (tmpScores.size()*sButlerRemoveScoresPercent+90)/100;
-        if (removeCount == 0) removeCount = 1;
-        log += FMT(", removeCount = %u", (UINT)removeCount);
-        for (; removeCount; --removeCount)
-        {
-            tmpScores.pop_back();
-            tmpScores.erase(tmpScores.begin());
-        }
-    }
-    // now determine datum-score
-    // int sumTest = std::accumulate(tmpScores.begin(), tmpScores.end(), 0);
-    auto count = static_cast<int>(tmpScores.size());
-    if ( count == 0 )
-        return;    // no scores ??, return to prevent outOfRange vector access or divide zero
-    int sum = 0;
-    for (auto it : tmpScores) sum += it;
-    int datumScore = sum/count; // remark: DON'T round here! -> 4.9 -> 4 -> 0 and not 4.9 -> 5 -> 10 as datum score!
-    datumScore = ((datumScore + ((datumScore<0)?-5:+5))/10)*10;   //round to nearest multiple of 10
-    log += FMT(", datumScore = %i", datumScore);
-//    MyLogDebug(log);
-    if (a_bNs)
-        svDatumScores[a_game].dsNS = datumScore;
-    else
-        svDatumScores[a_game].dsEW = datumScore;
-    // now determine the mps for all boards/players
-    for ( const auto& it : (*spvGameSetData)[a_game])
-    {
-        if (it.pairNS > m_numberOfSessionPairs || it.pairEW > m_numberOfSessionPairs)
-            continue;   // just ignore scores with a bad pair involved
-        auto pair = a_bNs ? it.pairNS  : it.pairEW;
-        auto score= a_bNs ? it.scoreNS : it.scoreEW;
-
-        svSessionResult[pair].butlerMp += ButlerGetMpsFromScore(score, datumScore); // %scores are handled in there
-        svSessionResult[pair].nrOfGames++;
-    }
-}   // CalcGameButler()
-
-static wxString DottedName(const wxString& a_name)
-{   // return string with size MAX_NAME_SIZE and a_name padded with " ."
-    char dots[]=" . . . . . . . . . . . . . . . . . . . . . . . . .";
-    size_t nLen = a_name.Len(); if (nLen >= cfg::MAX_NAME_SIZE) return a_name;
-    size_t dLen = sizeof(dots);
-    size_t neededChars = cfg::MAX_NAME_SIZE - nLen;
-    wxString dottedName = a_name+&dots[dLen-neededChars-1];
-    if (dottedName[nLen] == '.') dottedName[nLen] = ' ';
-    return dottedName;
-}   // DottedName()
-
 struct PlayerInfo
 {
     bool    bHasPlayed  = false;
@@ -649,1109 +403,17 @@ struct PlayerInfo
 
 bool GetPlayerInfo(UINT a_pair, UINT a_game, PlayerInfo& a_playerInfo)
 {   // get info for player/game of the current session
-    auto begin  = (*spvGameSetData)[a_game].begin();
-    auto end    = (*spvGameSetData)[a_game].end();
-    auto it     = std::find_if (begin, end,
-        [a_pair](const auto& setInfo){return setInfo.pairNS == a_pair || setInfo.pairEW == a_pair;});
-
-    if (it == end) return false;
+    const auto* pPairGame = ssReports.GetContext().FindPairGame(a_pair, a_game);
+    if (pPairGame == nullptr) return false;
+    const auto& setInfo = ssReports.GetContext().GetScoreData()[a_game][pPairGame->set];
     a_playerInfo.bHasPlayed = true;
-    bool bIsNS = it->pairNS == a_pair;
+    bool bIsNS = pPairGame->bNs;
     a_playerInfo.bIsNS      = bIsNS;
-    a_playerInfo.opponent   = bIsNS ? it->pairEW  : it->pairNS;
-    a_playerInfo.score      = bIsNS ? it->scoreNS : it->scoreEW;
+    a_playerInfo.opponent   = bIsNS ? setInfo.pairEW  : setInfo.pairNS;
+    a_playerInfo.score      = bIsNS ? setInfo.scoreNS : setInfo.scoreEW;
     return true;
 }   // GetPlayerInfo()
 
-static Fdp GetGameResultButler(UINT game, bool a_bNs, int a_score)
-{
-    int datumScore = a_bNs ? svDatumScores[game].dsNS : svDatumScores[game].dsEW;
-    Fdp gameResult = ButlerGetMpsFromScore(a_score, datumScore);
-    return gameResult;
-}   // GetGameResultButler()
-
-static Fdp GetGameResultPercent(UINT game, bool a_bNs, int a_score)
-{
-    Fdp gameResult;
-    int score = a_bNs ? a_score : score::ScoreEwToNs(a_score);
-    score = score::Score2Real(score);
-    auto end2 = svFrequencyInfo[game].end();
-    auto it2  = std::find_if(svFrequencyInfo[game].begin(), end2,
-        [score](const auto& info){return info.score == score;});
-    if (it2 != end2) gameResult = a_bNs ? it2->points : it2->pointsEW;
-    return gameResult;
-}   // GetGameResultPercent()
-
-Fdp CalcScore::GetSetResult(UINT pair, UINT firstGame, UINT nrOfGames, UINT* a_pGamesPlayed)
-{
-    Fdp setResult;
-
-    if (a_pGamesPlayed) *a_pGamesPlayed = 0;    // nr of games played for the requested count
-    for (UINT ii = 0; ii < nrOfGames; ++ii)
-    {
-        UINT game = firstGame+ii;
-        auto begin = (*spvGameSetData)[game].begin();
-        auto end   = (*spvGameSetData)[game].end();
-        auto it = std::find_if (begin, end,
-            [pair](const auto& setInfo){return setInfo.pairNS == pair || setInfo.pairEW == pair;});
-        if (it != end)
-        {   // pair has played game, so get its matchpoints
-            bool bNs  = it->pairNS == pair;
-            int score = bNs ? it->scoreNS : it->scoreEW;
-            setResult += m_bButler ? GetGameResultButler(game, bNs, score) : GetGameResultPercent(game, bNs, score);
-            if (a_pGamesPlayed) (*a_pGamesPlayed )++;
-        }
-    }
-    return setResult;
-}   // GetSetResult()
-
-void CalcScore::SaveGroupResult()
-{
-    UINT session            = cfg::GetActiveSession();
-    UINT setSize            = cfg::GetSetSize();
-    UINT sets               = cfg::GetNrOfGames()/setSize;
-    UINT offsetFirstGame    = cfg::GetFirstGame() - 1;
-
-    m_txtFileResultGroup.MyCreate(cfg::ConstructFilename(cfg::EXT_RESULT_GROUP), MyTextFile::WRITE);
-    m_txtFileResultGroup.AddLine(ES);
-
-    wxString tmp;
-    if (session) tmp.Printf(_(", session %u"), session);
-    tmp = FMT(_("Group-result of match '%s'%s"), cfg::GetDescription(),  tmp);
-    m_txtFileResultGroup.AddLine(tmp);
-    m_txtFileResultGroup.AddLine(ES);
-
-    const size_t SIZE_GRP_PAIR       (4);
-    const size_t SIZE_GRP_NAME       (cfg::MAX_NAME_SIZE);
-    const size_t SIZE_GRP_SCORE      (5);
-    const size_t SIZE_GRP_COMBI      (6);
-    const size_t SIZE_GRP_CORRECTION (6);
-    const size_t SIZE_GRP_GAMES      (7);
-    const size_t SIZE_GRP_TOTAL      (6);
-
-    #define GRP_INSERT_POS ((size_t)2)   /*start index to insert set-info*/
-    std::vector<FormBuilder::ColumnInfoRow> formInfo =
-        {
-              {SIZE_GRP_PAIR         , FormBuilder::Align::RIGHT       , ES, true}
-            , {SIZE_GRP_NAME         , FormBuilder::Align::LEFT        , ES, true}
-                // setinfo added later
-            , {SIZE_GRP_COMBI        , FormBuilder::Align::CENTER      , ES, sbHaveValidCombi}
-            , {SIZE_GRP_CORRECTION   , FormBuilder::Align::RIGHT_SPACE1, ES, sbHaveValidNormal}
-            , {SIZE_GRP_GAMES        , FormBuilder::Align::RIGHT_SPACE2, ES, true}
-            , {SIZE_GRP_TOTAL        , FormBuilder::Align::RIGHT       , ES, true}
-            , {SIZE_GRP_SCORE        , FormBuilder::Align::RIGHT       , ES, true}
-        };
-    FormBuilder::Align alignScore = m_bButler ? FormBuilder::Align::RIGHT : FormBuilder::Align::RIGHT_SPACE2;
-    std::vector<FormBuilder::ColumnInfoHeader> headerInfo =
-    {   // as it says: info for the header, columnsize is taken from the form-info
-          {FormBuilder::Align::RIGHT  , ES, ES          }
-        , {FormBuilder::Align::RIGHT  , ES, _("games") + " :"}
-            // setinfo added later
-        , {FormBuilder::Align::RIGHT  , ES, _("combi"  )}
-        , {FormBuilder::Align::RIGHT  , ES, _("corr."  )}
-        , {FormBuilder::Align::CENTER , ES, _("games"  )}
-        , {alignScore                 , ES, _("tot"    )}
-        , {FormBuilder::Align::LEFT   , ES, _("score"  )}
-    };
-
-    for (UINT ii = 0; ii < sets; ++ii)
-    {   // add set-info for form and header
-        wxString tmp2 = FMT("%u-%u", offsetFirstGame + setSize * ii + 1, offsetFirstGame + setSize * ii + setSize);
-        headerInfo.emplace(headerInfo.begin() + GRP_INSERT_POS + ii, FormBuilder::Align::CENTER, ES, tmp2);
-        formInfo  .emplace(formInfo  .begin() + GRP_INSERT_POS + ii, SIZE_GRP_SCORE, FormBuilder::Align::RIGHT, ES, true);
-////        headerInfo.insert(headerInfo.begin() + GRP_INSERT_POS + ii, {FormBuilder::Align::CENTER, ES, tmp2});
-////        formInfo  .insert(formInfo  .begin() + GRP_INSERT_POS + ii, {SIZE_GRP_SCORE, FormBuilder::Align::RIGHT, ES, true});
-    }
-
-    FormBuilder group(formInfo);
-    wxString tmp2 = group.CreateHeader(headerInfo);
-    tmp2 += " " + (m_bButler ? _("(imps/game)") : wxString("(%)"));
-    m_txtFileResultGroup.AddLine(tmp2);
-    for (UINT pair=1; pair <= m_maxPair; ++pair)
-    {
-        if (svSessionResult[pair].nrOfGames == 0)
-        {
-            if (cfg::IsSessionPairAbsent(pair))
-                tmp.Printf("%*s --> %s", (int)SIZE_GRP_PAIR, names::PairnrSession2SessionText(pair,true),  _("absent"));
-            else
-                tmp.Printf("%*s %s --> %s", (int)SIZE_GRP_PAIR, names::PairnrSession2SessionText(pair), names::PairnrSession2GlobalText(pair), _("NOT PLAYED"));  // ???? not possible if session ready!
-            m_txtFileResultGroup.AddLine(tmp);
-            continue;                   // pair didn't play
-        }
-        std::vector<wxString> rowInfo = {names::PairnrSession2SessionText(pair), DottedName(names::PairnrSession2GlobalText(pair))};
-
-        for (UINT ii = 0; ii < sets; ++ii)
-        {
-            UINT gamesPlayed = 0;
-            Fdp points = GetSetResult(pair, offsetFirstGame + setSize * ii + 1, setSize, &gamesPlayed);
-            if (gamesPlayed)    // if at least played once in this set, show score
-                rowInfo.push_back( points.AsString1E() );
-            else
-                rowInfo.emplace_back("-----");
-        }
-
-        wxString combi;
-        wxString correction;
-        GetSessionCorrectionStrings(pair, combi, correction);
-        rowInfo.push_back(combi);
-        rowInfo.push_back(correction);
-        rowInfo.push_back(U2String(svSessionResult[pair].nrOfGames));
-        rowInfo.push_back(m_bButler ? svSessionResult[pair].butlerMp.AsString() : svSessionResult[pair].points.AsString1E());
-        rowInfo.push_back(svSessionResult[pair].procentScore.AsString2F());
-        m_txtFileResultGroup.AddLine(group.CreateRow(rowInfo));
-    }
-
-    m_txtFileResultGroup.Flush();
-}   // SaveGroupResult()
-
-void CalcScore::SaveSessionResultsProcent()
-{
-    const size_t SIZE_RP_RANK        (4);
-    const size_t SIZE_RP_PAIR        (4);
-    const size_t SIZE_RP_NAME        (cfg::MAX_NAME_SIZE);
-    const size_t SIZE_RP_TOTAL       (6);
-    const size_t SIZE_RP_MAX         (5);
-    const size_t SIZE_RP_SCORE       (6);
-    const size_t SIZE_RP_COMBI       (6);
-    const size_t SIZE_RP_CORRECTION  (6);
-    const size_t SIZE_RP_GROUPRESULT (FormBuilder::NO_LIMIT);
-
-    std::vector<FormBuilder::ColumnInfoRow> formInfo =
-    {
-          {SIZE_RP_RANK       , FormBuilder::Align::RIGHT       , ES , true}
-        , {SIZE_RP_PAIR       , FormBuilder::Align::RIGHT       , ES , true}
-        , {SIZE_RP_NAME       , FormBuilder::Align::LEFT        , ES , true}
-        , {SIZE_RP_TOTAL      , FormBuilder::Align::RIGHT       , ES , true}
-        , {SIZE_RP_MAX        , FormBuilder::Align::RIGHT       , ES , true}
-        , {SIZE_RP_SCORE      , FormBuilder::Align::RIGHT       , '%', true}
-        , {SIZE_RP_COMBI      , FormBuilder::Align::CENTER      , ES , sbHaveValidCombi}
-        , {SIZE_RP_CORRECTION , FormBuilder::Align::RIGHT_SPACE1, ES , sbHaveValidNormal}
-        , {SIZE_RP_GROUPRESULT, FormBuilder::Align::LEFT        , ES , true}
-    };
-
-    std::vector<FormBuilder::ColumnInfoHeader> headerInfo =
-    {
-          {FormBuilder::Align::RIGHT , ES , _("rank"    )}
-        , {FormBuilder::Align::RIGHT , ES , _("pair"    )}
-        , {FormBuilder::Align::LEFT  , ES , _("pairname")}
-        , {FormBuilder::Align::CENTER, ES , _("tot."    )}
-        , {FormBuilder::Align::RIGHT , ES , _("max"     )}
-        , {FormBuilder::Align::RIGHT , ' ', _("score"   )}
-        , {FormBuilder::Align::RIGHT , ES , _("combi"   )}
-        , {FormBuilder::Align::RIGHT , ES , _("corr."   )}
-        , {FormBuilder::Align::LEFT  , ES , GetGroupResultString(0, &svSessionRankToPair, GROUPRESULT_SESSION)}
-    };
-
-    FormBuilder percentResult(formInfo);
-    wxString tmp = percentResult.CreateHeader(headerInfo);
-
-    m_txtFileResultSession.AddLine(tmp);m_txtFileResultOnName.AddLine(tmp);
-    auto startLine = (UINT)m_txtFileResultSession.GetLineCount();    //from here the pairinfo is addded
-    // pre-create empty lines for result on name-order
-    for (UINT lc = 1; lc <= m_maxPair;++lc) m_txtFileResultOnName.AddLine(ES);
-
-    for (UINT rank=1; rank < svSessionRankToPair.size(); ++rank)
-    {
-        UINT pair   = svSessionRankToPair[rank];
-        Fdp  score  = svSessionResult[pair].procentScore;
-        if (svSessionResult[pair].maxScore == 0)
-            continue;                   // pair didn't play
-
-        wxString combi;
-        wxString correction;
-        GetSessionCorrectionStrings(pair, combi, correction);
-        std::vector<wxString> rowInfo =
-        {
-              U2String(svSessionPairToRank[pair])
-            , names::PairnrSession2SessionText(pair)
-            , DottedName(names::PairnrSession2GlobalText(pair))
-            , svSessionResult[pair].points.AsString1E()
-            , U2String(svSessionResult[pair].maxScore)
-            , score.AsString2F()
-            , combi
-            , correction
-            , GetGroupResultString(pair)
-        };
-        tmp = percentResult.CreateRow(rowInfo);
-        m_txtFileResultSession.AddLine(tmp);                       // rank order
-        m_txtFileResultOnName[0 - 1ULL + pair + startLine] = tmp;  // pair order
-    }
-}   // SaveSessionResultsProcent()
-
-void CalcScore::SaveSessionResultsButler()
-{
-    const size_t SIZE_RI_RANK        (4);
-    const size_t SIZE_RI_PAIR        (4);
-    const size_t SIZE_RI_NAME        (cfg::MAX_NAME_SIZE);
-    const size_t SIZE_RI_IMPS        (4);
-    const size_t SIZE_RI_GAMES       (7);
-    const size_t SIZE_RI_SCORE       (6);
-    const size_t SIZE_RI_COMBI       (6);
-    const size_t SIZE_RI_CORRECTION  (6);
-    const size_t SIZE_RI_GROUPRESULT (FormBuilder::NO_LIMIT);
-
-    std::vector<FormBuilder::ColumnInfoRow> formInfo =
-    {   // column-size definition and info for all lines (except header)
-          {SIZE_RI_RANK       , FormBuilder::Align::RIGHT       , ES , true}
-        , {SIZE_RI_PAIR       , FormBuilder::Align::RIGHT       , ES , true}
-        , {SIZE_RI_NAME       , FormBuilder::Align::LEFT        , ES , true}
-        , {SIZE_RI_IMPS       , FormBuilder::Align::RIGHT       , ES , true}
-        , {SIZE_RI_GAMES      , FormBuilder::Align::RIGHT_SPACE2, ES , true}
-        , {SIZE_RI_SCORE      , FormBuilder::Align::RIGHT       , ES , true}
-        , {SIZE_RI_COMBI      , FormBuilder::Align::CENTER      , ES , sbHaveValidCombi}
-        , {SIZE_RI_CORRECTION , FormBuilder::Align::RIGHT_SPACE1, ES , sbHaveValidNormal}
-        , {SIZE_RI_GROUPRESULT, FormBuilder::Align::LEFT        , ES , true}
-    };
-
-    std::vector<FormBuilder::ColumnInfoHeader> headerInfo =
-    {   // as it says: info for the header, size is taken from the form-info
-          {FormBuilder::Align::RIGHT , ES , _("rank"    )}
-        , {FormBuilder::Align::RIGHT , ES , _("pair"    )}
-        , {FormBuilder::Align::LEFT  , ES , _("pairname")}
-        , {FormBuilder::Align::CENTER, ES , _("imps"    )}
-        , {FormBuilder::Align::RIGHT , ES , _("games"   )}
-        , {FormBuilder::Align::RIGHT , ES , _("score"   )}
-        , {FormBuilder::Align::RIGHT , ES , _("combi"   )}
-        , {FormBuilder::Align::RIGHT , ES , _("corr."   )}
-        , {FormBuilder::Align::LEFT  , ES , GetGroupResultString(0, &svSessionRankToPair, GROUPRESULT_SESSION)}
-    };
-
-    FormBuilder impsResult(formInfo);
-    wxString tmp = impsResult.CreateHeader(headerInfo);
-
-    m_txtFileResultSession.AddLine(tmp);m_txtFileResultOnName.AddLine(tmp);
-    auto startLine = m_txtFileResultSession.GetLineCount();    //from here the pairinfo is addded
-    // pre-create empty lines for result on name-order
-    for (UINT lc = 1; lc <= m_maxPair;++lc) m_txtFileResultOnName.AddLine(ES);
-
-    for (UINT rank=1; rank < svSessionRankToPair.size(); ++rank)
-    {
-        UINT pair   = svSessionRankToPair[rank];
-        Fdp  score  = svSessionResult[pair].mpPerGame;
-        if (svSessionResult[pair].nrOfGames == 0)
-            continue;                   // pair didn't play
-
-        wxString combi;
-        wxString correction;
-        GetSessionCorrectionStrings(pair, combi, correction);
-        std::vector<wxString> rowInfo =
-        {
-              U2String(svSessionPairToRank[pair])
-            , names::PairnrSession2SessionText(pair)
-            , DottedName(names::PairnrSession2GlobalText(pair))
-            , svSessionResult[pair].butlerMp.AsString()
-            , U2String(svSessionResult[pair].nrOfGames)
-            , score.AsString2F()
-            , combi
-            , correction
-            , GetGroupResultString(pair)
-        };
-        tmp = impsResult.CreateRow(rowInfo);
-
-        m_txtFileResultSession.AddLine(tmp);                       // rank order
-        m_txtFileResultOnName[0 - 1ULL + pair + startLine] = tmp;  // pair order
-    }
-}   // SaveSessionResultsButler()
-
-void CalcScore::SaveSessionResults()
-{
-    m_txtFileResultSession.MyCreate(cfg::ConstructFilename(cfg::EXT_RESULT_SESSION_RANK), MyTextFile::WRITE);
-    m_txtFileResultOnName .MyCreate(cfg::ConstructFilename(cfg::EXT_RESULT_SESSION_NAME), MyTextFile::WRITE);
-    AddHeader(m_txtFileResultSession);
-    AddHeader(m_txtFileResultOnName);
-    m_txtFileResultSession.AddLine(ES); m_txtFileResultOnName.AddLine(ES);
-
-    if (m_bButler)
-        SaveSessionResultsButler();
-    else
-        SaveSessionResultsProcent();
-
-    m_txtFileResultSession.Flush();        // write to disk
-    m_txtFileResultOnName.Flush();
-}   // SaveSessionResults()
-
-static Fdp NeubergPoints(const Fdp& points, UINT gameCount, UINT comparableCount)
-{   // https://www.bridgeservice.nl/NBB-rekenprogramma/Vraag%20&%20Antwoord%2003.pdf
-    //SN = (Sn + 1) * N/n - 1    // Sn=points, N=gameCount, n=comparableCount
-    Fdp tmp = ((points+1)*gameCount)/comparableCount - 1;
-    tmp.Round(1);   // TOODO: check if we need round/trunc for some values, see original function
-    return tmp;
-}   // NeubergPoints()
-
-#if 0
-long CalcScore::NeubergPoints(long points, UINT gameCount, UINT comparableCount)
-{   // https://www.bridgeservice.nl/NBB-rekenprogramma/Vraag%20&%20Antwoord%2003.pdf
-    //SN = (Sn + 1) * N/n - 1    // Sn=points, N=gamecCount, n=comparableCount
-    long nbpoints;
-    long temp;
-    // input 'points' are the 'real' points, return value = points*10: so 10.1 --> 101
-    switch (comparableCount)
-    {
-    case 2: // (points/10.0+1.1)*(gameCount-1);
-        nbpoints = (points+11L)*(gameCount-1);
-        break;
-    case 3: // (points/10.0+1.0)*(gameCount-1);
-        nbpoints = (points+10L)*(gameCount-1);
-        break;
-    default:// (points+1)*gameCount/comparable - 1;
-        temp = 100L*(points+1)*gameCount;
-        nbpoints = temp/comparableCount - 100L;
-        if ((temp % comparableCount) == 0)  //multiples!
-            if (((temp/comparableCount) % 10) == 5) // x.x5!!!
-                if (nbpoints > 100L*((long)gameCount-1)) //above medium
-                    nbpoints -= 5;  // ?.?5 --> ?.?0
-                                    //above medium: medium multiples of .05 get a cutoff!
-        nbpoints = (nbpoints+5)/10; //round to 1 digit after dp
-    }
-    return nbpoints;
-}   // NeubergPoints()
-#endif
-
-void CalcScore::ApplySessionCorrections(void)
-{
-    m_maxPair = 1;
-
-    for (UINT pair = 1; pair < svSessionResult.size(); ++pair)
-    {
-        if (svSessionResult[pair].nrOfGames == 0)  // valid for percent AND butler score
-            continue;    // pair did not play any game, so no corrections possible
-        if ( !m_bButler && svSessionResult[pair].maxScore == 0 )
-            continue;   // ??? will get divide by zero: not enough data present
-
-        Fdp     correctionProcent;
-        auto    it            = smCorSessionValidated.find(pair);
-        Fdp     butlerCorImps;  // corrections in imps for butler
-
-        m_maxPair = pair;
-        if (it != smCorSessionValidated.end())
-        {
-            cor::CORRECTION_SESSION cs = it->second;
-            // now handle the different types of correction
-            if (cs.correction)
-            {   // some correction in 'mp' or '% '
-                if (cs.type == '%')
-                {
-                    correctionProcent = cs.correction;
-                    //butlerCorImps = cs.correction*sButlerImpsPer10Procent;
-                }
-                else
-                {   // assume imps in % calculation. If butler, then .points is ignored...
-                    svSessionResult[pair].points += cs.correction;
-                    butlerCorImps = cs.correction;
-                }
-            }
-
-            if (cs.maxExtra)    // can ONLY be true, if no butler!
-            {   // from a combi-table, calculated separately!
-                UINT combiTop  = 2 * (GetNumberOfRounds(pair) - 1);
-                UINT normalTop = cfg::GetNrOfSessionPairs() - 2 - 2;
-                Fdp  extra     = ((normalTop*cs.extra)/combiTop).Round(1);
-                int  maxExtra  = RoundLong(normalTop * (long)cs.maxExtra, combiTop);    // CodeQL
-                svSessionResult[pair].points   += extra;
-                svSessionResult[pair].maxScore += maxExtra;
-            }
-            else
-                butlerCorImps += cs.extra;
-
-            svSessionResult[pair].nrOfGames += cs.games;
-        }   // end of correction calculation
-
-        //  now all corrections are handled: mp and combinationtables are in (max)points, the '%' waits in scoreProcent
-        if (m_bButler)
-        {
-            svSessionResult[pair].procentScore = // for now: too many things depend on it
-            svSessionResult[pair].mpPerGame = ((butlerCorImps + svSessionResult[pair].butlerMp)/ (int)svSessionResult[pair].nrOfGames).Round(2);
-            svSessionResult[pair].butlerMp += butlerCorImps;
-        }
-        else
-            svSessionResult[pair].procentScore = correctionProcent + ((100*svSessionResult[pair].points)/svSessionResult[pair].maxScore).Round(2);
-    }
-    m_maxPair = std::min(m_maxPair, m_numberOfSessionPairs);    // no more then we have active players!
-    svSessionRankToPair.resize(m_maxPair+1ULL);
-    std::iota (svSessionRankToPair.begin(), svSessionRankToPair.end(), 0); // Fill with 0, 1, ..., i.e. non-sorted! 0->0, 1->1 etc
-    std::sort(svSessionRankToPair.begin()+1, svSessionRankToPair.begin()+m_maxPair+1,
-        [](UINT left, UINT right){return svSessionResult[left].nrOfGames && svSessionResult[left].procentScore > svSessionResult[right].procentScore; });
-    UINT lastPair = svSessionRankToPair[m_maxPair];
-    if (svSessionResult[lastPair].nrOfGames == 0)
-        svSessionRankToPair[m_maxPair] = 0; // pair is absent, so no rank
-    InitPairToRankVector(true);
-}   // ApplySessionCorrections()
-
-void CalcScore::MakeFrequenceTable(UINT a_game, std::vector<wxString>& a_stringTable) const
-{
-    a_stringTable.clear();
-    wxString tmp;
-    tmp.Printf("%s %u", _("game"), a_game + cfg::GetFirstGame() - 1);
-    a_stringTable.push_back(tmp);
-    if (m_bButler)
-    {
-        a_stringTable.push_back(FMT("%s %s: %i, %s: %i", _("datumscore"), _("NS"), svDatumScores[a_game].dsNS, _("EW"), svDatumScores[a_game].dsEW));
-        // form definitions
-        const size_t SIZE_FT_SCORE  (5);
-        const size_t SIZE_FT_DELTA  (5);
-        const size_t SIZE_FT_IMPS   (4);
-
-        std::vector<FormBuilder::ColumnInfoRow> formInfo =
-        {   // column-size definition and info for all rows
-              {SIZE_FT_SCORE, FormBuilder::Align::RIGHT, ES , true}
-            , {SIZE_FT_DELTA, FormBuilder::Align::RIGHT, ES , true}
-            , {SIZE_FT_IMPS , FormBuilder::Align::RIGHT, ' ', true}
-            , {SIZE_FT_SCORE, FormBuilder::Align::RIGHT, ES , true}
-            , {SIZE_FT_DELTA, FormBuilder::Align::RIGHT, ES , true}
-            , {SIZE_FT_IMPS , FormBuilder::Align::RIGHT, ES , true}
-        };
-
-        std::vector<FormBuilder::ColumnInfoHeader> headerInfo =
-        {   // as it says: info for the header, columnsize is taken from the form-info
-              {FormBuilder::Align::RIGHT, ES , _("NS"   )}
-            , {FormBuilder::Align::RIGHT, ES , _("delta")}
-            , {FormBuilder::Align::RIGHT, ' ', _("imps" )}
-            , {FormBuilder::Align::RIGHT, ES , _("EW"   )}
-            , {FormBuilder::Align::RIGHT, ES , _("delta")}
-            , {FormBuilder::Align::RIGHT, ES , _("imps" )}
-        };
-
-        FormBuilder frequencyTable(formInfo);
-        tmp = frequencyTable.CreateHeader(headerInfo);
-        a_stringTable.push_back(tmp);
-        for (auto it = svButlerFkw[a_game].rbegin(); it != svButlerFkw[a_game].rend(); ++it)
-        {   //scores high to low overview
-            std::vector<wxString> rowInfo = {     score::ScoreToString(it->second.scoreNs)
-                                                , L2String(it->second.deltaNs)
-                                                , I2String(it->second.impsNs)
-                                                , score::ScoreToString(it->second.scoreEw)
-                                                , L2String(it->second.deltaEw)
-                                                , I2String(it->second.impsEw)
-                                            };
-            a_stringTable.push_back(frequencyTable.CreateRow(rowInfo));
-        }
-    }
-    else
-    {
-        // form definitions
-        const size_t SIZE_FT_SCORE  (7);
-        const size_t SIZE_FT_MP     (5);
-
-        std::vector<FormBuilder::ColumnInfoRow> formInfo =
-        {   // column-size definition and info for all rows
-              {SIZE_FT_SCORE, FormBuilder::Align::RIGHT, ES, true}
-            , {SIZE_FT_MP   , FormBuilder::Align::RIGHT, ES, true}
-            , {SIZE_FT_MP   , FormBuilder::Align::RIGHT, ES, true}
-        };
-
-        std::vector<FormBuilder::ColumnInfoHeader> headerInfo =
-        {   // as it says: info for the header, columnsize is taken from the form-info
-              {FormBuilder::Align::RIGHT , ES, _("scoreNS")}
-            , {FormBuilder::Align::CENTER, ES, _("NS"     )}
-            , {FormBuilder::Align::CENTER, ES, _("EW"     )}
-        };
-
-        FormBuilder frequencyTable(formInfo);
-        a_stringTable.push_back(frequencyTable.CreateHeader(headerInfo));
-        std::vector<wxString> rowInfo = { _("top:"), U2String(svGameTops[a_game].topNS)+"  ", U2String(svGameTops[a_game].topEW)+"  "};
-        a_stringTable.push_back(frequencyTable.CreateRow(rowInfo));
-
-        const auto& frqInfo = svFrequencyInfo[a_game];
-        for (const auto& it : frqInfo)
-        {
-            rowInfo = {score::ScoreToString(it.score), it.points.AsString1E(), it.pointsEW.AsString1E()};
-            a_stringTable.push_back(frequencyTable.CreateRow(rowInfo));
-        }
-    }
-}   // MakeFrequenceTable()
-
-void CalcScore::SaveFrequencyTable()
-{
-    UINT maxGame = score::GetNumberOfGames();
-    svFrqstringTable.clear();
-    svFrqstringTable.resize(maxGame+1ULL);
-    std::vector<size_t> tableSize;  // the size of each frq table
-    tableSize.resize(maxGame+1ULL);
-
-    for (UINT game = 1; game <= maxGame; ++game)
-    {   // fkw per game
-        MakeFrequenceTable(game, svFrqstringTable[game]);
-        tableSize[game] = svFrqstringTable[game].size();
-    }
-
-    m_txtFileFrqTable.MyCreate(cfg::ConstructFilename(cfg::EXT_FKW), MyTextFile::WRITE);
-    AddHeader(m_txtFileFrqTable);
-    size_t linesOnPage          = m_txtFileFrqTable.GetLineCount();
-    const UINT suFrqStringSize  = m_bButler ? 40 : 19;  // size of each line in a frq table
-    const UINT suNrOfFrqColumns = m_bButler ?  2 :  4;  // number of frq tables next to eachother
-
-    // now add all tables in 'suNrOfFrqColumns' columns
-    for (UINT game = 1; game <= maxGame; game += suNrOfFrqColumns)
-    {
-        size_t maxLines = 0;
-        for (UINT ii = 0; ii < suNrOfFrqColumns && game + ii <= maxGame; ++ii)
-        {
-            maxLines = std::max(maxLines,tableSize[static_cast<size_t>(game)+ii]);
-        }
-
-        if (linesOnPage + 2ULL + maxLines > cfg::GetLinesPerPage())
-        {   // doesn't fit on current page, so give a formfeed ('\f')
-            m_txtFileFrqTable.AddLine('\f');
-            linesOnPage = 0;
-        }
-        linesOnPage += 2ULL + maxLines;
-        m_txtFileFrqTable.AddLine(ES); m_txtFileFrqTable.AddLine(ES);
-        for (size_t line = 0; line < maxLines; ++line)
-        {
-            wxString tmp;
-            for (UINT ii = 0; ii < suNrOfFrqColumns && game + ii <= maxGame; ++ii)
-            {
-//                tmp += line < tableSize[0ULL+game+ii] ? svFrqstringTable[0ULL+game+ii][line] : wxString('.',suFrqStringSize);
-                tmp += FMT("%-*s", suFrqStringSize,  (line < tableSize[0ULL+game+ii]) ? svFrqstringTable[0ULL + game + ii][line] : ES);
-            }
-            m_txtFileFrqTable.AddLine(tmp);
-        }
-
-    }
-    m_txtFileFrqTable.Flush();
-}   // SaveFrequencyTable()
-
-static void AddHeader(MyTextFile& a_file)
-{
-    a_file.AddLine('\'' + cfg::GetDescription() + '\'');
-
-    wxString tmp;
-    if (cfg::GetActiveSession() >= 1)
-        tmp.Printf(_("result of session %u"), cfg::GetActiveSession());
-    else
-        tmp = _("result");
-    a_file.AddLine(tmp);
-}   // AddHeader()
-
-void CalcScore::SaveSessionResultShort()
-{
-    if (cfg::GetActiveSession()==0)
-        return;         // 0 ==> stand-alone session: this data would only be used in next session!
-
-    cor::mCorrectionsEnd mce;    // transform data to write into same format as its being read
-    for (UINT pair = 1; pair < svSessionResult.size(); ++pair)          // save score of all pairs
-    {
-        if (svSessionResult[pair].nrOfGames != 0)                       // check if pair has played
-        {   // pair has played
-            auto globalPair = names::PairnrSession2GlobalPairnr(pair);
-            if (globalPair == 0)
-            {   // can't store this result (for possible use in next session), because we do not know to whom it belongs...
-                // remark: no scoring-data lost!
-                wxString infoMsg = wxString::Format(_("Pair '%s' has played, but was NOT assigned to a global name"), names::PairnrSession2SessionText(pair));
-                MyLogError("%s", infoMsg);  // log as error!
-                CallAfter([infoMsg] {MyMessageBox(infoMsg, _("Warning")); });
-                continue;
-            }
-            cor::CORRECTION_END ce;
-            ce.score = svSessionResult[pair].procentScore;
-            ce.games = svSessionResult[pair].nrOfGames;
-            mce[globalPair] = ce;           // need global pairnr!
-        }
-    }
-
-    io::SessionResultWrite(mce, cfg::GetActiveSession());
-}   // SaveSessionResultShort()
-
-static Fdp GetResultScore(UINT a_sessionPairnr, bool a_bSession)
-{   // just for use in GetGroupResultString() to find equal scores (and so ranks)
-    if (a_bSession) return svSessionResult[a_sessionPairnr].procentScore;
-    return svTotalResult[names::PairnrSession2GlobalPairnr(a_sessionPairnr)].totalN;
-}   // GetResultScore()
-
-wxString CalcScore::GetGroupResultString(UINT a_sessionPair, const std::vector<UINT>* a_pRankIndex, bool a_bSession) const
-{
-    // on init: 3 chars per group, empty if only one group:  " BL YE RE GR" for group BLue YEllow REd and GReen
-    // for a pair: the rank in its group, a '.' if none   :  "  .  .  7  ." for pair being rank 7 in group 'RE'
-    static std::vector<UINT> svGroupRank;   // rank within group for sessionPair
-    const auto& groupInfo  = *cfg::GetGroupData();
-
-    if ( groupInfo.size() <= 1 || !cfg::GetGroupResult() ) return ES;   // if only 1 group, or cfg says no grp-info, then ES
-
-    wxString result;
-    if (a_pRankIndex != nullptr)
-    {   // init of data: get string of all group characters and init svGroupRank
-        svGroupRank.clear();
-        svGroupRank.resize(a_pRankIndex->size(), 0);
-        for (const auto& itGroup : groupInfo)
-        {
-            auto minPair = itGroup.groupOffset;
-            auto maxPair = minPair + itGroup.pairs;
-            for (auto pair = minPair+1 ; pair <= maxPair; ++pair )  // so these are session-pairnumbers!
-            {   // determine rank in group
-                UINT rank           = 1;
-                UINT groupRank      = 1;
-                Fdp  previousScore  = -1;
-                for (auto rankPair : *a_pRankIndex)
-                {
-                    Fdp score = GetResultScore(rankPair, a_bSession);
-                    if (score != previousScore) groupRank = rank;    // check for equal scores-->equal rank
-                    previousScore = score;
-                    if (rankPair == pair)
-                    {
-                        svGroupRank[pair] = groupRank;   // rank within group
-                        break;
-                    }
-                    if (rankPair > minPair && rankPair <= maxPair)
-                    {
-                        ++rank;     // pair in same group with higher ranking, so rank for current pair is incremented
-                    }
-                }
-            }
-        }
-        // also init the group-string
-        for (const auto& it : groupInfo) {result += FMT("%3s", it.groupChars);}
-        return result;  // " BL GR YE OR" : 3 chars per group
-    }
-
-    // create string showing rank within group:  "  .  .  5  .  ." --> 3 chars per group: rank or "  ."
-    for (const auto& itGroup : groupInfo)
-    {
-        auto minPair = itGroup.groupOffset;
-        auto maxPair = minPair + itGroup.pairs;
-        result += ( (a_sessionPair > minPair) && (a_sessionPair <= maxPair) ) ?
-            FMT("%3u", svGroupRank[a_sessionPair]) : wxString("  .");
-    }
-
-    return result;
-}   // GetGroupResultString()
-
-static void CalcTotalSub(ScoreInfo& a_pairResult, UINT a_absentCount, bool& a_bBonus)
-{   // CalcTotal() helper: calc real totals and averages
-    auto  sessionCount = a_pairResult.nrOfSessions;
-    a_pairResult.avgW.Round(2);     // need 2 decimals, else we could get differences when 
-    a_pairResult.avgN.Round(2);     //  multiplied by 2 or more (a_absentCount or sessioncount)
-
-    if ( a_absentCount != 0 )
-    {   // correct average/total if not always present
-        auto  presentCount  = sessionCount-a_absentCount;
-        const auto MAX_MEAN = cfg::GetMaxMean();
-
-        // Weighted stuf : *W
-        if ( a_pairResult.avgW > MAX_MEAN )
-        {
-            a_pairResult.avgAbsentW = MAX_MEAN;
-            a_pairResult.totalW     = a_pairResult.avgW*presentCount + MAX_MEAN*a_absentCount;
-            a_pairResult.avgW       = a_pairResult.totalW/sessionCount;
-        }
-        else
-        {
-            a_pairResult.avgAbsentW = a_pairResult.avgW;
-            a_pairResult.totalW     = a_pairResult.avgW*sessionCount;
-        }
-
-        // Normal/non-weighted stuf
-        if ( a_pairResult.avgN > MAX_MEAN ) // too big: take max average
-        {
-            a_pairResult.avgAbsentN = MAX_MEAN;
-            a_pairResult.totalN    += MAX_MEAN*a_absentCount;
-            a_pairResult.avgN       = a_pairResult.totalN/sessionCount;
-        }
-        else
-        {
-            a_pairResult.avgAbsentN = a_pairResult.avgN;
-            a_pairResult.totalN    += a_pairResult.avgN*a_absentCount;
-        }
-    }   // end of not always present
-    else
-    {   // always present
-        //a_pairResult.totalN; this is already correct, so do nothing
-        a_pairResult.totalW     = a_pairResult.avgW*sessionCount;
-        a_pairResult.avgAbsentW = a_pairResult.avgW;    // not used anymore, but nice to have an overview
-        a_pairResult.avgAbsentN = a_pairResult.avgN;    // not used anymore, but nice to have an overview
-    }
-
-    if ( a_pairResult.bonus )
-    {   // adjust total and running average
-        a_pairResult.totalN  += a_pairResult.bonus;
-        a_pairResult.avgN     = a_pairResult.totalN/a_pairResult.nrOfSessions;
-        a_pairResult.totalW  += a_pairResult.bonus;
-        a_pairResult.avgW     = a_pairResult.totalW/a_pairResult.nrOfSessions;
-        a_bBonus              = true;
-    }
-    else
-        a_bBonus = false;
-}   // CalcTotalSub()
-
-void CalcScore::CalcTotal()
-{
-    UINT maxSession = cfg::GetActiveSession();
-    if (maxSession == 0) return;       // no total result: session result == end result
-
-    UINT globalPairs = names::GetNumberOfGlobalPairs();
-    if (globalPairs == 0)
-    {
-        if (!m_bIsScriptTesting)
-            MyMessageBox(_("No names entered yet!"));
-        return;  // no names yet
-    }
-    std::vector<cor::mCorrectionsEnd> sessionResults;       // corrections have same data as session-results
-    sessionResults.resize(maxSession+1ULL);
-    std::vector<UINT> gamesPerSession(maxSession+1ULL,0U);  // max games in a session, needed for average calculation
-    for (UINT session = 1; session <= maxSession; ++session)
-    {
-        cor::CORRECTION_END ce; // preset pairnr's
-        for (UINT pair = 0; pair <= globalPairs; ++pair) sessionResults[session][pair] = ce;
-        //load session result
-        (void)io::SessionResultRead(sessionResults[session], session);
-        for ( auto const& it : sessionResults[session] )
-        {   // determine max number of games played in this session
-            if ( gamesPerSession[session] < it.second.games )
-                gamesPerSession[session] = it.second.games;
-        }
-        //append end-corrections
-        // get validated end-corrections for this session
-        cor::mCorrectionsEnd correctionsEnd;
-        GetValidatedEndCorrections4Session(correctionsEnd, session);
-        (void)io::CorrectionsEndRead(sessionResults[session], session, false);
-    }
-
-    svTotalResult.clear();
-    svTotalResult.resize(globalPairs+1ULL);
-    bool bBonus4Display = false;
-    for (UINT pair=1; pair <= globalPairs; ++pair)   // calc total+average
-    {
-        UINT absentCount     = 0;
-        UINT noSessionCount  = 0;   // nr of times the session score is not added to end/total count (== endcorrection)
-        auto& pairResult     = svTotalResult[pair];
-        pairResult.nrOfSessions = maxSession;  // assume all played sessions account to end/total result
-        for (UINT session=1;session <= maxSession;++session)
-        {
-            Fdp score = sessionResults[session][pair].score;
-            if (score == SCORE_NO_TOTAL)
-            {
-                ++noSessionCount;
-                --pairResult.nrOfSessions;
-                continue;
-            }
-            if (sessionResults[session][pair].games == 0)
-                ++absentCount;
-            else
-            {
-                pairResult.activeSessions++;    // one more active session for this pair
-                pairResult.bHasPlayed = true;   // at least played once in all sessions
-                UINT games = sessionResults[session][pair].games;
-                if ( gamesPerSession[session] != games )    // not played all games, so weighted avg can/will be different
-                    pairResult.bWeightedAvg = true;
-                pairResult.totalN           += score;
-                pairResult.avgN              = pairResult.totalN/pairResult.activeSessions;
-                pairResult.totalGameScoreW  += games*score;
-                pairResult.gameCount        += games;
-                pairResult.avgW              = pairResult.totalGameScoreW/pairResult.gameCount;
-            }
-            pairResult.bonus += sessionResults[session][pair].bonus;
-        }   // end session handling
-
-        if ( absentCount > cfg::GetMaxAbsent() || absentCount == maxSession || pairResult.gameCount == 0 )
-        {   // if too often or always absent, don't rank pair
-            pairResult.totalN        = 0;
-            pairResult.avgN          = 0;
-            pairResult.avgAbsentN    = 0;
-            pairResult.totalW        = 0;
-            pairResult.avgW          = 0;
-            pairResult.avgAbsentW    = 0;
-            pairResult.bNoTotal      = true;
-            continue;
-        }
-
-        CalcTotalSub(pairResult, absentCount, bBonus4Display);  // do the magic
-    }   // end for all pairs
-
-    bool bWeightedAvg = cfg::GetWeightedAvg();
-    svTotalRankToPair.resize(globalPairs+1ULL);
-    std::iota(svTotalRankToPair.begin(), svTotalRankToPair.end(), 0);   // fill with 0,1,2,3....
-    if ( bWeightedAvg ) 
-        std::sort(svTotalRankToPair.begin()+1, svTotalRankToPair.end(),
-            [](auto left, auto right){return svTotalResult[left].bHasPlayed && svTotalResult[left].totalW > svTotalResult[right].totalW;} );
-    else
-        std::sort(svTotalRankToPair.begin()+1, svTotalRankToPair.end(), 
-            [](auto left, auto right){return svTotalResult[left].bHasPlayed && svTotalResult[left].totalN > svTotalResult[right].totalN;} );
-
-    for (auto it = svTotalRankToPair.rbegin(); it != svTotalRankToPair.rend(); ++it)
-    {
-        if (svTotalResult[*it].bHasPlayed) break;   // from here on, all pairs have played
-        *it = 0;    // set pair-id to 0 if pair has not played yet, so has no rank yet
-    }
-
-    InitPairToRankVector(false);
-
-    std::vector<UINT> indexSessionPairnr;    // index with session pairnrs in it for getting group-string if wanted
-    indexSessionPairnr.resize(svTotalRankToPair.size());
-    for ( UINT ii = 1; ii < indexSessionPairnr.size(); ++ii)
-    {
-        indexSessionPairnr[ii] = names::PairnrGlobal2SessionPairnr(svTotalRankToPair[ii]);
-    }
-    indexSessionPairnr[0] = 0;
-
-    m_txtFileResultTotal.MyCreate(cfg::ConstructFilename(cfg::EXT_RESULT_TOTAL), MyTextFile::WRITE);
-    m_txtFileResultTotal.AddLine(cfg::GetDescription());
-    m_txtFileResultTotal.AddLine(FMT(_("Final result%s"), bWeightedAvg ? _(" (weighted average)") : ES));
-    m_txtFileResultTotal.AddLine(ES);
-
-    // form definitions
-    const size_t SIZE_RT_RANK        (4);
-    const size_t SIZE_RT_NAME        (cfg::MAX_NAME_SIZE);
-    const size_t SIZE_RT_SESSION     (5);
-    const size_t SIZE_RT_BONUS       (7);
-    const size_t SIZE_RT_TOTAL       (7);
-    const size_t SIZE_RT_AVG         (5);
-    const size_t SIZE_RI_SCORE       (6);
-    const size_t SIZE_RT_CORRECTION  (5);
-    const size_t SIZE_RT_GROUPRESULT (FormBuilder::NO_LIMIT);
-
-    #define RT_INSERT_POS ((size_t)2)   /*start index to insert session info*/
-    std::vector<FormBuilder::ColumnInfoRow> formInfo =
-    {   // column-size definition and info for all rows
-          {SIZE_RT_RANK       , FormBuilder::Align::RIGHT, ES , true}
-        , {SIZE_RT_NAME       , FormBuilder::Align::LEFT , ' ', true}
-        // session info added later
-        , {SIZE_RT_BONUS      , FormBuilder::Align::RIGHT, ES , bBonus4Display}
-        , {SIZE_RT_TOTAL      , FormBuilder::Align::RIGHT, ES , true}
-        , {SIZE_RT_AVG        , FormBuilder::Align::RIGHT, ES , true}
-        , {SIZE_RT_GROUPRESULT, FormBuilder::Align::LEFT , ES , true}
-    };
-
-    std::vector<FormBuilder::ColumnInfoHeader> headerInfo =
-    {   // as it says: info for the header, columnsize is taken from the form-info
-          {FormBuilder::Align::LEFT , ES , _("rank"    )}
-        , {FormBuilder::Align::LEFT , ' ', _("pairname")}
-        // session info added later
-        , {FormBuilder::Align::RIGHT, ES , _("bonus"   )}      //xgettext:TRANSLATORS: "total", translation max length = 7
-        , {FormBuilder::Align::RIGHT, ES , _("total"   )}      //xgettext:TRANSLATORS: "avg.", translation max length = 5
-        , {FormBuilder::Align::RIGHT, ES , _("avg."    )}
-        , {FormBuilder::Align::LEFT , ES , GetGroupResultString(0, &indexSessionPairnr, GROUPRESULT_FINAL)}
-    };
-
-    for (UINT session=1; session <= maxSession; ++session)
-    {
-        formInfo  .emplace(formInfo.begin()   + RT_INSERT_POS + session - 1, SIZE_RT_SESSION, FormBuilder::Align::RIGHT, ES, true);
-        //xgettext:TRANSLATORS: 'S' is first character of 'Session'
-        headerInfo.emplace(headerInfo.begin() + RT_INSERT_POS + session - 1, FormBuilder::Align::CENTER, ' ', FMT(_("S%u"), session));
-    }
-
-    FormBuilder totalResult(formInfo);
-    wxString tmp = totalResult.CreateHeader(headerInfo);
-    m_txtFileResultTotal.AddLine(tmp);
-
-    for (UINT rank = 1; rank < svTotalRankToPair.size(); ++rank)
-    {
-        UINT pair       = svTotalRankToPair[rank];
-        if (!svTotalResult[pair].bHasPlayed)
-            break;  // all global players that have not played yet, should be at end of rank-array!
-        Fdp totalScore  = bWeightedAvg ? svTotalResult[pair].totalW : svTotalResult[pair].totalN;
-        Fdp average     = bWeightedAvg ? svTotalResult[pair].avgW   : svTotalResult[pair].avgN;
-        std::vector<wxString> rowInfo = {U2String(svTotalPairToRank[pair]), DottedName(names::PairnrGlobal2GlobalText(pair))};
-
-        wxString averageAbsent = (bWeightedAvg ? svTotalResult[pair].avgAbsentW : svTotalResult[pair].avgAbsentN).AsString2F();
-        for (UINT session=1; session <= maxSession; ++session)
-        {
-            char extra = ' ';
-            Fdp score = sessionResults[session][pair].score;
-            if ( score == SCORE_NO_TOTAL )
-                rowInfo.emplace_back("-----");
-            else if (sessionResults[session][pair].games == 0)
-            {
-                rowInfo.push_back(averageAbsent);
-                extra = 'a';
-            }
-            else
-                rowInfo.push_back(score.AsString2F());
-
-            formInfo[RT_INSERT_POS + session - 1].extra = extra;
-        }
-        wxString bonusString;
-        if ( svTotalResult[pair].bonus )    // yes, this pair has a bonus!
-            bonusString = svTotalResult[pair].bonus.AsString2F();
-        rowInfo.push_back(bonusString);
-        wxString totalString = totalScore.AsString2F();
-        if ( bWeightedAvg )
-        {   // some pairs did have non-playing table(s)
-            if (svTotalResult[pair].bWeightedAvg)
-                totalString += '+';     // this pair did have non-playing table(s)
-            else
-                totalString += ' ';
-        }
-        rowInfo.push_back(totalString);
-        rowInfo.push_back(average.AsString2F());
-        rowInfo.push_back(svTotalResult[pair].bNoTotal ? ES : GetGroupResultString(names::PairnrGlobal2SessionPairnr(pair)));
-        tmp = totalResult.CreateRow(rowInfo);
-        m_txtFileResultTotal.AddLine(tmp);
-    }   // end for all ranks
-
-    m_txtFileResultTotal.Flush();
-    score::WriteTotalRank(svTotalRankToPair);  // rankorder for support of pair-assignments in next session
-    CalcClub(true);
-}   // CalcTotal()
-
-struct CLUB_DATA
-{
-    Fdp     score;              // accumulated (session) scores, up to max nr of allowed pairs
-    Fdp     totalScore;         // accumulated scores for all pairs
-    UINT    clubCount   = 0;    // nr of pairs playing for this club
-    UINT    clubId      = 0;    // the id of the club, from name-info
-    Fdp     average;            // average of upto cfg::GetMaxClubcount() pairs;
-};
-
-static bool CompareClubs(const CLUB_DATA& left, const CLUB_DATA& right)
-{   // compare function for sorting the club-results
-    UINT state = 0;
-    if (left.clubCount >= cfg::GetMinClubcount())
-        state  = 1;
-    if (right.clubCount >= cfg::GetMinClubcount())
-        state |= 2;
-    switch (state)
-    {
-        case 1: return true;    // left  within limits, right not: so left  is larger!
-        case 2: return false;   // right within limits, left  not: so right is larger!
-        case 3:                 // both within limits, so simply compare (inrange) averages (== scores)
-            // comparing averages is much more 'fair' then scores/totals: more pairs are favored!
-            return left.average > right.average;    // return left.score > right.score;
-        default:                // both NOT within limits, compare averages (totalscores)
-            return left.average > right.average;    //return left.totalScore > right.totalScore;
-    }
-}   // CompareClubs()
-
-void CalcScore::CalcClub( bool a_bTotal)
-{   // results for clubs, if you have assigned pairnames to a club
-    UINT                maxClubIndex= 0;
-    std::vector<UINT>&  rankToPair  = a_bTotal ? svTotalRankToPair       : svSessionRankToPair;
-    MyTextFile&         txtFile     = a_bTotal ? m_txtFileResultClubTotal : m_txtFileResultClubSession;
-    UINT                session     = cfg::GetActiveSession();
-    UINT                maxSession  = a_bTotal ? session : 1;
-    wxString            header      = a_bTotal ? _("Final result") : session ? FMT(_("Result of session %u"), session): _("Session result");
-    wxString            fileName    = cfg::ConstructFilename(a_bTotal ? cfg::EXT_CLUB_TOTAL : cfg::EXT_SESSION_CLUB);
-
-    std::vector<CLUB_DATA> club;
-    club.resize(cfg::MAX_CLUBNAMES+1ULL);
-
-    UINT maxClubCount = cfg::GetMaxClubcount();
-    UINT minClubCount = cfg::GetMinClubcount();
-    for (UINT rank = 1; rank < rankToPair.size(); ++rank)   // sum first N scores per club
-    {
-        UINT pair = rankToPair[rank];
-        if (pair)                                           // a pair that has played
-        {
-            // for total, use sum of session-results for better accuracy
-            // like: (x.01+x.00)/2 = x.01   and (x.01+x.01)/2=x.01, but its 'more'!
-            Fdp score = a_bTotal ? svTotalResult[pair].totalN : svSessionResult[pair].procentScore;                 // score bepalen
-            if (score)
-            {
-                if (!a_bTotal) pair = names::PairnrSession2GlobalPairnr(pair);
-                UINT clubId =  names::GetGlobalPairInfo(pair).clubIndex;         // club-id
-                if (clubId > maxClubIndex)
-                    maxClubIndex = clubId;
-                if (club[clubId].clubCount < maxClubCount)
-                {
-                    club[clubId].score += score;        // sum allowable scores
-                    club[clubId].clubId = clubId;       // and remember its id
-                    // only use 'average' for sorting: arbitrairy *100, so we have 2 extra significant digits
-                    club[clubId].average= (100*club[clubId].score)/(int)(1+club[clubId].clubCount);
-                }
-                club[clubId].totalScore += score;       // sum ALL scores
-                club[clubId].clubCount++;               // and adjust clubCount
-            }
-        }
-    }
-    // now we have all scores
-    if (maxClubIndex == 0) return;      // without clubs, no clubresults!
-
-    std::sort(club.begin()+1, club.begin()+maxClubIndex+1, CompareClubs);
-    txtFile.MyCreate(fileName, MyTextFile::WRITE);
-    txtFile.AddLine(ES);
-
-    wxString tmp = FMT(_("%s of the clubs for '%s'"), header, cfg::GetDescription());
-    txtFile.AddLine(tmp);
-
-    tmp = FMT(_("minimum number of pairs : %u"),minClubCount);
-    txtFile.AddLine(tmp);
-
-    tmp = FMT(_("maxsimum number of pairs: %u"),maxClubCount);
-    txtFile.AddLine(tmp);
-    txtFile.AddLine(m_bButler ? _("Scores are in imps, results and average in imps/pair") : _("Scores, results and average are in %"));
-    txtFile.AddLine(ES);
-
-    const size_t SIZE_CR_RANK        (4);
-    const size_t SIZE_CR_COUNT       (6);
-    const size_t SIZE_CR_CLUB        (cfg::MAX_CLUB_SIZE);
-    const size_t SIZE_CR_SCORE       (7);
-    const size_t SIZE_CR_AVG         (5);
-    const size_t SIZE_CR_TOTAL       (FormBuilder::NO_LIMIT);
-
-
-    std::vector<FormBuilder::ColumnInfoRow> formInfo =
-    {
-          {SIZE_CR_RANK , FormBuilder::Align::RIGHT_SPACE1, ES, true}
-        , {SIZE_CR_COUNT, FormBuilder::Align::RIGHT_SPACE2, ES, true}
-        , {SIZE_CR_CLUB , FormBuilder::Align::LEFT        , ES, true}
-        , {SIZE_CR_SCORE, FormBuilder::Align::RIGHT       , ES, true}
-        , {SIZE_CR_AVG  , FormBuilder::Align::RIGHT       , ES, true}
-        , {SIZE_CR_TOTAL, FormBuilder::Align::RIGHT       , ES, true}
-    };
-
-    std::vector<FormBuilder::ColumnInfoHeader> headerInfo =
-    {   // as it says: info for the header, columnsize is taken from the form-info
-          {FormBuilder::Align::RIGHT, ES , _("rank"      )}
-        , {FormBuilder::Align::RIGHT, ES , _("count"     )}
-        , {FormBuilder::Align::LEFT , ES , _("club-name" )}
-        , {FormBuilder::Align::RIGHT, ES , _("score"     )}
-        , {FormBuilder::Align::RIGHT, ' ', _("avg."      )}
-        , {FormBuilder::Align::LEFT , ES , _("totalscore")}
-    };
-
-    FormBuilder clubResult(formInfo);
-    wxString tmp2 = clubResult.CreateHeader(headerInfo);
-
-    txtFile.AddLine(tmp2);
-
-
-    UINT rank               = 1;
-    UINT actualRank         = 1;
-    Fdp  previousAvgScore   = 99999;    // just some impossible score..
-
-    for (UINT clubIndex = 1; clubIndex <= maxClubIndex; ++clubIndex)
-    {
-        UINT clubCount = club[clubIndex].clubCount;
-        if (clubCount == 0) continue;      // this club was not present in match
-
-        if (clubCount > maxClubCount)
-            clubCount = maxClubCount;
-        Fdp avgScore = club[clubIndex].score/(clubCount * maxSession);
-        if (avgScore != previousAvgScore)
-        {   // check if previous score is equal, and then emit equal rank
-            actualRank = rank;
-            previousAvgScore = avgScore;
-        }
-        std::vector<wxString> rowInfo =
-        {
-              U2String(actualRank)
-            , U2String(clubCount)
-            , names::GetClubName(club[clubIndex].clubId)
-            , club[clubIndex].score.AsString2F()
-            , avgScore.AsString2F()
-            , FMT("%7s (%2u, %5s)"
-                , club[clubIndex].totalScore.AsString2F()
-                , club[clubIndex].clubCount
-                , (club[clubIndex].totalScore/(club[clubIndex].clubCount * maxSession)).Round(2).AsString2F())
-        };
-        tmp2 = clubResult.CreateRow(rowInfo);
-        txtFile.AddLine(tmp2);
-
-        ++rank;
-    }
-
-    if (club[0].clubCount)
-    {   // pairs, not a member of a club
-        txtFile.AddLine(ES);
-        tmp = FMT(_("individual pairs: %u, score: %6s (%5s)"),
-            club[0].clubCount,
-            club[0].totalScore.AsString2F(),
-            (club[0].totalScore/(club[0].clubCount*maxSession)).Round(2).AsString2F()
-        );
-        txtFile.AddLine(tmp);
-    }
-
-    txtFile.Flush();    // write to disk
-}   // CalcClub()
-
 void CalcScore::CalcResultPairHelper(Fdp& sumPoints, UINT& sumTops, UINT& gamesPlayed, wxString& tmp)
 {
     #undef ADDLINE
@@ -1760,7 +422,7 @@ void CalcScore::CalcResultPairHelper(Fdp& sumPoints, UINT& sumTops, UINT& gamesP
     if (gamesPlayed)
     {
         if (m_bButler)
-            tmp += FMT(" %s: %s (%s %s)", _("set-score"), sumPoints.AsString(), (sumPoints / (int)gamesPlayed).Round(2).AsString2F(), _("imps/game"));
+            tmp += FMT(" %s: %s (%s %s)", _("set-score"), m_bCrossImps ? sumPoints.AsString1() : sumPoints.AsString(), (sumPoints / (int)gamesPlayed).Round(2).AsString2F(), _("imps/game"));
         else if ( sumTops ) // prevent divide-zero if there is not enough data
             tmp += FMT(" %s: %s(%s%%)", _("set-score"), sumPoints.AsString1E(), ((sumPoints * 100) / sumTops).Round(0).AsString());
     }
@@ -1774,6 +436,9 @@ void CalcScore::CalcResultPairHelper(Fdp& sumPoints, UINT& sumTops, UINT& gamesP
 
 void CalcScore::OnCalcResultPair(const wxCommandEvent& a_evt)
 {
+    if (m_bCalculating) return;     // engine data is being updated
+    const auto& sessionResult     = ssReports.GetContext().GetSessionResult();
+    const auto& sessionPairToRank = ssReports.GetContext().GetSessionPairToRank();
     AUTOTEST_BUSY("resultPair");
     UINT        pair            = 1U + a_evt.GetInt();
     auto        session         = cfg::GetActiveSession();
@@ -1790,7 +455,7 @@ void CalcScore::OnCalcResultPair(const wxCommandEvent& a_evt)
     ADDLINE(FMT(_("Result of pair %s '%s' for '%s'%s"), names::PairnrSession2SessionText(pair), names::PairnrSession2GlobalText(pair), cfg::GetDescription(), sessionString ));
     ADDLINE(ES);
 
-    if (svSessionResult[pair].nrOfGames == 0)
+    if (sessionResult[pair].nrOfGames == 0)
     {
         if (cfg::IsSessionPairAbsent(pair))
             ADDLINE(_("absent"));
@@ -1820,15 +485,17 @@ void CalcScore::OnCalcResultPair(const wxCommandEvent& a_evt)
         }
 
         ++gamesPlayed;
-        UINT top    = playerInfo.bIsNS ? svGameTops[game].topNS : svGameTops[game].topEW;
+        UINT top    = playerInfo.bIsNS ? ssReports.GetContext().GetGameTops(game).topNS : ssReports.GetContext().GetGameTops(game).topEW;
         if  (!m_bButler && top == 0) continue;    // no top yet, only playd once??
         long score  = playerInfo.score;
-        Fdp points = GetSetResult(pair, game, 1);
+        Fdp points = ssReports.GetContext().GetSetResult(pair, game, 1);
         sumPoints  += points;
         sumTops    += top;
         tmp        += playerInfo.bIsNS ? _("NS") : _("EW");
         tmp        += FMT(_(", score: %5s"), score::ScoreToString(score)  );
-        if (m_bButler)
+        if (m_bCrossImps)
+            tmp    += FMT(_(", imps %6s" )   , points.AsString2F() );
+        else if (m_bButler)
             tmp    += FMT(_(", imps %3ld" )  , points.AsLong() );
 
         else
@@ -1852,7 +519,7 @@ void CalcScore::OnCalcResultPair(const wxCommandEvent& a_evt)
     wxString correctionString;
     wxString corrections;
 
-    GetSessionCorrectionStrings(pair, combiString, correctionString);
+    ssReports.GetSessionCorrectionStrings(pair, combiString, correctionString);
     UINT state = 0;
     if ( combiString     .Len() ) state  = 1;
     if ( correctionString.Len() ) state |= 2;
@@ -1869,26 +536,26 @@ void CalcScore::OnCalcResultPair(const wxCommandEvent& a_evt)
             corrections = " (" + combiString + ", " + correctionString + ')';
     }
 
-    Fdp score = svSessionResult[pair].procentScore;
+    Fdp score = sessionResult[pair].procentScore;
     if (m_bButler)
     {
-        ADDLINE(FMT(_("imps: %ld, games: %u, sessionscore: %s imps/game%s, rank: %u"),
-            svSessionResult[pair].butlerMp.AsLong(),
-            svSessionResult[pair].nrOfGames,
+        ADDLINE(FMT(_("imps: %s, games: %u, sessionscore: %s imps/game%s, rank: %u"),
+            m_bCrossImps ? sessionResult[pair].butlerMp.AsString1() : sessionResult[pair].butlerMp.AsString(),
+            sessionResult[pair].nrOfGames,
             score.AsString2F(),
             corrections,
-            svSessionPairToRank[pair]
+            sessionPairToRank[pair]
         ));
 
     }
     else
         ADDLINE(FMT(_("points: %s (%i), games: %u, sessionscore: %s%%%s, rank: %u"),
-            svSessionResult[pair].points.AsString1E(),
-            svSessionResult[pair].maxScore,
-            svSessionResult[pair].nrOfGames,
+            sessionResult[pair].points.AsString1E(),
+            sessionResult[pair].maxScore,
+            sessionResult[pair].nrOfGames,
             score.AsString2F(),
             corrections,
-            svSessionPairToRank[pair]
+            sessionPairToRank[pair]
             ));
 
     m_choiceResult = ResultPair;
@@ -1898,6 +565,7 @@ void CalcScore::OnCalcResultPair(const wxCommandEvent& a_evt)
 
 void CalcScore::OnCalcResultGame(const wxCommandEvent& a_evt)
 {
+    if (m_bCalculating) return;     // engine data is being updated
     AUTOTEST_BUSY("resultGame");
     UINT        game            = 1U + a_evt.GetInt();
     auto        session         = cfg::GetActiveSession();
@@ -1909,7 +577,7 @@ void CalcScore::OnCalcResultGame(const wxCommandEvent& a_evt)
     ADDLINE(ES);
     ADDLINE(FMT(_("Result of game %u for '%s'%s"), game, cfg::GetDescription(), sessionString ));
     ADDLINE(ES);
-    for (const auto& frq : svFrqstringTable[game])
+    for (const auto& frq : ssReports.GetFrequencyTable(game))
     {
         ADDLINE(frq);
     }
@@ -1962,321 +630,3 @@ void CalcScore::OnCalcResultGame(const wxCommandEvent& a_evt)
 
 #undef ADDLINE
 }   // OnCalcResultGame()
-
-static long GetDelta(long score, long datum)
-{
-    return score::IsProcent(score) ? 0 : score::Score2Real(score)-datum;
-}   // GetDelta()
-
-void CalcScore::CalcButlerFkw(UINT a_game) const
-{   // called when 'agame' is calculated, so datum-scores are available
-    if ( (*spvGameSetData)[a_game].empty() )
-        return; // game not played
-
-    ButlerFkwMap  gameMap;
-    for (const auto& it : (*spvGameSetData)[a_game])
-    {
-        long scoreNs = it.scoreNS;
-        if ( svButlerFkw[a_game].contains(scoreNs) )
-            continue;   // score already present
-        ButlerFkw fkw;
-        fkw.bInit   = true;
-        fkw.scoreNs = scoreNs;
-        auto datum  = svDatumScores[a_game].dsNS;
-        fkw.deltaNs = GetDelta(fkw.scoreNs, datum);
-        fkw.impsNs  = ButlerGetMpsFromScore(fkw.scoreNs, datum);
-
-        fkw.scoreEw = it.scoreEW;
-        datum       = svDatumScores[a_game].dsEW;
-        fkw.deltaEw = GetDelta(fkw.scoreEw, datum);
-        fkw.impsEw  = ButlerGetMpsFromScore(fkw.scoreEw, datum);
-
-        gameMap[scoreNs] = fkw;
-    }
-    svButlerFkw[a_game] = gameMap;
-
-    if (0) for ( const auto& [score, data] : svButlerFkw[a_game])
-        MyLogDebug("Game=%2u, scoreNs=%6s, delta=%5ld, imps=%3i, scoreEw=%6s, delta=%5ld, imps=%3i"
-            , a_game
-            , score::ScoreToString(data.scoreNs)
-            , data.deltaNs
-            , data.impsNs
-            , score::ScoreToString(data.scoreEw)
-            , data.deltaEw
-            , data.impsEw
-        );
-
-}   //CalcButlerFkw()
-
-bool CalcScore::FindBadGameData()
-{   // check if there are pair numbers greater then max number of players according schema
-    // calculation of the results would assert (invalid array-index)
-    bool bBadGameData= false;
-    m_txtBadGameData = _("In game results:\n\n");
-    std::vector<UINT> badPairs;
-#define CHECK_PAIR(pair) \
-        if ( (pair > m_numberOfSessionPairs) && badPairs.end() == std::find(badPairs.begin(), badPairs.end(), pair )) \
-        {\
-            m_txtBadGameData += FMT(_("Pairnr out of range:%3u, score(s) found for this pair.\n"), pair);\
-            badPairs.push_back(pair);\
-            bBadGameData = true;\
-        }
-
-    for (const auto& gamesData : (*spvGameSetData))
-    {   // for all games
-        for (const auto& result : gamesData)
-        {   // for all gameresults
-            CHECK_PAIR(result.pairNS);
-            CHECK_PAIR(result.pairEW);
-        }
-    }
-
-    if (bBadGameData)
-    {
-        m_txtBadGameData +=     _("\nDid you lower the number of players in any group?");
-        m_txtBadGameData += FMT(_("\nMaximum pair nr: %u (== sum of pairs in all groups)."), m_numberOfSessionPairs);
-        m_txtBadGameData +=     _("\nBetter remove scores of pairs you want to remove.");
-        m_txtBadGameData +=     _("\nResults are NOT reliable!");
-    }
-    return bBadGameData;
-#undef CHECK_PAIR
-}   // CheckGameData()
-
-static bool IsCombiCandidate(UINT a_sessionPair)
-{
-    auto        pGroupData = cfg::GetGroupDataFromSessionPair(a_sessionPair);
-    SchemaInfo  si(pGroupData->schemaId);
-    return si.AreOpponents(a_sessionPair - pGroupData->groupOffset, pGroupData->absent);
-}   // IsCombiCandidate()
-
-static void ValidateSessionCorrections(const cor::mCorrectionsSession* a_pNonValidatedCorrections)
-{   // validate session corrections once, so we don't constantly need to check its validity
-    bool bButler      = cfg::GetButler();
-    sbHaveValidCombi  = false;
-    sbHaveValidNormal = false;
-    smCorSessionValidated.clear();
-    wxString errorMsg;
-
-    for (const auto& [pair, correction] : *a_pNonValidatedCorrections)
-    {
-        constexpr auto OK_NORMAL = 1;
-        constexpr auto OK_COMBI  = 2;
-        UINT state = 0;
-        cor::CORRECTION_SESSION cs;
-
-        if ( pair > 0 && pair <= cfg::GetNrOfSessionPairs() )
-            cs = correction;
-        if ( cs.correction )
-        {   // 'normal' correction
-            if ( cs.type == '%' && bButler )
-            {   // butler can't have % correction
-                cs.correction = 0;
-            }
-            else
-                state |= OK_NORMAL;    // set valid normal state
-        }
-
-        if ( cs.maxExtra || cs.extra || cs.games )
-        {   // combi data
-            do
-            {
-                if ( !IsCombiCandidate(pair) )
-                {
-                    cs.extra = cs.maxExtra = cs.games = 0;
-                    break;
-                }
-                if ( cs.games == 0 )
-                {
-                    cs.extra = cs.maxExtra =  0;
-                    break;
-                }
-                if ( bButler )
-                {
-                    if ( cs.maxExtra )
-                        cs.extra = cs.maxExtra = cs.games = 0;
-                    else
-                        state |= OK_COMBI;
-                    break;
-                }
-                if ( (cs.maxExtra < cs.extra) || (cs.maxExtra == 0) || (cs.extra < 0) )
-                    cs.extra = cs.maxExtra = cs.games = 0;
-                else
-                    state |= OK_COMBI;
-            } while (false);
-        }
-
-        if ( state )    // some valid data
-        {
-            sbHaveValidNormal |= 0 != (state & OK_NORMAL);
-            sbHaveValidCombi  |= 0 != (state & OK_COMBI);
-            smCorSessionValidated[pair] = cs;
-        }
-
-        if ( cs != correction && !cfg::IsScriptTesting() )
-        {   // some bad data ignored, accumulate errors and show them all at once
-            errorMsg += FMT("\n: '%u, %+i%c, %s,%i,%u'"
-                                , pair
-                                , correction.correction
-                                , correction.type
-                                , correction.extra.AsString1E()
-                                , correction.maxExtra
-                                , correction.games
-                            );
-        }
-    }   // for()
-
-    if ( errorMsg.Len() )
-    {
-        GetMainframe()->CallAfter([errorMsg]
-            {   // if not CallAfter() we get the msgbox on an empty page
-                MyMessageBox(_("Bad data or combi-table results for non-combi player(s) ignored") + errorMsg
-                    , _("Warning"), wxOK | wxICON_INFORMATION);
-            });
-    }
-}   // ValidateSessionCorrections()
-
-static void GetValidatedEndCorrections4Session(cor::mCorrectionsEnd& a_ce, UINT a_session)
-{
-    (void)io::CorrectionsEndRead( a_ce, a_session, true);
-    wxString errorMsg;
-    cor::mCorrectionsEnd ceTemp;
-    bool bButler = cfg::GetButler();
-    bool bTesting= cfg::IsScriptTesting();
-
-    for (const auto& [globalPair, ce] : a_ce)
-    {
-        auto realScore = (ce.score == SCORE_IGNORE || ce.score == SCORE_NO_TOTAL) ? 0 : ce.score;
-        if (
-               (ce.score < (bButler ? -100 : 0 ))
-            || ((ce.score  > 100) && realScore) // between 0 and 100%
-            || (ce.bonus   <= -100)
-            || (ce.bonus   >= +100) // between -99.99% and +99.99% or imps
-            || (globalPair < 1)
-            || (globalPair > names::GetNumberOfGlobalPairs())
-            || (ce.games   > cfg::GetNrOfGames())
-            || (ce.bonus && (ce.games || realScore))
-            )
-        {   // (some) incorrect value(s)
-            if ( !bTesting )
-            {
-                errorMsg += FMT("\n:  '%u,%s,%s,%u'"
-                                    , globalPair
-                                    , ce.score.AsString2F()
-                                    , ce.bonus.AsString2F()
-                                    , ce.games
-                               );
-            }
-        }
-        else
-            ceTemp[globalPair] = ce;
-    }   // for
-
-    if ( errorMsg.Len() )
-    {
-        GetMainframe()->CallAfter([errorMsg]
-            {   // if not CallAfter() we get the msgbox on an empty page
-                MyMessageBox(_("Invalid total-correction/end data, will be ignored")+ errorMsg
-                                , _("Warning"), wxOK | wxICON_INFORMATION
-                            );
-            });
-    }
-
-    a_ce = ceTemp;  // copy to destination what we have...
-}   // GetValidatedEndCorrections4Session()
-
-static UINT GetNumberOfRounds(UINT a_sessionPair)
-{
-    auto        pGroupData = cfg::GetGroupDataFromSessionPair(a_sessionPair);
-    SchemaInfo  si(pGroupData->schemaId);
-    return si.GetNumberOfRounds();
-}   // GetNumberOfRounds()
-
-wxString FormBuilder::CreateHeader(const std::vector<ColumnInfoHeader>& a_headerInfo) const
-{   // creation of the header, called once
-    auto size = a_headerInfo.size();
-    if (size != m_rowInfo.size())   // no translation: error should popup during development!
-        return "Error: mismatch in size of headerInfo and rowInfo";
-    wxString result;
-    auto rowInfo = m_rowInfo.begin();
-    for (const auto& column : a_headerInfo)
-    {
-        if (rowInfo->active)
-        {
-            if (FormBuilder::NO_LIMIT == rowInfo->size)
-                result += column.header;
-            else
-                result += CreateColumn(column.header, rowInfo->size, column.align);
-            result += column.extra;
-        }
-        result += FormBuilder::SEPERATOR;   // add a separator between colums
-        ++rowInfo;
-    }
-    return result.RemoveLast(); // remove last separator
-}   // CreateHeader()
-
-wxString FormBuilder::CreateRow(const std::vector<wxString>& a_columsContent) const
-{   // called for each data-row
-    size_t size = a_columsContent.size();
-    if (size != m_rowInfo.size())   // no translation: error should popup during development!
-        return "Error: mismatch in size of columnInfo and rowInfo";
-    wxString result;
-    auto content = a_columsContent.begin();
-    for (const auto& column : m_rowInfo)
-    {
-        if (column.active)
-        {
-            if (FormBuilder::NO_LIMIT == column.size)
-                result += *content;
-            else
-                result += CreateColumn(*content, column.size, column.align);
-            result += column.extra;
-        }
-        result += FormBuilder::SEPERATOR;   // add a separator between colums
-        ++content;
-    }
-    return result.RemoveLast(); // remove last separator
-}   // CreateRow()
-
-wxString FormBuilder::CreateColumn(const wxString& a_input, size_t a_len, Align a_align)
-{   // create a string with the wanted columnsize and alignment
-    size_t len = a_input.Len();
-    if (len == a_len)
-        return a_input;
-    if (len > a_len)
-        return a_input.Left(a_len);
-    wxString result;
-    #define _TEST_ 0
-    #if _TEST_
-        constexpr auto FILL_LEFT = '<';
-        constexpr auto FILL_RIGHT = '>';
-    #else
-        constexpr auto FILL_LEFT  = ' ';
-        constexpr auto FILL_RIGHT = ' ';
-    #endif
-    switch (a_align)
-    {
-        using enum FormBuilder::Align;
-        case LEFT:
-            result = a_input + wxString(FILL_RIGHT, a_len - len);
-            break;
-        case CENTER:
-            result = wxString(FILL_LEFT, (a_len - len)/2) + a_input + wxString(FILL_RIGHT, a_len - len - (a_len - len)/2);
-            break;
-        case RIGHT:
-            result = wxString(FILL_LEFT, a_len - len) + a_input;
-            break;
-        case LEFT_SPACE1:
-            return CreateColumn(" " + a_input, a_len, LEFT);
-            break;
-        case LEFT_SPACE2:
-            return CreateColumn("  " + a_input, a_len, LEFT);
-            break;
-        case RIGHT_SPACE1:
-            return CreateColumn(a_input + " ", a_len, RIGHT);
-            break;
-        case RIGHT_SPACE2:
-            return CreateColumn(a_input + "  ", a_len, RIGHT);
-            break;
-    }
-    return result;
-}   // CreateColumn()
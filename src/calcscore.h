@@ -5,95 +5,55 @@
 #define _CALC_SCORE_H_
 #pragma once
 
+#include <thread>
 #include "baseframe.h"
-#include "fdp.h"
+#include "calcreports.h"
+
+// speculative calculation: while idle, changed data is calculated in the background, so the results page is ready at once
+void CalcScoreOnIdle  ();     // called from OnIdle(): start a calculation if data has changed
+void CalcScoreStopIdle();     // stop a running background calculation, before data/databases are closed
 
 class wxTextCtrl;
 class wxStyledTextCtrl;
-class wxListView;
-
-struct Total                    // session-results for a player
-{
-    int  maxScore       = 0;    // in MP for % calculation
-    UINT nrOfGames      = 0;    // total played games
-    Fdp  points            ;    // earned MP     (x.y)
-    Fdp  procentScore      ;    // score in %    (x.yy)
-    Fdp  butlerMp          ;    // butler: total of imps voor all games
-    Fdp  mpPerGame         ;    // butler: imps/game, used for session result
-};
+class ReportListView;
 
 class CalcScore: public Baseframe
 {
 public:
     explicit    CalcScore(wxWindow* pParent, UINT pageId);
-               ~CalcScore() override = default;
+               ~CalcScore() override;
     void        RefreshInfo() final;    // (re)populate the grid
     void        PrintPage()   final;    // print grid/listbox
     void        AutotestRequestMousePositions(MyTextFile* pFile) final;
 
-    using FrequencyState = struct FrequencyState
-    {
-        int     score           = 0;
-        UINT    nrOfEqualScores = 0;
-        Fdp     points;
-        Fdp     pointsEW;
-    };
-
-    using FS_INFO = std::vector<FrequencyState>;
-    using FS      = std::vector<FS_INFO>;
-
 protected:
     void BackupData     () final;
     void DoSearch       (wxString&) final;      // handler for 'any' search in derived class
 
 private:
-    void        CalcSession             ();     // results for current session
-    void        CalcTotal               ();     // sum of results for all sesssions upto current session
-    void        CalcClub                (bool a_bTotal);     // results for clubs, if pairs have assigned clubs(total or session)
-    void        InitializeAndCalcScores ();
-    void        SaveSessionResults      ();
-    void        SaveSessionResultsProcent();
-    void        SaveSessionResultsButler();
-    void        SaveGroupResult         ();
-    void        ApplySessionCorrections (); // apply corrections to the session result
-    void        CalcGamePercent         (UINT game, bool bNs, FS_INFO& fsInfo);
-    void        CalcGameButler          (UINT game, bool bNs) const;
-    void        CalcButlerFkw           (UINT game) const;
-    void        MergeFrqTables          (FS_INFO& ns, const FS_INFO& ew) const;
-    void        SaveFrequencyTable      ();
-    void        MakeFrequenceTable      (UINT a_game, std::vector<wxString>& a_stringTable) const;
-    void        SaveSessionResultShort  ();
     void        OnPrint                 (const wxCommandEvent& );
     void        OnCalcResultPair        (const wxCommandEvent&);
     void        CalcResultPairHelper    (Fdp& sumPoints, UINT& sumTops, UINT& gamesPlayed, wxString& tmp);
 
     void        OnCalcResultGame        (const wxCommandEvent&);
     void        ShowChoice              ();
-    Fdp         GetSetResult            (UINT pair, UINT firstGame, UINT nrOfGames, UINT* pGamesPlayed = nullptr);  // get earned match-points for wanted games
-    static const bool GROUPRESULT_SESSION = true;
-    static const bool GROUPRESULT_FINAL   = false;
-    wxString    GetGroupResultString    (UINT pair, const std::vector<UINT>* a_pIndex = nullptr, bool bSession = GROUPRESULT_FINAL) const;    // get groupstring or rank in group "BLYEGR" / " . 1 ."
-    bool        FindBadGameData         (); // return true if invalid pairnrs found in gamedata
+    void        ShowResults             ();     // (re)populate the choices and the listbox with the last results
+    void        StopCalculation         ();
+    void        OnCalculationReady      (UINT generation);
 
-    wxListView* m_pListBox      = nullptr;
+    ReportListView* m_pListBox  = nullptr;     // virtual list: shows the lines of the selected report
     bool        m_bDataChanged  = false;     // 'something' changed
-    MyTextFile  m_txtFileResultSession;
-    MyTextFile  m_txtFileResultOnName;
-    MyTextFile  m_txtFileFrqTable;
-    MyTextFile  m_txtFileResultGroup;
-    MyTextFile  m_txtFileResultTotal;
-    MyTextFile  m_txtFileResultClubTotal;
-    MyTextFile  m_txtFileResultClubSession;
     MyTextFile  m_txtFileResultPair;            // result for a pair
     MyTextFile  m_txtFileResultGame;            // result for a game
     wxString    m_txtBadGameData;               // info on bad gamedata
-    UINT        m_numberOfSessionPairs = 0;     // sum of pairs in all groups
 
     bool        m_bButler       = false;
+    bool        m_bCrossImps    = false;        // butler: cross-imps i.s.o. a datum score
     bool        m_bBadGameData  = false;        // some bad pairnrs in gamedata
-    UINT        m_maxPair       = 1;            // highest pairnr played in this session
-    UINT        m_maxGame       = 1;            // highest gamenr
     long        m_findPos       = -1;           // start  searching in listbox from this line
+    std::jthread m_calcThread;                  // the engine runs in a worker, so the ui does not freeze
+    UINT        m_calcGeneration = 0;           // results of a calculation are only used if this is unchanged
+    bool        m_bCalculating  = false;        // worker is busy: engine data is not usable
     MyChoiceMC* m_pPairSelect   = nullptr;      // pair-selection for result of a specific pair
     MyChoiceMC* m_pGameSelect   = nullptr;      // game-selection for result of a specific game
 
@@ -114,45 +74,4 @@ private:
     int                     m_choiceResult = 0;
 };
 
-class FormBuilder
-{   // class to create a table with a header and one or more rows of data
-public:
-    enum class Align
-    {   // alignment in the columns of the header/rows
-          LEFT          // fillup with spaces after till wanted size
-        , CENTER        // as much spaces before and after till wanted size
-        , RIGHT         // as much spaces before till wanted size
-        , LEFT_SPACE1   // add one space in front, then LEFT
-        , LEFT_SPACE2   // add two spaces in front, then LEFT
-        , RIGHT_SPACE1  // add one space after, then RIGHT
-        , RIGHT_SPACE2  // add two spaces after, then RIGHT
-    };
-    static const size_t NO_LIMIT = ((size_t)-1);    // don't apply alignment for this column (mostly the last column)
-    static const char SEPERATOR = ' ';              // separator between columns
-    struct ColumnInfoHeader
-    {
-        Align       align;  // Can be different from row-alignment
-        wxString    extra;  // append this string to the constructed string
-        wxString    header; // column label
-    };
-
-    struct ColumnInfoRow
-    {
-        size_t      size;   // size of this column            , also used for the header
-        Align       align;  // alignment for the data-columns
-        wxString    extra;  // append this string to the constructed string
-        bool        active; // if not set, ignore this column , also used for the header
-    };
-
-    explicit FormBuilder(const std::vector<ColumnInfoRow>& a_rowInfo) : m_rowInfo(a_rowInfo) {}
-    ~FormBuilder() = default;
-
-    wxString        CreateHeader(const std::vector<ColumnInfoHeader>& headerInfo) const;
-    wxString        CreateRow   (const std::vector<wxString>& columsContent) const;
-    static wxString CreateColumn(const wxString& input, size_t len, Align align);
-
-private:
-    const std::vector<ColumnInfoRow>& m_rowInfo;  // reference, so one can apply runtime updates
-};  // FormBuilder
-
 #endif
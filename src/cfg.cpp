@@ -6,15 +6,16 @@
 #include <wx/stdpaths.h>
 #include <wx/app.h>
 #include <wx/settings.h>
+#include <wx/window.h>
+#include <wx/intl.h>
+#include <wx/file.h>
 
 #include "cfg.h"
 #include "utils.h"
 #include "names.h"
 #include "names.h"
-#include "printer.h"
-#include "scoreentry.h"
 #include "fileio.h"
-#include "main.h"
+#include "uilink.h"
 
 #include <iostream>
 
@@ -25,6 +26,8 @@ namespace cfg
     static const wxString   ssCentralNameFile("centraal.nm");       // nm-filename when using global names
     static const wxString   ssGlobalNameFile ("globalNames");       // db-filename when using global names
     static wxString         ssBaseFolder;           // folder where bridge.ini/globalNames.db is located
+    static wxString         ssBatchMatchFile;       // batch calculation: the match (path+name+extension) to use
+    static wxString         ssBatchMainIni;         // batch calculation: private main config, the one of the user is not touched
     static const Fdp        MAX_MEAN_FDP     ("52.50");             // default max average for final calculation if not present
 
     static wxString         ssActiveMatch;          // base-name of the active match, used in filenames. Must be inited here!
@@ -57,6 +60,7 @@ namespace cfg
     static bool             sbDebug          = false;
     static bool             sbIsScripttest   = false;
     static bool             sbButler         = false;
+    static bool             sbCrossImps      = false;// butler: imps against all other scores i.s.o. against a datum score
     static bool             sbNetworkPrinting= false;// default: do not enumerate networkrinters: often hangup
     static UINT             suFontsizeIncrease=0;   // increase standard fontsize with 'suFontsizeIncrease' %
 
@@ -202,7 +206,7 @@ namespace cfg
         {
             //bool bResult = wxSetWorkingDirectory("F:\\temp");     // for testing 'old' .ini files
             // baseFolder: location for bridge.ini and fallback for other files if a requested folder is not writable
-            wxString localIni   = wxGetCwd() + PS + MAIN_INIFILE;
+            wxString localIni   = ssBatchMatchFile.IsEmpty() ? wxGetCwd() + PS + MAIN_INIFILE : ES;
             ssBaseFolder        = wxStandardPaths::Get().GetDocumentsDir() + PS + __PRG_NAME__;
             ssMainIni           = ssBaseFolder + PS + MAIN_INIFILE;
             ssActiveMatch       = "default";
@@ -222,12 +226,27 @@ namespace cfg
             }
 
             siLanguage = wxLocale::GetSystemLanguage();
+
+            if (!ssBatchMatchFile.IsEmpty())
+            {   // batch: the match comes from the commandline, the main config is only for this process
+                wxFileName match(ssBatchMatchFile);
+                wxString   ext = match.GetExt().Lower();
+                ssMainIni         = ssBatchMainIni;
+                ssActiveMatch     = match.GetName();
+                ssActiveMatchPath = match.GetPath();
+                slActiveDbType    = ext == "ini"
+                                    ? io::ActiveDbType::DB_ORG
+                                    : ext == "sqlite"
+                                      ? io::ActiveDbType::DB_SQLITE
+                                      : io::ActiveDbType::DB_DATABASE;
+            }
         }
 
         if (a_type & INIT_MATCH)
         {
             sbBiosVideo     = false;    // compatability
             sbButler        = false;
+            sbCrossImps     = false;
             sbClock         = true;
             sbFormFeed      = false;    // compatability
             sbGlobalNameUse = false;
@@ -287,6 +306,7 @@ namespace cfg
     bool        IsScriptTesting()       { return sbIsScripttest;            }
     void        UpdateConfigHash()      { ++siConfigHash;                   }
     bool        GetButler()             { return sbButler;                  }
+    bool        GetCrossImps()          { return sbCrossImps;               }
 
 
     int GetLanguage()
@@ -337,6 +357,12 @@ namespace cfg
         SchemaWrite();
     }   // UpdateSessionInfo()
 
+    static UINT ButlerKeyValue()
+    {   // KEY_MATCH_BUTLER: 0 = percent, 1 = butler, 2 = butler with cross-imps (older versions see this as 'true')
+        if ( !sbButler ) return 0;
+        return sbCrossImps ? 2 : 1;
+    }   // ButlerKeyValue()
+
     void  SetButler(bool a_bOn)
     {
         if ( a_bOn == sbButler) return;
@@ -344,10 +370,18 @@ namespace cfg
         auto maxMean = sbButler ? std::min(Fdp(1),sfMaxMean) : std::max(MAX_MEAN_FDP,sfMaxMean);
         SetMaxMean(maxMean);
 
-        io::WriteValue(KEY_MATCH_BUTLER, sbButler);
+        io::WriteValue(KEY_MATCH_BUTLER, ButlerKeyValue());
         HashIncrement();
     }   // SetButler()
 
+    void  SetCrossImps(bool a_bOn)
+    {
+        if ( a_bOn == sbCrossImps) return;
+        sbCrossImps = a_bOn;
+        io::WriteValue(KEY_MATCH_BUTLER, ButlerKeyValue());
+        HashIncrement();
+    }   // SetCrossImps()
+
     void SetActiveMatch(const wxString& a_sMatch, const wxString& a_sMatchPath)
     {
         if (    ( ssActiveMatch == a_sMatch )
@@ -392,6 +426,8 @@ namespace cfg
     {
         if (suSession == a_activeSession) return;
 
+        if (a_activeSession < suSession)    // changes are only tracked upto the active session: so no totals after it
+            io::SessionTotalsInvalidate(a_activeSession+1, suSession);
         suSession = a_activeSession;
         io::WriteValue(KEY_MATCH_SESSION, suSession);
         HashIncrement();
@@ -484,7 +520,6 @@ namespace cfg
     {
         if (suLinesPerPage == a_linesPerPage) return;
         suLinesPerPage = a_linesPerPage;
-        prn::SetLinesPerPage(suLinesPerPage);
         io::WriteValue(KEY_MATCH_LINESPP, suLinesPerPage);
     }   // SetLinesPerPage()
 
@@ -601,6 +636,12 @@ namespace cfg
         case EXT_SESSION_RESULT:
             extension = FMT(".u%u", a_sessionId);
             break;
+        case EXT_SESSION_TOTALS:
+            extension = FMT(".a%u", a_sessionId);
+            break;
+        case EXT_SESSION_CALC_CACHE:
+            extension = FMT(".h%u", a_sessionId);
+            break;
         case EXT_RESULT_GROUP:
             extension = ".grp";
             break;
@@ -669,7 +710,6 @@ namespace cfg
         if (tmp == ssPrinterAll) return;
 
         ssPrinterAll = tmp;
-        prn::SetPrinterName(ssPrinterAll);
         io::WriteValue(KEY_MATCH_PRNT, ssPrinterAll);    // no 'WinP ' anymore
         SendEvent2Mainframe(ID_STATUSBAR_UPDATE);
     }   // SetPrinterName()
@@ -703,20 +743,20 @@ namespace cfg
         suSession       = io::ReadValueUINT (KEY_MATCH_SESSION   , suSession         );
         ssPrinterAll    = io::ReadValue     (KEY_MATCH_PRNT      , ssPrinterAll      );
         ssPrinterAll.Replace(WINPRINT_PREFIX, ES, false);   // remove winprint prefix
-        prn::SetPrinterName(ssPrinterAll);
         suMaxAbsent     = io::ReadValueUINT (KEY_MATCH_MAX_ABSENT, suMaxAbsent       );
         (void)io::MaxmeanRead(sfMaxMean);
         sbClock         = io::ReadValueBool (KEY_MATCH_CLOCK     , sbClock           );
         sbWeightedAvg   = io::ReadValueBool (KEY_MATCH_WEIGHTAVG , sbWeightedAvg     );
         sbBiosVideo     = io::ReadValueBool (KEY_MATCH_VIDEO     , sbBiosVideo       );
         suLinesPerPage  = io::ReadValueUINT (KEY_MATCH_LINESPP   , suLinesPerPage    );
-        prn::SetLinesPerPage(suLinesPerPage);
         sbNeuberg       = io::ReadValueBool (KEY_MATCH_NEUBERG   , sbNeuberg         );
         sbGroupResult   = io::ReadValueBool (KEY_MATCH_GRPRESULT , sbGroupResult     );
         MinMaxClubRead(suMinClub, suMaxClub);
         sbFormFeed      = io::ReadValueBool (KEY_MATCH_FF        , sbFormFeed        );
         sbGlobalNameUse = io::ReadValueBool (KEY_MATCH_GLOBALNAMES,sbGlobalNameUse   );
-        sbButler        = io::ReadValueBool (KEY_MATCH_BUTLER    , sbButler          );
+        UINT butler     = io::ReadValueUINT (KEY_MATCH_BUTLER    , ButlerKeyValue()  );
+        sbButler        = butler != 0;
+        sbCrossImps     = butler == 2;
 
         return CFG_OK;
     }   // UpdateConfigMatch()
@@ -801,7 +841,7 @@ namespace cfg
         // next l-variables are used to receive the commandline values
         // After the handling of the cmd-line, they will set the real values
         UINT    lsuMaxAbsent    = suMaxAbsent;
-        bool    lsbButler       = sbButler;
+        UINT    lsuButler       = ButlerKeyValue();
         Fdp     lsfMaxMean      = sfMaxMean;
         bool    lsbGroupResult  = sbGroupResult;
         bool    lsbClock        = sbClock;
@@ -841,7 +881,7 @@ namespace cfg
                 lsuMaxAbsent = wxAtoi(pArgptr);
                 break;
             case 'b':
-                lsbButler = wxAtoi(pArgptr);
+                lsuButler = wxAtoi(pArgptr);
                 break;
             case 'd':
                 sbDebug = 1;
@@ -911,7 +951,7 @@ namespace cfg
                   _("\n"
                     "  activation: BridgeWx [-ax] [-bx] [-gx] [-kx] [-lx] [-nx] [-rx] [-wx] [-fx] [-qx] [-d] [-u]\n"
                     "  ax: maximum allowed Absent count = x\n"
-                    "  bx: results are calculated according butler method (x=1), or as percentage (x=0)\n"
+                    "  bx: results are calculated according butler method (x=1), butler with cross-imps (x=2), or as percentage (x=0)\n"
                     "  d:  enable Debug for extra info\n"
                     "  gx: display Groupresult yes (x=1), no (x=0)\n"
                     "  kx: Clock on display (x=1), no Clock (x=0)\n"
@@ -946,7 +986,8 @@ namespace cfg
         SetActiveSession(lsiSession);
         SetMaxAbsent    (lsuMaxAbsent);
         SetNeuberg      (lsbNeuberg);
-        SetButler       (lsbButler);
+        SetButler       (lsuButler != 0);
+        SetCrossImps    (lsuButler == 2);
         SetClock        (lsbClock);
         SetLinesPerPage (lsiLinesPerPage);
         SetGroupResult  (lsbGroupResult);
@@ -965,6 +1006,13 @@ namespace cfg
         return CFG_OK;
     }   // HandleCommandline()
 
+    void SetBatchMatch(const wxString& a_matchFile)
+    {   // each batch process gets its own (empty) main config, so they can run at the same time
+        ssBatchMatchFile = a_matchFile;
+        if (ssBatchMainIni.IsEmpty())
+            ssBatchMainIni = wxFileName::CreateTempFileName(wxFileName::GetTempDir() + PS + __PRG_NAME__);
+    }   // SetBatchMatch()
+
     const GROUP_DATA* GetGroupDataFromSessionPair(UINT a_sessionPair)
     {
         for (const auto& it : sSessionInfo.groupData)
@@ -1007,6 +1055,8 @@ Cleanup::~Cleanup()
     {   // real exit, so close databases
         wxDELETE(cfg::spConfigMain);    // will set the ptr to zero after deletion
         io::DatabaseClose();
+        if (!cfg::ssBatchMainIni.IsEmpty())
+            (void)wxRemoveFile(cfg::ssBatchMainIni);    // private config of a batch run
     }
     cfg::sbLanguageRestart = false;
 }   // ~Cleanup()
@@ -131,6 +131,8 @@ namespace cfg
         EXT_SESSION_RANK_TOTAL_PREV,       //  't.'        x[pair] = total rank of 'pair' upto previous round (binairy)
         EXT_SESSION_RESULT,                //  'u.'        x[pair] = result of 'pair' like "50.00   1  s4  paar 1", zero based
         EXT_SESSION_SCORE,                 //  's.'        binairy scores for specific session
+        EXT_SESSION_TOTALS,                //  'a.'        running totals of all pairs upto/including specific session
+        EXT_SESSION_CALC_CACHE,            //  'h.'        session results of specific session with the hash of their input
         EXT_MAX
     };
 
@@ -197,6 +199,7 @@ namespace cfg
     bool        GetWeightedAvg();                           // the type of calculation over more matches
 
     int         HandleCommandline(const wxArrayString& argv, bool bInit = true);  //...
+    void        SetBatchMatch(const wxString& matchFile);   // batch: use 'matchFile' and a private main config, call before HandleCommandline()
     bool        IsDark();                                   // return true if darmode is active
     bool        IsDebug();                                  // true if we want some extra output
     bool        IsScriptTesting();                          // true if running auto-tests
@@ -244,6 +247,8 @@ namespace cfg
     wxString    GetBaseFolder();                            // main storage folder, fallback for non-writable folders
     bool        GetButler();                                // get the type of result-calculation
     void        SetButler(bool bOn);                        // set the type of result-calculation
+    bool        GetCrossImps();                             // butler: use cross-imps i.s.o. a datum score
+    void        SetCrossImps(bool bOn);                     // butler: use cross-imps i.s.o. a datum score
 
     const vGroupData* GetGroupData();                       // all the info of all groups
     const SessionInfo*GetSessionInfo();                     // all the sessioninfo, inclusive groupInfo
@@ -1,14 +1,16 @@
 ﻿// Copyright(c) 2024-present, BusyHarry/h.levels & BridgeWx contributors.
 // Distributed under the MIT License (http://opensource.org/licenses/MIT)
 
+#include <wx/window.h>
+#include <wx/intl.h>
+
 #include "cfg.h"
-#include "baseframe.h"
 #include "names.h"
 #include "utils.h"
 #include "score.h"
 #include "fileio.h"
 #include "corrections.h"
-#include "main.h"
+#include "uilink.h"
 
 namespace cor
 {
@@ -72,7 +74,10 @@ namespace cor
         {
             wxString msg = FMT(_("Invalid session-correction data <%s>, will be ignored."), a_input);
             MyLogError("%s",a_input);
-            GetMainframe()->CallAfter([msg]{MyMessageBox(msg, _("Warning"));});   // wait till page is shown
+            if (GetMainframe())
+                GetMainframe()->CallAfter([msg]{MyMessageBox(msg, _("Warning"));});   // wait till page is shown
+            else
+                MyMessageBox(msg, _("Warning"));    // no ui, e.g. batch calculation
             return false;
         }
 
@@ -111,7 +116,10 @@ namespace cor
                      msg += FMT(" %-11s: %u\n" , _("globalPair"), a_globalPair);
                      msg += FMT(" %s: %u, cfg::max: %u", _("games"), a_ce.games, cfg::MAX_GAMES); //cfg::GetNrOfGames());
             MyLogError("%s", msg);
-            GetMainframe()->CallAfter([msg] {MyMessageBox(msg);});  // wait till page is shown
+            if (GetMainframe())
+                GetMainframe()->CallAfter([msg] {MyMessageBox(msg);});  // wait till page is shown
+            else
+                MyMessageBox(msg);  // no ui, e.g. batch calculation
             return false;
         }
 
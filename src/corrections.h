@@ -43,8 +43,22 @@ constexpr auto BONUS_MAXIMUM  = (+9999);
         unsigned int    games=0;
     };
 
+    using CUMULATIVE_TOTAL = struct CUMULATIVE_TOTAL
+    {   // running totals of a global pair over sessions 1..n, as used by the total/end calculation
+        bool operator == (const CUMULATIVE_TOTAL& rhs) const = default;
+        Fdp             totalN;                 // sum of session scores
+        Fdp             totalGameScoreW;        // sum of games*score for weighted average
+        Fdp             bonus;                  // sum of bonusses
+        unsigned int    gameCount       = 0;    // sum of played games
+        unsigned int    activeSessions  = 0;    // sessions with played games
+        unsigned int    absentCount     = 0;    // sessions without played games
+        unsigned int    noTotalCount    = 0;    // sessions not accounting for the total (SCORE_NO_TOTAL)
+        bool            bWeightedAvg    = false;// true, if not always played all games of a session
+    };
+
 using mCorrectionsSession = std::map<unsigned int, cor::CORRECTION_SESSION>;
 using mCorrectionsEnd     = std::map<unsigned int, cor::CORRECTION_END>;
+using mCumulativeTotals   = std::map<unsigned int, cor::CUMULATIVE_TOTAL>;
 
 const mCorrectionsSession*  GetCorrectionsSession();
 const mCorrectionsEnd*      GetCorrectionsEnd    ();
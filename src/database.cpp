@@ -6,11 +6,14 @@
 #include <wx/msgdlg.h>
 #include <wx/arrstr.h>
 #include <wx/wxcrtvararg.h>
+#include <wx/log.h>
 #include <map>
 
 #include "mylog.h"
 #include "database.h"
 #include "dbglobals.h"
+#include "mytextfile.h"
+#include "uilink.h"
 
 namespace db
 {
@@ -364,6 +367,8 @@ static void InitSdb()
     dbKeys[KEY_SESSION_RESULT]           = "sessionResult";      // short session result, used for total/end calculation
     dbKeys[KEY_SESSION_RANK_SESSION]     = "sessionrank";        // rank in the sessionresult
     dbKeys[KEY_SESSION_RANK_TOTAL]       = "totalrank";          // rank in the totalresult for this session
+    dbKeys[KEY_SESSION_TOTALS]           = "sessionTotals";      // running totals upto this session, used for total/end calculation
+    dbKeys[KEY_SESSION_CALC_CACHE]       = "calcCache";          // session results with the hash of their input
 
 }  // InitSdb()
 
@@ -530,6 +535,40 @@ bool SessionResultWrite(const cor::mCorrectionsEnd& a_mSessionResult, UINT a_ses
     return s_pConfig->Write(MakePath(KEY_SESSION_RESULT, a_session), result);
 }   // SessionResultWrite()
 
+bool SessionTotalsRead(cor::mCumulativeTotals& a_mTotals, UINT a_session)
+{
+    a_mTotals.clear();
+    if ( !s_pConfig ) return false;
+    wxString info = s_pConfig->Read(MakePath(KEY_SESSION_TOTALS, a_session), ES);
+    return glb::SessionTotalsRead(a_mTotals, info);
+}   // SessionTotalsRead()
+
+bool SessionTotalsWrite(const cor::mCumulativeTotals& a_mTotals, UINT a_session)
+{   // no totals: remove the entry, if present
+    if ( !s_pConfig ) return false;
+    wxString path = MakePath(KEY_SESSION_TOTALS, a_session);
+    if ( a_mTotals.empty() )
+        return !s_pConfig->HasEntry(path) || s_pConfig->DeleteEntry(path, false);
+    return s_pConfig->Write(path, glb::SessionTotalsWrite(a_mTotals));
+}   // SessionTotalsWrite()
+
+bool CalcCacheRead(wxString& a_cache, UINT a_session)
+{
+    a_cache.clear();
+    if ( !s_pConfig ) return false;
+    a_cache = s_pConfig->Read(MakePath(KEY_SESSION_CALC_CACHE, a_session), ES);
+    return true;
+}   // CalcCacheRead()
+
+bool CalcCacheWrite(const wxString& a_cache, UINT a_session)
+{   // no cache: remove the entry, if present
+    if ( !s_pConfig ) return false;
+    wxString path = MakePath(KEY_SESSION_CALC_CACHE, a_session);
+    if ( a_cache.IsEmpty() )
+        return !s_pConfig->HasEntry(path) || s_pConfig->DeleteEntry(path, false);
+    return s_pConfig->Write(path, a_cache);     // newlines are escaped by wxFileConfig
+}   // CalcCacheWrite()
+
 bool SessionRankRead(UINT_VECTOR& a_vuRank, UINT a_session)
 {
     return UintVectorRead(a_vuRank, a_session, KEY_SESSION_RANK_SESSION);
@@ -2,9 +2,12 @@
 // Distributed under the MIT License (http://opensource.org/licenses/MIT)
 
 #include <wx/wxcrtvararg.h>
+#include <cstring>
 
 #include "dbglobals.h"
+#include "itemscanner.h"
 #include "mylog.h"
+#include "uilink.h"
 
 namespace glb
 {
@@ -33,9 +36,8 @@ namespace glb
         {
             UINT game = wxAtoi(sGame);
             if ( game > cfg::MAX_GAMES ) { MyLogError(_("Reading scores: gamenr <%s> too high!"), sGame); continue; }
-            auto splitValues = wxSplit(scores, theSeparator);
             std::vector<score::GameSetData> gameData;
-            for ( const auto& it : splitValues )
+            ForEachItem(scores, [&](ItemScanner& a_item)
             {
                 score::GameSetData setData;     // ensure that contracts are cleared!
                 char nsScore[10]    = { 0 };    // {1,2,'score','score'} or {1,2,'score','score',"nsContract","ewContract"}
@@ -44,8 +46,11 @@ namespace glb
                 char ewContract[20] = { 0 };
 
                 // OK, so sscanf fails if the string to read is empty! Solution: read string INCLUSIVE closing quote!
-                auto count = wxSscanf(it, " { %u , %u, %9[^, ] , %9[^} ,] , \"%19[^,], \"%19[^}]}"
-                    , &setData.pairNS, &setData.pairEW, nsScore, ewScore, nsContract, ewContract);
+                // " { %u , %u, %9[^, ] , %9[^} ,] , \"%19[^,], \"%19[^}]}"
+                auto count = a_item.Space().Literal('{').Space().Uint(setData.pairNS).Space().Literal(',').Space().Uint(setData.pairEW)
+                    .Literal(',').Space().Field(nsScore, 9, ", ").Space().Literal(',').Space().Field(ewScore, 9, "} ,")
+                    .Space().Literal(',').Space().Literal('"').Field(nsContract, 19, ",")
+                    .Literal(',').Space().Literal('"').Field(ewContract, 19, "}").Literal('}').Count();
                 if ( count == 6 ) // we have also read two biddings
                 {   // remove possible spaces and '"' at end of input
                     setData.contractNS = TrimContract(nsContract);
@@ -53,13 +58,13 @@ namespace glb
                 }
                 if ( count != 4 && count != 6 )
                 {
-                    MyLogError(_("Reading scores: game %u: <%s> invalid!"), game, it);
-                    continue;
+                    MyLogError(_("Reading scores: game %u: <%s> invalid!"), game, a_item.GetItem());
+                    return;
                 }
                 setData.scoreNS = score::ScoreFromString(nsScore);
                 setData.scoreEW = score::ScoreFromString(ewScore);
                 gameData.push_back(setData);
-            }
+            });
             a_scoreData[game] = gameData;
         }
         return true;
@@ -96,15 +101,16 @@ namespace glb
     bool CorrectionsEndRead(cor::mCorrectionsEnd& a_mCorrectionsEnd, bool a_bEdit, const wxString& a_data)
     {
         if ( a_data.IsEmpty() ) return true;    // no results, but no error!
-        auto split = wxSplit(a_data, theSeparator);
         bool bOk   = true;
-        for ( const auto& it : split )
+        ForEachItem(a_data, [&](ItemScanner& a_item)
         {   // {<global pairnr>,<score.2>,<bonus.2>,<games>}
             cor::CORRECTION_END ce;
             char scoreBuf[10 + 1] = { 0 };
             char bonusBuf[10 + 1] = { 0 };
-            UINT pairNr;
-            bool bItemError = (4 != wxSscanf(it, " {%u , %10[^, ] , %10[^, ] ,%u }", &pairNr, scoreBuf, bonusBuf, &ce.games));
+            UINT pairNr = 0;
+            // " {%u , %10[^, ] , %10[^, ] ,%u }"
+            bool bItemError = 4 != a_item.Space().Literal('{').Uint(pairNr).Space().Literal(',').Space().Field(scoreBuf, 10, ", ")
+                .Space().Literal(',').Space().Field(bonusBuf, 10, ", ").Space().Literal(',').Uint(ce.games).Space().Literal('}').Count();
             (void)bItemError;
             ce.score = Fdp(scoreBuf);
             ce.bonus = Fdp(bonusBuf);
@@ -123,7 +129,7 @@ namespace glb
                 }
             }
             //        else bOk = false; // let application handle this
-        }
+        });
         return bOk;
     }   // CorrectionsEndRead()
 
@@ -149,16 +155,15 @@ namespace glb
     {
         if ( a_corrections.IsEmpty() ) return true;
         bool bResult = true;    // assume all is ok
-        auto split   = wxSplit(a_corrections, theSeparator);
-        for ( const auto& it : split )
+        ForEachItem(a_corrections, [&](ItemScanner& a_item)
         {
-            UINT sessionPairnr;
+            UINT sessionPairnr = 0;
             cor::CORRECTION_SESSION cs;
             char extraBuf[10 + 1] = { 0 };
-            // {<session pairnr>,<correction><type>,<extra.1>,<max extra>}
-            auto entries = wxSscanf(it, " {%u ,%i %c , %10[^, ] ,%i, %u }"
-                , &sessionPairnr, &cs.correction, &cs.type, extraBuf, &cs.maxExtra, &cs.games
-            );  // older db may NOT have games component
+            // {<session pairnr>,<correction><type>,<extra.1>,<max extra>}: " {%u ,%i %c , %10[^, ] ,%i, %u }"
+            auto entries = a_item.Space().Literal('{').Uint(sessionPairnr).Space().Literal(',').Int(cs.correction).Space().Char(cs.type)
+                .Space().Literal(',').Space().Field(extraBuf, 10, ", ").Space().Literal(',').Int(cs.maxExtra)
+                .Literal(',').Space().Uint(cs.games).Space().Literal('}').Count();  // older db may NOT have games component
             bool bErrorEntry = entries < 5; (void)bErrorEntry;
             cs.extra = Fdp(extraBuf);
 #if 0   // don't remove (partly) bad input, application should do it
@@ -171,7 +176,7 @@ namespace glb
             {   // add info to map
                 a_mCorrectionsSession[sessionPairnr] = cs;
             }
-        }
+        });
         return bResult;
     }   // CorrectionsSessionRead()
 
@@ -205,7 +210,9 @@ namespace glb
         wxString info         = a_schema;
         wxString defaultValue = GetDefaultSchema();
         if ( info.IsEmpty() ) info = defaultValue;
-        auto count = wxSscanf(info, " {%u ,%u ,%u }", &a_sessionInfo.nrOfGames, &a_sessionInfo.setSize, &a_sessionInfo.firstGame);
+        auto infoBuf = info.mb_str();   // " {%u ,%u ,%u }" on the whole info
+        auto count   = ItemScanner(infoBuf.data(), infoBuf.data() + infoBuf.length()).Space().Literal('{').Uint(a_sessionInfo.nrOfGames)
+            .Space().Literal(',').Uint(a_sessionInfo.setSize).Space().Literal(',').Uint(a_sessionInfo.firstGame).Space().Literal('}').Count();
         if ( count != 3 )
         {   // on error, we just take a default value
             MyLogError(_("Error while reading schema <%s>"), info);
@@ -214,23 +221,33 @@ namespace glb
             a_sessionInfo.setSize   = 4;
             a_sessionInfo.firstGame = 1;
         }
-        auto split = wxSplit(info, theSeparator);
-        split.erase(split.begin()); // now we have only schema descriptions
         a_sessionInfo.groupData.clear();
         cfg::GROUP_DATA groupData;
         UINT groupOffset = 0;
-        for ( const auto& it : split )
+        bool bFirst      = true;
+        ForEachItem(info, [&](ItemScanner& a_item)
         {
+            if ( bFirst )
+            {   // only the schema descriptions
+                bFirst = false;
+                return;
+            }
+            ItemScanner retry   = a_item;   // same item for the second format
             char schema[20]     = { 0 };
             char groupChars[20] = { 0 };
             groupData.pairs     = 0;
             groupData.absent    = 0;
-            count               = wxSscanf(it, R"( {%u ,%u , "%19[^"]" , "%19[^"]" })", &groupData.pairs, &groupData.absent, schema, groupChars);
+            // R"( {%u ,%u , "%19[^"]" , "%19[^"]" })"
+            count = a_item.Space().Literal('{').Uint(groupData.pairs).Space().Literal(',').Uint(groupData.absent)
+                .Space().Literal(',').Space().Literal('"').Field(schema, 19, "\"").Literal('"')
+                .Space().Literal(',').Space().Literal('"').Field(groupChars, 19, "\"").Literal('"').Space().Literal('}').Count();
             // count == 2 -> empty schema
             // count == 3 -> empty groupchars
             if ( count == 2 )
-            {   // no schema, but perhaps groupchars
-                count = wxSscanf(it, R"( {%u ,%u , "" , "%19[^"]" })", &groupData.pairs, &groupData.absent, groupChars);
+            {   // no schema, but perhaps groupchars: R"( {%u ,%u , "" , "%19[^"]" })"
+                count = retry.Space().Literal('{').Uint(groupData.pairs).Space().Literal(',').Uint(groupData.absent)
+                    .Space().Literal(',').Space().Literal('"').Literal('"')
+                    .Space().Literal(',').Space().Literal('"').Field(groupChars, 19, "\"").Literal('"').Space().Literal('}').Count();
             }
             if ( count < 3 )
             {   // schema and groupchars empty
@@ -243,7 +260,7 @@ namespace glb
             groupData.groupOffset = groupOffset;
             groupOffset          += groupData.pairs;
             a_sessionInfo.groupData.push_back(groupData);
-        }
+        });
         return true;
     }  // SchemaRead()
 
@@ -289,22 +306,22 @@ namespace glb
     {   // NB input MAP is initialized, so don't clear or resize it or add 'new' pairnrs!
         if ( a_info.IsEmpty() ) return true;    // no results, but no error!
         bool bResult = true;    // assume all is ok
-        auto split   = wxSplit(a_info, theSeparator);
-        for ( const auto& it : split )
-        {   // {<global pairnr>,<score.2>,<games>}
+        ForEachItem(a_info, [&](ItemScanner& a_item)
+        {   // {<global pairnr>,<score.2>,<games>}: " {%u , %10[^, ] , %u }"
             cor::CORRECTION_END ce;
             char scoreBuf[10 + 1] = { 0 };
-            UINT pairNr;
-            bool bItemError = (3 != wxSscanf(it, " {%u , %10[^, ] , %u }", &pairNr, scoreBuf, &ce.games));
+            UINT pairNr = 0;
+            bool bItemError = 3 != a_item.Space().Literal('{').Uint(pairNr).Space().Literal(',').Space().Field(scoreBuf, 10, ", ")
+                .Space().Literal(',').Uint(ce.games).Space().Literal('}').Count();
             ce.score = Fdp(scoreBuf);
             if ( !a_mSessionResult.contains(pairNr) )
                 bItemError = true;  // pair MUST be present!
-            if ( cor::IsValidCorrectionEnd(pairNr, ce, it, bItemError) )
+            if ( cor::IsValidCorrectionEnd(pairNr, ce, a_item.GetItem(), bItemError) )
             {
                 a_mSessionResult[pairNr] = ce;
             }
             else bResult = false;
-        }
+        });
 
         return bResult;
     }   //SessionResultRead()
@@ -328,6 +345,66 @@ namespace glb
         return result;
     }   // SessionResultWrite()
 
+    bool SessionTotalsRead(cor::mCumulativeTotals& a_mTotals, const wxString& a_info)
+    {   // totals are derived data: on error, just return false and let the caller recalculate them
+        a_mTotals.clear();
+        if ( a_info.IsEmpty() ) return true;    // no totals, but no error!
+        bool bOk = true;
+        ForEachItem(a_info, [&](ItemScanner& a_item)
+        {   // {<global pairnr>,<totalN.3>,<gameScoreW.3>,<bonus.3>,<games>,<active>,<absent>,<noTotal>,<weighted>}
+            if ( !bOk ) return;
+            cor::CUMULATIVE_TOTAL total;
+            char totalBuf[15 + 1] = { 0 };
+            char scoreBuf[15 + 1] = { 0 };
+            char bonusBuf[15 + 1] = { 0 };
+            UINT pairNr = 0, bWeighted = 0;
+            // " {%u , %15[^, ] , %15[^, ] , %15[^, ] , %u , %u , %u , %u , %u }"
+            auto count = a_item.Space().Literal('{').Uint(pairNr).Space().Literal(',').Space().Field(totalBuf, 15, ", ")
+                .Space().Literal(',').Space().Field(scoreBuf, 15, ", ").Space().Literal(',').Space().Field(bonusBuf, 15, ", ")
+                .Space().Literal(',').Space().Uint(total.gameCount).Space().Literal(',').Space().Uint(total.activeSessions)
+                .Space().Literal(',').Space().Uint(total.absentCount).Space().Literal(',').Space().Uint(total.noTotalCount)
+                .Space().Literal(',').Space().Uint(bWeighted).Space().Literal('}').Count();
+            if ( count != 9 )
+            {
+                MyLogError(_("Reading session totals: <%s> invalid!"), a_item.GetItem());
+                bOk = false;
+                return;
+            }
+            total.totalN          = Fdp(totalBuf);
+            total.totalGameScoreW = Fdp(scoreBuf);
+            total.bonus           = Fdp(bonusBuf);
+            total.bWeightedAvg    = bWeighted != 0;
+            a_mTotals[pairNr]     = total;
+        });
+
+        if ( !bOk ) a_mTotals.clear();
+        return bOk;
+    }   // SessionTotalsRead()
+
+    wxString SessionTotalsWrite(const cor::mCumulativeTotals& a_mTotals)
+    {
+        wxString result;
+        wxChar   separator = ' ';
+        for ( const auto&[pair, data] : a_mTotals )
+        {
+            result += FMT("%c{%u,%s,%s,%s,%u,%u,%u,%u,%u}"
+                , separator
+                , pair                              // global pairnr
+                , data.totalN.AsString3()           // exact sums: 3 decimals
+                , data.totalGameScoreW.AsString3()
+                , data.bonus.AsString3()
+                , data.gameCount
+                , data.activeSessions
+                , data.absentCount
+                , data.noTotalCount
+                , data.bWeightedAvg ? 1U : 0U
+            );
+            separator = theSeparator;
+        }
+
+        return result;
+    }   // SessionTotalsWrite()
+
     wxString UintVectorWrite(const UINT_VECTOR& a_vUint)
     {   // write contents of vector as UINT, ignoring entry 0
         wxString info;
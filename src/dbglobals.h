@@ -31,6 +31,8 @@ bool     SessionNamesRead        (      wxArrayString& names, const wxString& in
 wxString SessionNamesWrite       (const wxArrayString& names);
 bool     SessionResultRead       (      cor::mCorrectionsEnd& mSessionResult, const wxString& info);
 wxString SessionResultWrite      (const cor::mCorrectionsEnd& mSessionResult);
+bool     SessionTotalsRead       (      cor::mCumulativeTotals& mTotals, const wxString& info);
+wxString SessionTotalsWrite      (const cor::mCumulativeTotals& mTotals);
 wxString UintVectorWrite         (const UINT_VECTOR& vUint);
 bool     UintVectorRead          (      UINT_VECTOR& vUint, const wxString& info, const wxString& a_dbFile, const wxString& key, const wxString& errorMsg);
 
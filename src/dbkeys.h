@@ -42,6 +42,8 @@ enum keyId
     KEY_SESSION_RESULT,
     KEY_SESSION_RANK_SESSION,
     KEY_SESSION_RANK_TOTAL,
+    KEY_SESSION_TOTALS,
+    KEY_SESSION_CALC_CACHE,
 };
 
 #endif
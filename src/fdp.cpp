@@ -1,6 +1,8 @@
 #include <wx/app.h>
 //#include <wx/cmdline.h>
 #include <wx/msgdlg.h>
+#include <algorithm>
+#include <iterator>
 
 #include "fdp.h"
 
@@ -13,7 +15,8 @@
 
 #define FMT wxString::Format
 
-Fdp::Fdp(const wxString& a_val)
+template <unsigned int DIGITS>
+FixedDecimal<DIGITS>::FixedDecimal(const wxString& a_val)
 {   // "1234.5678"  "-123" "123."  ".123" "-.2"
     // NB, take max FRACTION_DIGITS digits after dp and DONOT round here! Round when string requested!
     // fe: '0.1499999' should give '0.1' for .ToString1(), so store : 149LL
@@ -55,41 +58,53 @@ Fdp::Fdp(const wxString& a_val)
     }
 
     m_value *= mpFactor;    // now we have a value with FRACTION_DIGITS decimals
-}   // Fdp::Fdp(wxString)
+}   // FixedDecimal::FixedDecimal(wxString)
 
-wxString Fdp::ToString(UINT a_dp, StringType a_type) const
+template <unsigned int DIGITS>
+wxString FixedDecimal<DIGITS>::ToString(UINT a_dp, StringType a_type) const
 {
+    wxString result;
+    Format(result, a_dp, a_type);
+    return result;
+}   // FixedDecimal::ToString()
+
+template <unsigned int DIGITS>
+void FixedDecimal<DIGITS>::Format(wxString& a_buffer, UINT a_dp, StringType a_type) const
+{   // the string is made in a local array from right to left, a_buffer is only assigned at the end
     bool bSign  = m_value < 0;
     LL   value  = ROUND[a_dp] + (bSign ? -m_value : +m_value);  // prepare absolute rounded value
     value      /= DIVISOR[a_dp];                                // remove unwanted digits at the end
     bSign      &= value != 0;                                   // update sign: value COULD be zero after division
     LL fraction = value % (FACTOR / DIVISOR[a_dp]);             // determine the fraction
 
-    wxString result;        // build result in reverse order
+    wchar_t  chars[32];                     // sign, 19 digits, dp
+    wchar_t* pEnd   = chars + std::size(chars);
+    wchar_t* pBegin = pEnd;
     for ( UINT count = 0; (count <= a_dp) || value; ++count )
     {   // need/want atleast a_dp+1 digits
-        result += static_cast<unsigned char>('0' + (value % 10));
+        if ( count == a_dp ) *--pBegin = '.';   // insert dp
+        *--pBegin = static_cast<wchar_t>('0' + (value % 10));
         value /= 10;
     }
-    if ( bSign ) result += '-';                 // add sign if needed
-    result.insert(a_dp, '.');                   // and insert dp
-    std::reverse(result.begin(), result.end()); // back to 'normal' order
+    if ( bSign ) *--pBegin = '-';           // add sign if needed
     switch ( a_type )
     {   // check what 'op' we want
         case StringType::SHORT: // remove trailing '0' and '.' as much as possible
-            while ( *result.rbegin() == '0' ) result.RemoveLast();
-            if    ( *result.rbegin() == '.' ) result.RemoveLast();
+            while ( pEnd[-1] == '0' ) --pEnd;
+            if    ( pEnd[-1] == '.' ) --pEnd;
             break;
         case StringType::EXTRA: // replace fraction and '.' with spaces if fraction == zero
             if ( fraction == 0 )
-                result.replace (result.size()-a_dp-1, a_dp+1ULL, a_dp+1ULL, ' ');
+                std::fill(pEnd-a_dp-1, pEnd, ' ');
             break;
         case StringType::LONG:  // do nothing, we want all...
             break;
     }
 
-    return result;
-}   // Fdp::ToString()
+    a_buffer.assign(pBegin, static_cast<size_t>(pEnd - pBegin));
+}   // FixedDecimal::Format()
+
+template class FixedDecimal<3>;     // Fdp
 
 #if STANDALONE_TEST == 1
 #include <iostream>
@@ -7,14 +7,32 @@
 // to also use ',' as decimal point -->  #define COMMA_AS_DP 
 #define COMMA_AS_DP
 
+#include <array>
+#include <span>
+
 class wxString;
 
-class Fdp
-{   // The FixedDecimalPoint class: a 'long long' with implied decimal point
+namespace fdp
+{
+    constexpr long long Pow10(unsigned int a_exp) {long long result = 1; while (a_exp--) result *= 10; return result;}
+
+    constexpr long long MulDiv(long long a_value, long long a_mul, long long a_div)
+    {   // a_value*a_mul/a_div (truncated), without the overflow of the product a_value*a_mul:
+        // a_value = q*a_div + r --> q*a_mul + (r*a_mul)/a_div, both parts have the same sign, so truncation is the same
+        return (a_value / a_div) * a_mul + ((a_value % a_div) * a_mul) / a_div;
+    }
+}   // namespace fdp
+
+template <unsigned int DIGITS>
+class FixedDecimal
+{   // The FixedDecimalPoint class: a 'long long' with implied decimal point and DIGITS fractional digits
     // Operators: multiply, divide, add, subtract and all compare methods
-    // Operands can be a mix of Fdp, int, long, long long
+    // Operands can be a mix of FixedDecimal, int, long, long long
     // conversion from/to string and int-types
+    // Batch methods (Sum, Scale, Round) work on a span of values in simple loops, so they can be vectorized
+    static_assert(DIGITS >= 2 && DIGITS <= 9, "need 2 digits for procents, more would limit the range too much");
 public:
+    using Fdp  = FixedDecimal;
     using UINT = unsigned int;
     using LL   = long long;
     enum class StringType
@@ -24,17 +42,17 @@ public:
         , EXTRA     // if fraction zero, use spaces, else LONG --> 123.000 --> '123    ' 123.100 --> '123.100'
     };
 
-                Fdp         () = default;
+    constexpr   FixedDecimal() = default;
 //              Fdp         (const Fdp& other) : m_value(other.m_value) {}
                 // cppcheck-suppress noExplicitConstructor
-                Fdp         (LL val): m_value(val * FACTOR) {}  // Can't use explicit: 'Fdp var = 3;' will give error
+    constexpr   FixedDecimal(LL val): m_value(val * FACTOR) {}  // Can't use explicit: 'Fdp var = 3;' will give error
                 // cppcheck-suppress noExplicitConstructor
-                Fdp         (const wxString& val);
+                FixedDecimal(const wxString& val);
                 // cppcheck-suppress noExplicitConstructor
 //     explicit Fdp         (const char* val) :Fdp(wxString(val)) {}; // error for: Fdp var; var = 0; use: var = 0LL;
 
-           Fdp  FromProcent2(int procent) { m_value = procent*DIVISOR[2]; return *this;}    // 3 --> 0.030
-    static Fdp  FromProcent (int procent)       // 3 --> 0.030
+    constexpr        Fdp  FromProcent2(int procent) { m_value = procent*DIVISOR[2]; return *this;}    // 3 --> 0.030
+    static constexpr Fdp  FromProcent (int procent)       // 3 --> 0.030
                 { // create an Fdp from % value: xx% -> Fdp(0.xx)
                   Fdp tmp;
                   tmp.m_value=procent*DIVISOR[2];   // dp == 2
@@ -53,46 +71,72 @@ public:
     wxString AsString3F() const {return ToString(3, StringType::LONG);  }
     wxString AsString3E() const {return ToString(3, StringType::EXTRA); }
 
-    long     AsLong    () const {return (long)DoGet(0);}   // get value as x
-    long     AsLong1   () const {return (long)DoGet(1);}   // get value as x.1
-    long     AsLong2   () const {return (long)DoGet(2);};  // get value as x.12
-    long     AsLong3   () const {return (long)DoGet(3);}   // get value as x.123
-    Fdp&     Round     (UINT a_dp) {m_value += Sign()*ROUND[a_dp];m_value /= DIVISOR[a_dp]; m_value *= DIVISOR[a_dp]; return *this;} // round value
-    Fdp&     Trunc     (UINT a_dp) {                             ;m_value /= DIVISOR[a_dp]; m_value *= DIVISOR[a_dp]; return *this;} // truncate value
+    // the same, into a caller-owned buffer: no allocation if it is large enough
+    void     Format    (wxString& buffer, UINT dp, StringType type) const;
+    void     AsString  (wxString& buffer) const {Format(buffer, 0, StringType::SHORT);}
+    void     AsString1 (wxString& buffer) const {Format(buffer, 1, StringType::SHORT);}
+    void     AsString1E(wxString& buffer) const {Format(buffer, 1, StringType::EXTRA);}
+    void     AsString2F(wxString& buffer) const {Format(buffer, 2, StringType::LONG); }
+
+    constexpr long AsLong    () const {return (long)DoGet(0);}   // get value as x
+    constexpr long AsLong1   () const {return (long)DoGet(1);}   // get value as x.1
+    constexpr long AsLong2   () const {return (long)DoGet(2);};  // get value as x.12
+    constexpr long AsLong3   () const {return (long)DoGet(3);}   // get value as x.123
+    constexpr Fdp& Round     (UINT a_dp) {m_value += Sign()*ROUND[a_dp];m_value /= DIVISOR[a_dp]; m_value *= DIVISOR[a_dp]; return *this;} // round value
+    constexpr Fdp& Trunc     (UINT a_dp) {                             ;m_value /= DIVISOR[a_dp]; m_value *= DIVISOR[a_dp]; return *this;} // truncate value
+
+    // batch methods
+    static constexpr Fdp  Sum  (std::span<const Fdp> values)           // sum of all values
+                {
+                    Fdp sum;
+                    for (const auto& value : values) sum.m_value += value.m_value;
+                    return sum;
+                }   // Sum()
+    static constexpr void Scale(std::span<Fdp> values, LL factor)       // multiply all values with factor
+                {
+                    for (auto& value : values) value.m_value *= factor;
+                }   // Scale()
+    static constexpr void Round(std::span<Fdp> values, UINT a_dp)       // round all values
+                {   // no Sign() call: a select instead of a multiply
+                    const LL round   = ROUND  [a_dp];
+                    const LL divisor = DIVISOR[a_dp];
+                    for (auto& value : values)
+                        value.m_value = ((value.m_value + (value.m_value < 0 ? -round : round)) / divisor) * divisor;
+                }   // Round()
 
         auto operator <=> (const Fdp&) const = default; // this will auto-generate ALL compare operators
 
-    explicit operator bool()                      const{return m_value != 0;}
-           Fdp& operator+=(        const Fdp& rhs)     {m_value +=rhs.m_value; return *this;}
-           Fdp& operator-=(        const Fdp& rhs)     {m_value -=rhs.m_value; return *this;}
-           Fdp& operator+=(                LL rhs)     {m_value +=rhs*FACTOR;  return *this;}
-           Fdp& operator-=(                LL rhs)     {m_value -=rhs*FACTOR;  return *this;}
-           Fdp  operator- ()                      const{Fdp tmp; tmp.m_value = -m_value; return tmp;}
-           Fdp  operator+ (        const Fdp& rhs)const{Fdp tmp; tmp.m_value = m_value + rhs.m_value; return tmp;}
-           Fdp  operator+ (                LL rhs)const{Fdp tmp; tmp.m_value = m_value + rhs*FACTOR;  return tmp;}
-    friend Fdp  operator+ (LL lhs, const Fdp& rhs)     {Fdp tmp; tmp.m_value = lhs*FACTOR + rhs.m_value; return tmp;}
-           Fdp  operator- (        const Fdp& rhs)const{Fdp tmp; tmp.m_value = m_value - rhs.m_value; return tmp;}
-           Fdp  operator- (                LL rhs)const{Fdp tmp; tmp.m_value = m_value - rhs*FACTOR;  return tmp;}
-    friend Fdp  operator- (LL lhs, const Fdp& rhs){Fdp tmp; tmp.m_value = lhs*FACTOR - rhs.m_value; return tmp;}
-           Fdp  operator* (        const Fdp& rhs)const{Fdp tmp; tmp.m_value = (m_value * rhs.m_value)/ FACTOR; return tmp;}
-           Fdp  operator* (                LL rhs)const{Fdp tmp; tmp.m_value = m_value * rhs;  return tmp;}
-    friend Fdp  operator* (LL lhs, const Fdp& rhs)     {Fdp tmp; tmp.m_value = lhs*rhs.m_value; return tmp;}
-           Fdp  operator/ (        const Fdp& rhs)const{Fdp tmp; tmp.m_value = (m_value * FACTOR)/rhs.m_value; return tmp;}
-           Fdp  operator/ (                LL rhs)const{Fdp tmp; tmp.m_value = m_value / rhs;  return tmp;}
-    friend Fdp  operator/ (LL lhs, const Fdp& rhs)     {Fdp tmp; tmp.m_value = (FACTOR*FACTOR*lhs)/rhs.m_value; return tmp;}
+    constexpr explicit operator bool()                      const{return m_value != 0;}
+    constexpr        Fdp& operator+=(        const Fdp& rhs)     {m_value +=rhs.m_value; return *this;}
+    constexpr        Fdp& operator-=(        const Fdp& rhs)     {m_value -=rhs.m_value; return *this;}
+    constexpr        Fdp& operator+=(                LL rhs)     {m_value +=rhs*FACTOR;  return *this;}
+    constexpr        Fdp& operator-=(                LL rhs)     {m_value -=rhs*FACTOR;  return *this;}
+    constexpr        Fdp  operator- ()                      const{Fdp tmp; tmp.m_value = -m_value; return tmp;}
+    constexpr        Fdp  operator+ (        const Fdp& rhs)const{Fdp tmp; tmp.m_value = m_value + rhs.m_value; return tmp;}
+    constexpr        Fdp  operator+ (                LL rhs)const{Fdp tmp; tmp.m_value = m_value + rhs*FACTOR;  return tmp;}
+    constexpr friend Fdp  operator+ (LL lhs, const Fdp& rhs)     {Fdp tmp; tmp.m_value = lhs*FACTOR + rhs.m_value; return tmp;}
+    constexpr        Fdp  operator- (        const Fdp& rhs)const{Fdp tmp; tmp.m_value = m_value - rhs.m_value; return tmp;}
+    constexpr        Fdp  operator- (                LL rhs)const{Fdp tmp; tmp.m_value = m_value - rhs*FACTOR;  return tmp;}
+    constexpr friend Fdp  operator- (LL lhs, const Fdp& rhs){Fdp tmp; tmp.m_value = lhs*FACTOR - rhs.m_value; return tmp;}
+    constexpr        Fdp  operator* (        const Fdp& rhs)const{Fdp tmp; tmp.m_value = fdp::MulDiv(m_value, rhs.m_value, FACTOR); return tmp;}
+    constexpr        Fdp  operator* (                LL rhs)const{Fdp tmp; tmp.m_value = m_value * rhs;  return tmp;}
+    constexpr friend Fdp  operator* (LL lhs, const Fdp& rhs)     {Fdp tmp; tmp.m_value = lhs*rhs.m_value; return tmp;}
+    constexpr        Fdp  operator/ (        const Fdp& rhs)const{Fdp tmp; tmp.m_value = fdp::MulDiv(m_value, FACTOR, rhs.m_value); return tmp;}
+    constexpr        Fdp  operator/ (                LL rhs)const{Fdp tmp; tmp.m_value = m_value / rhs;  return tmp;}
+    constexpr friend Fdp  operator/ (LL lhs, const Fdp& rhs)     {Fdp tmp; tmp.m_value = fdp::MulDiv(lhs*FACTOR, FACTOR, rhs.m_value); return tmp;}
 
 ///    Fdp& operator=(LL lhs) { Fdp tmp; tmp.m_value = lhs*FACTOR; return tmp; } // returning ref to local var???
 ///    Fdp& operator=(const Fdp& other) { if ( this != &other ) m_value = other.m_value; return *this; }
 
 private:
-    static constexpr LL   FACTOR           = 1000LL;     // for 3 decimals: 2 for real and 1 for rounding
-    static constexpr LL   FRACTION_DIGITS  = 3;          // cnv from string: use this value of fractional digits
-    static constexpr LL   DIVISOR[]        = {FACTOR/1, FACTOR/10, FACTOR/100, FACTOR/1000};     // for dp 0, 1, 2, 3
-    static constexpr LL   ROUND  []        = {FACTOR/2, FACTOR/20, FACTOR/200, FACTOR/2000};     // round-values for dp 0, 1, 2, 3
+    static constexpr LL   FACTOR           = fdp::Pow10(DIGITS);    // for 3 decimals: 2 for real and 1 for rounding
+    static constexpr LL   FRACTION_DIGITS  = DIGITS;                // cnv from string: use this value of fractional digits
+    static constexpr auto DIVISOR          = []{std::array<LL, DIGITS+1> div{}; for (UINT dp = 0; dp <= DIGITS; ++dp) div[dp] = FACTOR/fdp::Pow10(dp); return div;}();    // for dp 0..DIGITS
+    static constexpr auto ROUND            = []{std::array<LL, DIGITS+1> rnd{}; for (UINT dp = 0; dp <= DIGITS; ++dp) rnd[dp] = DIVISOR[dp]/2        ; return rnd;}();    // round-values for dp 0..DIGITS
 
     wxString  ToString(UINT dp, StringType type) const;
-    int       Sign    ()                   const { return (m_value < 0) ? -1 : +1; }
-    LL        DoGet   (UINT a_dp)                const
+    constexpr int Sign()                   const { return (m_value < 0) ? -1 : +1; }
+    constexpr LL  DoGet   (UINT a_dp)            const
                 {   // get the decimal presentation as LL
                     LL value = m_value + Sign()*ROUND[a_dp]; // prepare rounding
                     value /=  DIVISOR[a_dp];                        // get rounded value
@@ -100,6 +144,9 @@ private:
                 }   // DoGet()
 
     LL   m_value = 0;   // the only member variable as fixed decimal point xxx.yyy
-};  // class Fdp
+};  // class FixedDecimal
+
+using Fdp = FixedDecimal<3>;            // 3 decimals: 2 for real and 1 for rounding
+extern template class FixedDecimal<3>;  // string conversions are in fdp.cpp
 
 #endif
@@ -2,16 +2,65 @@
 // Distributed under the MIT License (http://opensource.org/licenses/MIT)
 
 #include <wx/filedlg.h>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <deque>
+#include <map>
+#include <tuple>
+#include <algorithm>
 
 #include "fileIo.h"
 #include "database.h"
 #include "orgInterface.h"
 #include "sqlite.h"
+#include "uilink.h"
 
 namespace io
 {   // all persistent match-io arrives here and is distributed to the wanted data-interface.
 
     static ActiveDbType seTheType = DB_ORG; // actions (only) applied to active type
+    static std::recursive_mutex ssBackendMutex; // the database implementations are used by one thread at a time: ui or write-behind
+
+    template <typename T>
+    struct CachedItem
+    {   // decoded data of one session, as read from the active database
+        bool bValid = false;    // false -> (re)read it from the database
+        bool bOk    = false;    // result of the database read
+        T    data;
+    };
+
+    struct SessionCache
+    {   // data of previous sessions that is read again for each (total) calculation
+        CachedItem<cor::mCorrectionsEnd> sessionResult;     // read into a map with all global pairs preset
+        CachedItem<cor::mCorrectionsEnd> correctionsEnd;    // read for editing: all entries
+        CachedItem<UINT_VECTOR>          sessionRank;
+        CachedItem<UINT_VECTOR>          totalRank;
+        CachedItem<cor::mCumulativeTotals> totals;        // running totals upto/including this session
+    };
+
+    static std::vector<SessionCache>    svSessionCache;     // [session]: decoded data, valid until written again
+    static wxString                     ssSessionCacheKey;  // the cached data belongs to this match/setup
+
+    static void SessionCacheClear()
+    {
+        svSessionCache.clear();
+        ssSessionCacheKey.clear();
+    }   // SessionCacheClear()
+
+    static SessionCache& GetSessionCache(UINT a_session)
+    {   // start with an empty cache if the match changed, or something that changes the decoding/validation
+        wxString key = FMT("%d|%s%s|%u|%d", static_cast<int>(seTheType), cfg::GetActiveMatchPath(), cfg::GetActiveMatch(),
+                           names::GetNumberOfGlobalPairs(), cfg::GetButler() ? 1 : 0);
+        if (key != ssSessionCacheKey)
+        {
+            SessionCacheClear();
+            ssSessionCacheKey = key;
+        }
+        if (a_session >= svSessionCache.size())
+            svSessionCache.resize(a_session+1ULL);
+        return svSessionCache[a_session];
+    }   // GetSessionCache()
 
     void DatabaseTypeSet(ActiveDbType a_type, bool a_bQuiet)
     {
@@ -32,6 +81,7 @@ namespace io
     #define FUNCTION0(name,typeReturn,defaultReturn) \
     typeReturn name() \
     {\
+        std::scoped_lock backendLock(ssBackendMutex);\
         typeReturn ret(defaultReturn);\
         if (seTheType & DB_ORG)      ret = org::name(); \
         if (seTheType & DB_DATABASE) ret =  db::name(); \
@@ -42,6 +92,7 @@ namespace io
     #define FUNCTION1(name,typeReturn,defaultReturn,typeParam1) \
     typeReturn name(typeParam1 p1) \
     {\
+        std::scoped_lock backendLock(ssBackendMutex);\
         typeReturn ret(defaultReturn);\
         if (seTheType & DB_ORG)      ret = org::name(p1); \
         if (seTheType & DB_DATABASE) ret =  db::name(p1); \
@@ -52,6 +103,7 @@ namespace io
     #define FUNCTION2(name,typeReturn,defaultReturn,typeParam1,typeParam2) \
     typeReturn name(typeParam1 p1, typeParam2 p2) \
     {\
+        std::scoped_lock backendLock(ssBackendMutex);\
         typeReturn ret(defaultReturn);\
         if (seTheType & DB_ORG)      ret = org::name(p1,p2); \
         if (seTheType & DB_DATABASE) ret =  db::name(p1,p2); \
@@ -62,6 +114,39 @@ namespace io
     #define FUNCTION3(name,typeReturn,defaultReturn,typeParam1,typeParam2,typeParam3) \
     typeReturn name(typeParam1 p1, typeParam2 p2, typeParam3 p3) \
     {\
+        std::scoped_lock backendLock(ssBackendMutex);\
+        typeReturn ret(defaultReturn);\
+        if (seTheType & DB_ORG)      ret = org::name(p1,p2,p3); \
+        if (seTheType & DB_DATABASE) ret =  db::name(p1,p2,p3); \
+        if (seTheType & DB_SQLITE)   ret = sql::name(p1,p2,p3); \
+        return ret;\
+    }
+
+    // as FUNCTIONx, but creates 'static Db<name>()': for functions that need some extra handling in 'name()'
+    #define DB_FUNCTION1(name,typeReturn,defaultReturn,typeParam1) \
+    static typeReturn Db##name(typeParam1 p1) \
+    {\
+        std::scoped_lock backendLock(ssBackendMutex);\
+        typeReturn ret(defaultReturn);\
+        if (seTheType & DB_ORG)      ret = org::name(p1); \
+        if (seTheType & DB_DATABASE) ret =  db::name(p1); \
+        if (seTheType & DB_SQLITE)   ret = sql::name(p1); \
+        return ret;\
+    }
+    #define DB_FUNCTION2(name,typeReturn,defaultReturn,typeParam1,typeParam2) \
+    static typeReturn Db##name(typeParam1 p1, typeParam2 p2) \
+    {\
+        std::scoped_lock backendLock(ssBackendMutex);\
+        typeReturn ret(defaultReturn);\
+        if (seTheType & DB_ORG)      ret = org::name(p1,p2); \
+        if (seTheType & DB_DATABASE) ret =  db::name(p1,p2); \
+        if (seTheType & DB_SQLITE)   ret = sql::name(p1,p2); \
+        return ret;\
+    }
+    #define DB_FUNCTION3(name,typeReturn,defaultReturn,typeParam1,typeParam2,typeParam3) \
+    static typeReturn Db##name(typeParam1 p1, typeParam2 p2, typeParam3 p3) \
+    {\
+        std::scoped_lock backendLock(ssBackendMutex);\
         typeReturn ret(defaultReturn);\
         if (seTheType & DB_ORG)      ret = org::name(p1,p2,p3); \
         if (seTheType & DB_DATABASE) ret =  db::name(p1,p2,p3); \
@@ -70,10 +155,10 @@ namespace io
     }
 
     //         function name           ret type    def.ret  paramtypes
-    FUNCTION1(DatabaseFlush             ,bool       ,false  ,GlbDbType)
-    FUNCTION1(DatabaseClose             ,bool       ,false  ,GlbDbType)
+ DB_FUNCTION1(DatabaseFlush             ,bool       ,false  ,GlbDbType)
+ DB_FUNCTION1(DatabaseClose             ,bool       ,false  ,GlbDbType)
     FUNCTION1(DatabaseIsOpen            ,bool       ,false  ,GlbDbType)
-    FUNCTION2(DatabaseOpen              ,CfgFileEnum,CFG_OK ,GlbDbType,CfgFileEnum)
+ DB_FUNCTION2(DatabaseOpen              ,CfgFileEnum,CFG_OK ,GlbDbType,CfgFileEnum)
     FUNCTION3(ReadValue                 ,wxString   ,ES     ,keyId,const wxString&,UINT)
     FUNCTION3(ReadValueBool             ,bool       ,false  ,keyId,bool,UINT)
     FUNCTION3(ReadValueLong             ,long       ,0L     ,keyId,long,UINT)
@@ -96,19 +181,325 @@ namespace io
     FUNCTION1(ClubnamesWrite            ,bool       ,false  ,const std::vector<wxString>&)
     FUNCTION2(SessionNamesWrite         ,bool       ,false  ,const wxArrayString&,UINT)
     FUNCTION2(SessionNamesRead          ,bool       ,false  ,      wxArrayString&,UINT)
-    FUNCTION2(ScoresRead                ,bool       ,false  ,      vvScoreData&,UINT)
-    FUNCTION2(ScoresWrite               ,bool       ,false  ,const vvScoreData&,UINT)
+ DB_FUNCTION2(ScoresRead                ,bool       ,false  ,      vvScoreData&,UINT)
+ DB_FUNCTION2(ScoresWrite               ,bool       ,false  ,const vvScoreData&,UINT)
     FUNCTION3(ScoresWriteEx             ,int        ,EX_RESULT_ERROR, const wxString&, const vvScoreData&, UINT);
-    FUNCTION2(SessionRankRead           ,bool       ,false  ,      UINT_VECTOR&,UINT)
-    FUNCTION2(SessionRankWrite          ,bool       ,false  ,const UINT_VECTOR&,UINT)
-    FUNCTION2(TotalRankRead             ,bool       ,false  ,      UINT_VECTOR&,UINT)
-    FUNCTION2(TotalRankWrite            ,bool       ,false  ,const UINT_VECTOR&,UINT)
-    FUNCTION2(CorrectionsEndWrite       ,bool       ,false  ,const cor::mCorrectionsEnd&,UINT)
-    FUNCTION3(CorrectionsEndRead        ,bool       ,false  ,      cor::mCorrectionsEnd&,UINT,bool)
+ DB_FUNCTION2(SessionRankRead           ,bool       ,false  ,      UINT_VECTOR&,UINT)
+ DB_FUNCTION2(SessionRankWrite          ,bool       ,false  ,const UINT_VECTOR&,UINT)
+ DB_FUNCTION2(TotalRankRead             ,bool       ,false  ,      UINT_VECTOR&,UINT)
+ DB_FUNCTION2(TotalRankWrite            ,bool       ,false  ,const UINT_VECTOR&,UINT)
+ DB_FUNCTION2(CorrectionsEndWrite       ,bool       ,false  ,const cor::mCorrectionsEnd&,UINT)
+ DB_FUNCTION3(CorrectionsEndRead        ,bool       ,false  ,      cor::mCorrectionsEnd&,UINT,bool)
     FUNCTION2(CorrectionsSessionWrite   ,bool       ,false  ,const cor::mCorrectionsSession&,UINT)
     FUNCTION2(CorrectionsSessionRead    ,bool       ,false  ,      cor::mCorrectionsSession&,UINT)
-    FUNCTION2(SessionResultWrite        ,bool       ,false  ,const cor::mCorrectionsEnd&,UINT)
-    FUNCTION2(SessionResultRead         ,bool       ,false  ,      cor::mCorrectionsEnd&,UINT)
+ DB_FUNCTION2(SessionResultWrite        ,bool       ,false  ,const cor::mCorrectionsEnd&,UINT)
+ DB_FUNCTION2(SessionResultRead         ,bool       ,false  ,      cor::mCorrectionsEnd&,UINT)
+ DB_FUNCTION2(SessionTotalsWrite        ,bool       ,false  ,const cor::mCumulativeTotals&,UINT)
+ DB_FUNCTION2(SessionTotalsRead         ,bool       ,false  ,      cor::mCumulativeTotals&,UINT)
+    FUNCTION2(CalcCacheRead             ,bool       ,false  ,      wxString&,UINT)
+    FUNCTION2(CalcCacheWrite            ,bool       ,false  ,const wxString&,UINT)
+
+    struct ScoresTarget
+    {   // where the scores of a session go, determined when the write is queued: the worker does not use the cfg data,
+        // which can change (another match/session) before the write is done
+        ActiveDbType type;
+        UINT         session;
+        wxString     file;      // DB_ORG: the score file. Others: the open database, changed only after a Drain()
+        bool operator < (const ScoresTarget& a_other) const
+        {
+            return std::tie(type, session, file) < std::tie(a_other.type, a_other.session, a_other.file);
+        }
+    };
+
+    static ScoresTarget GetScoresTarget(UINT a_session)
+    {
+        return {seTheType, a_session, (seTheType & DB_ORG) ? org::ScoresFile(a_session) : ES};
+    }   // GetScoresTarget()
+
+    static bool ScoresWriteTarget(const vvScoreData& a_scoreData, const ScoresTarget& a_target)
+    {   // as DbScoresWrite(), for the type/file of the queued write
+        std::scoped_lock backendLock(ssBackendMutex);
+        bool ret = false;
+        if (a_target.type & DB_ORG)      ret = org::ScoresWriteFile(a_scoreData, a_target.file);
+        if (a_target.type & DB_DATABASE) ret =  db::ScoresWrite(a_scoreData, a_target.session);
+        if (a_target.type & DB_SQLITE)   ret = sql::ScoresWrite(a_scoreData, a_target.session);
+        return ret;
+    }   // ScoresWriteTarget()
+
+    class WriteBehind
+    {   // the scores are written by a worker thread, so score entry and slips never wait for the disk.
+        // Pending writes of a session are coalesced: only its last data is written.
+        // Sessions are written in the order of their first pending write, a read gets the pending data.
+    public:
+        void Add(const vvScoreData& a_scoreData, const ScoresTarget& a_target)
+        {
+            {
+                std::scoped_lock lock(m_mutex);
+                if (!m_pending.contains(a_target)) m_order.push_back(a_target);
+                m_pending[a_target] = a_scoreData;
+                if (!m_thread.joinable())
+                    m_thread = std::jthread([this](std::stop_token a_stop){ Run(a_stop); });
+            }
+            m_condition.notify_all();
+        }   // Add()
+
+        bool Find(vvScoreData& a_scoreData, const ScoresTarget& a_target)
+        {   // true, if there is a pending write for this target
+            std::scoped_lock lock(m_mutex);
+            auto it = m_pending.find(a_target);
+            if (it == m_pending.end()) return false;
+            a_scoreData = it->second;
+            return true;
+        }   // Find()
+
+        void Drain()
+        {   // wait until all pending writes are done. Not allowed while owning ssBackendMutex!
+            std::unique_lock lock(m_mutex);
+            m_condition.wait(lock, [this]{ return m_order.empty() && !m_bBusy; });
+        }   // Drain()
+
+        void Stop()
+        {   // all written and no thread left: for close and exit
+            Drain();
+            if (m_thread.joinable())
+            {
+                m_thread.request_stop();
+                m_thread.join();
+            }
+        }   // Stop()
+
+    private:
+        void Run(std::stop_token a_stop)
+        {
+            for (;;)
+            {
+                {
+                    std::unique_lock lock(m_mutex);
+                    if (!m_condition.wait(lock, a_stop, [this]{ return !m_order.empty(); }))
+                        return;     // stopped, nothing pending
+                }
+                // take the backend before the data: a read that does not find it pending, waits for the write
+                std::scoped_lock backendLock(ssBackendMutex);
+                vvScoreData  scoreData;
+                ScoresTarget target;
+                {
+                    std::scoped_lock lock(m_mutex);
+                    target    = m_order.front();
+                    scoreData = std::move(m_pending[target]);
+                    m_order.pop_front();
+                    m_pending.erase(target);
+                    m_bBusy   = true;
+                }
+                if (!ScoresWriteTarget(scoreData, target))
+                    MyLogError(_("Writing scores of session %u failed!"), target.session);
+                {
+                    std::scoped_lock lock(m_mutex);
+                    m_bBusy = false;
+                }
+                m_condition.notify_all();
+            }
+        }   // Run()
+
+        std::mutex                          m_mutex;
+        std::condition_variable_any         m_condition;
+        std::deque<ScoresTarget>            m_order;        // in order of their first pending write
+        std::map<ScoresTarget, vvScoreData> m_pending;      // [target]: the last data written
+        bool                                m_bBusy = false;// the worker is writing
+        std::jthread                        m_thread;       // started on the first write
+    };  // class WriteBehind
+
+    static WriteBehind sWriteBehind;
+
+    bool ScoresWrite(const vvScoreData& a_scoreData, UINT a_session)
+    {   // result is always ok: a write error is logged by the worker
+        if (cfg::IsScriptTesting())
+            return DbScoresWrite(a_scoreData, a_session);   // keep the log in a fixed order
+        sWriteBehind.Add(a_scoreData, GetScoresTarget(a_session));
+        return true;
+    }   // ScoresWrite()
+
+    bool ScoresRead(vvScoreData& a_scoreData, UINT a_session)
+    {   // pending data is newer than the stored data
+        if (sWriteBehind.Find(a_scoreData, GetScoresTarget(a_session))) return true;
+        return DbScoresRead(a_scoreData, a_session);
+    }   // ScoresRead()
+
+    bool DatabaseFlush(GlbDbType a_dbType)
+    {
+        sWriteBehind.Drain();
+        return DbDatabaseFlush(a_dbType);
+    }   // DatabaseFlush()
+
+    bool DatabaseClose(GlbDbType a_dbType)
+    {   // also called at exit: all pending writes first
+        sWriteBehind.Stop();
+        return DbDatabaseClose(a_dbType);
+    }   // DatabaseClose()
+
+    CfgFileEnum DatabaseOpen(GlbDbType a_dbType, CfgFileEnum a_how2Open)
+    {   // (another) match/session: don't trust the cache anymore
+        sWriteBehind.Drain();
+        SessionCacheClear();
+        return DbDatabaseOpen(a_dbType, a_how2Open);
+    }   // DatabaseOpen()
+
+    static bool RankRead(CachedItem<UINT_VECTOR>& a_cache, UINT_VECTOR& a_vuRank, UINT a_session, bool a_bTotal)
+    {   // the result of a rank-read does not depend on the content of a_vuRank, so always cached
+        if (!a_cache.bValid)
+        {
+            a_cache.bOk    = a_bTotal ? DbTotalRankRead(a_cache.data, a_session) : DbSessionRankRead(a_cache.data, a_session);
+            a_cache.bValid = true;
+        }
+        a_vuRank = a_cache.data;
+        return a_cache.bOk;
+    }   // RankRead()
+
+    bool SessionRankRead(UINT_VECTOR& a_vuRank, UINT a_session)
+    {
+        return RankRead(GetSessionCache(a_session).sessionRank, a_vuRank, a_session, false);
+    }   // SessionRankRead()
+
+    bool TotalRankRead(UINT_VECTOR& a_vuRank, UINT a_session)
+    {
+        return RankRead(GetSessionCache(a_session).totalRank, a_vuRank, a_session, true);
+    }   // TotalRankRead()
+
+    bool SessionRankWrite(const UINT_VECTOR& a_vuRank, UINT a_session)
+    {
+        GetSessionCache(a_session).sessionRank.bValid = false;
+        return DbSessionRankWrite(a_vuRank, a_session);
+    }   // SessionRankWrite()
+
+    bool TotalRankWrite(const UINT_VECTOR& a_vuRank, UINT a_session)
+    {
+        GetSessionCache(a_session).totalRank.bValid = false;
+        return DbTotalRankWrite(a_vuRank, a_session);
+    }   // TotalRankWrite()
+
+    static bool IsPresetSessionResult(const cor::mCorrectionsEnd& a_mSessionResult)
+    {   // true, if all global pairs (and only these) are present, without any data: as CalcTotal() presets it
+        if (a_mSessionResult.size() != names::GetNumberOfGlobalPairs()+1ULL) return false;
+        UINT expected = 0;
+        for (const auto& [pair, data] : a_mSessionResult)
+        {
+            if (pair != expected++ || !(data == cor::CORRECTION_END())) return false;
+        }
+        return true;
+    }   // IsPresetSessionResult()
+
+    bool SessionResultRead(cor::mCorrectionsEnd& a_mSessionResult, UINT a_session)
+    {   // only a read into a preset map is cached: the result of other reads depends on the database type
+        if (!IsPresetSessionResult(a_mSessionResult))
+            return DbSessionResultRead(a_mSessionResult, a_session);
+        auto& cache = GetSessionCache(a_session).sessionResult;
+        if (!cache.bValid)
+        {
+            cache.data   = a_mSessionResult;
+            cache.bOk    = DbSessionResultRead(cache.data, a_session);
+            cache.bValid = true;
+        }
+        a_mSessionResult = cache.data;
+        return cache.bOk;
+    }   // SessionResultRead()
+
+    bool SessionTotalsRead(cor::mCumulativeTotals& a_mTotals, UINT a_session)
+    {
+        auto& cache = GetSessionCache(a_session).totals;
+        if (!cache.bValid)
+        {
+            cache.bOk    = DbSessionTotalsRead(cache.data, a_session);
+            cache.bValid = true;
+        }
+        a_mTotals = cache.data;
+        return cache.bOk;
+    }   // SessionTotalsRead()
+
+    bool SessionTotalsWrite(const cor::mCumulativeTotals& a_mTotals, UINT a_session)
+    {
+        auto& cache  = GetSessionCache(a_session).totals;
+        cache.data   = a_mTotals;
+        cache.bOk    = DbSessionTotalsWrite(a_mTotals, a_session);
+        cache.bValid = cache.bOk;
+        return cache.bOk;
+    }   // SessionTotalsWrite()
+
+    void SessionTotalsInvalidate(UINT a_firstSession, UINT a_lastSession)
+    {   // the running totals of these sessions depend on changed data. Sessions after the active one have
+        // no totals: they are removed when the active session is lowered (cfg::SetActiveSession())
+        for (UINT session = a_firstSession; session <= a_lastSession; ++session)
+        {
+            auto& cache = GetSessionCache(session).totals;
+            if (cache.bValid && cache.bOk && cache.data.empty()) continue;  // nothing (left) to remove
+            (void)SessionTotalsWrite(cor::mCumulativeTotals(), session);
+        }
+    }   // SessionTotalsInvalidate()
+
+    static bool IsSameSessionResult(const cor::mCorrectionsEnd& a_mSessionResult, UINT a_session)
+    {   // true, if a (preset) read of the session result would give the cached data of that session
+        const auto& cache = GetSessionCache(a_session).sessionResult;
+        if (!cache.bValid || !cache.bOk) return false;
+        cor::mCorrectionsEnd readBack;
+        for (const auto& [pair, data] : cache.data)
+        {   // the preset pairs, with the written data if present
+            auto it = a_mSessionResult.find(pair);
+            readBack[pair] = it == a_mSessionResult.end() ? cor::CORRECTION_END() : it->second;
+        }
+        return readBack == cache.data;
+    }   // IsSameSessionResult()
+
+    bool SessionResultWrite(const cor::mCorrectionsEnd& a_mSessionResult, UINT a_session)
+    {   // each recalculation writes its session result: only a changed result invalidates the running totals
+        if (IsSameSessionResult(a_mSessionResult, a_session))
+            return DbSessionResultWrite(a_mSessionResult, a_session);
+        GetSessionCache(a_session).sessionResult.bValid = false;
+        SessionTotalsInvalidate(a_session, std::max(a_session, cfg::GetActiveSession()));
+        return DbSessionResultWrite(a_mSessionResult, a_session);
+    }   // SessionResultWrite()
+
+    bool CorrectionsEndRead(cor::mCorrectionsEnd& a_mCorrectionsEnd, UINT a_session, bool a_bEdit)
+    {   // edit  : all entries, cached if read into an empty map
+        // !edit : only add/update the entries of pairs present in a_mCorrectionsEnd
+        if (a_bEdit && !a_mCorrectionsEnd.empty())
+            return DbCorrectionsEndRead(a_mCorrectionsEnd, a_session, a_bEdit);
+        auto& cache = GetSessionCache(a_session).correctionsEnd;
+        if (!cache.bValid)
+        {
+            cache.data.clear();
+            cache.bOk    = DbCorrectionsEndRead(cache.data, a_session, true);
+            cache.bValid = true;
+        }
+        if (a_bEdit)
+        {
+            a_mCorrectionsEnd = cache.data;
+            return cache.bOk;
+        }
+
+        for (const auto& [pair, ce] : cache.data)
+        {   // same handling as the databases do for a non-edit read
+            auto it = a_mCorrectionsEnd.find(pair);
+            if (it == a_mCorrectionsEnd.end()) continue;
+            if (ce.score != SCORE_IGNORE)
+                it->second = ce;
+            else if (seTheType & DB_ORG)
+            {   // keep only original score
+                it->second.bonus = ce.bonus;
+                it->second.games = ce.games;
+            }
+            else
+                it->second.bonus = ce.bonus;    // keep original score and nr of played games
+        }
+        return cache.bOk;
+    }   // CorrectionsEndRead()
+
+    bool CorrectionsEndWrite(const cor::mCorrectionsEnd& a_mCorrectionsEnd, UINT a_session)
+    {
+        auto& cache = GetSessionCache(a_session).correctionsEnd;
+        if (cache.bValid && cache.bOk && cache.data == a_mCorrectionsEnd)
+            return DbCorrectionsEndWrite(a_mCorrectionsEnd, a_session);     // unchanged: the totals stay valid
+        cache.bValid = false;
+        SessionTotalsInvalidate(a_session, std::max(a_session, cfg::GetActiveSession()));
+        return DbCorrectionsEndWrite(a_mCorrectionsEnd, a_session);
+    }   // CorrectionsEndWrite()
 
     static bool CanContinue(const wxString& a_targetFile)
     {
@@ -121,6 +512,7 @@ namespace io
 
     void ConvertDataBase(ConvertFromTo a_how)
     {
+        sWriteBehind.Drain();   // the conversion uses the implementations directly
         wxString fileTypes = (a_how == FromOldToDb ) ? _("ini files (*.ini)|*.ini") : _("db files (*.db)|*.db");
         wxFileDialog dialog(nullptr, _("'Bridge' Datafiles"), cfg::GetActiveMatchPath(), "", fileTypes, wxFD_OPEN|wxFD_FILE_MUST_EXIST);
         if (dialog.ShowModal() == wxID_CANCEL) return;
@@ -9,7 +9,7 @@
 #include "names.h"
 #include "score.h"
 #include "corrections.h"
-#include "calcscore.h"
+#include "calcengine.h"
 
 /*
 * the EX_RESULT_* are result values for the *Ex method(s)
@@ -50,6 +50,7 @@ namespace io
     ActiveDbType DatabaseTypeGet();
 
     #include "interfaces.h"
+    void SessionTotalsInvalidate(UINT firstSession, UINT lastSession);  // remove the running totals of these sessions
 
 } // namespace io
 #endif // _FILEIO_H_
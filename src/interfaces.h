@@ -8,6 +8,8 @@
 *  - database     (sql::) -> implementation for sqlite type of storage
 */
 
+    bool        CalcCacheRead           (      wxString& cache, UINT session);  // stored engine results of a session, empty if none
+    bool        CalcCacheWrite          (const wxString& cache, UINT session);  // empty: remove them
     bool        ClubnamesRead           (      std::vector<wxString>&   clubNames, UINT& a_uMaxId);
     bool        ClubnamesWrite          (const std::vector<wxString>&   clubNames   );
     bool        CorrectionsEndRead      (      cor::mCorrectionsEnd& correctionsEnd, UINT session, bool bEdit);
@@ -41,6 +43,8 @@
     bool        SessionRankWrite        (const UINT_VECTOR& vuRank, UINT session);
     bool        SessionResultRead       (      cor::mCorrectionsEnd& mSessionResult, UINT session);    // write and read: different params!
     bool        SessionResultWrite      (const cor::mCorrectionsEnd& mSessionResult, UINT session);    // write and read: different params!
+    bool        SessionTotalsRead       (      cor::mCumulativeTotals& mTotals, UINT session);   // running totals upto/including session
+    bool        SessionTotalsWrite      (const cor::mCumulativeTotals& mTotals, UINT session);   // empty map: remove them
     bool        TotalRankRead           (      UINT_VECTOR& vuRank, UINT session);
     bool        TotalRankWrite          (const UINT_VECTOR& vuRank, UINT session);
     bool        WriteValue              (keyId id, bool            value,   UINT session = DEFAULT_SESSION);
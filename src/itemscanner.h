@@ -0,0 +1,208 @@
+﻿// Copyright(c) 2026-present, BusyHarry/h.levels & BridgeWx contributors.
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#if !defined _ITEMSCANNER_H_
+#define  _ITEMSCANNER_H_
+/*
+* scanning of the items of the separated lists in the db/sqlite data, without copies:
+* used by the readers in dbglobals.cpp and by the parser comparison in benchmarks.cpp
+*/
+#include <wx/arrstr.h>
+#include <cctype>
+#include <cstring>
+#include "dbglobals.h"
+namespace glb
+{
+class ItemScanner
+{   // Scans one item of a separated list in place, like sscanf() with the same format would do:
+    // the same whitespace skipping, field widths and result count, so the same input is accepted.
+    // Each call is one directive of the format, after a failure the next calls do nothing.
+    // example: " {%u ,%u }" -> Space().Literal('{').Uint(a).Space().Literal(',').Uint(b).Space().Literal('}')
+public:
+    ItemScanner(const char* a_pBegin, const char* a_pEnd, bool a_bEscaped = false)
+        : m_pBegin(a_pBegin), m_pPos(a_pBegin), m_pEnd(a_pEnd), m_bEscaped(a_bEscaped), m_separator(static_cast<char>(GetSeparator())) {}
+
+    ItemScanner& Space()
+    {   // ' ' in the format: skip any whitespace
+        while ( !m_bFailed && Peek() >= 0 && std::isspace(Peek()) ) Advance();
+        return *this;
+    }   // Space()
+
+    ItemScanner& Literal(char a_char)
+    {   // other chars in the format must match
+        if ( Start() && Expect(Peek() == static_cast<unsigned char>(a_char)) )
+            Advance();
+        return *this;
+    }   // Literal()
+
+    ItemScanner& Uint(UINT& a_value)
+    {   // %u: optional sign and decimal digits
+        Space();
+        if ( !Start() ) return *this;
+        bool bNegative = Sign();
+        UINT value     = 0;
+        if ( Expect(Digits(10, value)) )
+            Store(a_value, bNegative ? 0U - value : value);
+        return *this;
+    }   // Uint()
+
+    ItemScanner& Int(int& a_value)
+    {   // %i: optional sign, then hex with '0x', octal with '0' or decimal digits
+        Space();
+        if ( !Start() ) return *this;
+        bool bNegative = Sign();
+        UINT base      = 10;
+        if ( Peek() == '0' )
+        {
+            Advance();
+            base = 8;
+            if ( (Peek() == 'x' || Peek() == 'X') )
+            {
+                Advance();
+                base = 16;
+            }
+        }
+        UINT value = 0;
+        bool bOk   = Digits(base, value) || base != 10;     // '0' and '0x' are a number on their own
+        if ( Expect(bOk) )
+            Store(a_value, static_cast<int>(bNegative ? 0U - value : value));
+        return *this;
+    }   // Int()
+
+    ItemScanner& Char(char& a_value)
+    {   // %c: the next char, whitespace included
+        if ( Start() )
+        {
+            Store(a_value, static_cast<char>(Peek()));
+            Advance();
+        }
+        return *this;
+    }   // Char()
+
+    ItemScanner& Field(char* a_pBuf, size_t a_width, const char* a_pStop)
+    {   // %<width>[^<stop>]: 1 upto 'width' chars that are not in 'stop', a_pBuf must have room for width+1 chars
+        if ( !Start() ) return *this;
+        size_t len = 0;
+        for ( int ch = Peek(); len < a_width && ch >= 0 && std::strchr(a_pStop, ch) == nullptr; ch = Peek() )
+        {
+            a_pBuf[len++] = static_cast<char>(ch);
+            Advance();
+        }
+        if ( Expect(len != 0) )
+        {
+            a_pBuf[len] = 0;
+            ++m_count;
+        }
+        return *this;
+    }   // Field()
+
+    int Count() const
+    {   // as sscanf(): the number of stored fields, -1 if the input ended before the first field
+        return (m_count == 0 && m_bInputEnd) ? -1 : m_count;
+    }   // Count()
+
+    wxString GetItem() const
+    {   // the item as text, for messages
+        return wxString(m_pBegin, static_cast<size_t>(m_pEnd - m_pBegin));
+    }   // GetItem()
+
+private:
+    int Peek() const
+    {   // the next char, -1 at the end. An escaped separator is a normal char, like in wxSplit()
+        if ( m_pPos >= m_pEnd ) return -1;
+        if ( m_bEscaped && *m_pPos == '\\' && m_pPos + 1 < m_pEnd && m_pPos[1] == m_separator )
+            return static_cast<unsigned char>(m_pPos[1]);
+        return static_cast<unsigned char>(*m_pPos);
+    }   // Peek()
+
+    void Advance()
+    {
+        bool bEscapedSeparator = m_bEscaped && *m_pPos == '\\' && m_pPos + 1 < m_pEnd && m_pPos[1] == m_separator;
+        m_pPos += bEscapedSeparator ? 2 : 1;
+    }   // Advance()
+
+    bool Start()
+    {   // a directive can start: not failed and not at the end of the input
+        if ( !m_bFailed && Peek() < 0 )
+            m_bFailed = m_bInputEnd = true;
+        return !m_bFailed;
+    }   // Start()
+
+    bool Expect(bool a_bMatch)
+    {   // a mismatch stops the scan
+        if ( !a_bMatch ) m_bFailed = true;
+        return a_bMatch;
+    }   // Expect()
+
+    bool Sign()
+    {   // true if negative
+        int ch = Peek();
+        if ( ch == '+' || ch == '-' ) Advance();
+        return ch == '-';
+    }   // Sign()
+
+    bool Digits(UINT a_base, UINT& a_value)
+    {   // returns false if there are no digits
+        bool bDigits = false;
+        for ( int ch = Peek(); ch >= 0; ch = Peek() )
+        {
+            UINT digit;
+            if      ( ch >= '0' && ch <= '9' )                    digit = static_cast<UINT>(ch - '0');
+            else if ( a_base == 16 && std::isxdigit(ch) )         digit = static_cast<UINT>(std::tolower(ch) - 'a' + 10);
+            else break;
+            if ( digit >= a_base ) break;
+            a_value = a_value*a_base + digit;
+            bDigits = true;
+            Advance();
+        }
+        return bDigits;
+    }   // Digits()
+
+    template <typename T>
+    void Store(T& a_field, T a_value) { a_field = a_value; ++m_count; }
+
+    const char* m_pBegin;
+    const char* m_pPos;
+    const char* m_pEnd;
+    bool        m_bEscaped;             // item from a list: '\\' before the separator is removed
+    char        m_separator;            // the separator of the list
+    bool        m_bFailed   = false;
+    bool        m_bInputEnd = false;    // failed because the input ended
+    int         m_count     = 0;
+};  // ItemScanner
+
+template <typename Parse>
+void ForEachItem(const wxString& a_data, Parse&& a_parse)
+{   // wxSplit(a_data, GetSeparator()) and scan each item with a_parse(ItemScanner&), without copies.
+    // The items are scanned in their multibyte form, the same input as wxSscanf() would get.
+    if ( a_data.IsEmpty() ) return;
+    auto buf = a_data.mb_str();
+    if ( buf.length() == 0 )
+    {   // not convertable as a whole: per item, as before
+        for ( const auto& item : wxSplit(a_data, GetSeparator()) )
+        {
+            auto        itemBuf = item.mb_str();
+            ItemScanner scanner(itemBuf.data(), itemBuf.data() + itemBuf.length());
+            a_parse(scanner);
+        }
+        return;
+    }
+
+    const char  separator = static_cast<char>(GetSeparator());
+    const char* pBegin    = buf.data();
+    const char* pEnd      = pBegin + buf.length();
+    const char* pItem     = pBegin;
+    for ( const char* pPos = pBegin; pPos < pEnd; ++pPos )
+    {
+        if ( *pPos == separator && !(pPos > pBegin && pPos[-1] == '\\') )
+        {   // a separator, if not escaped
+            ItemScanner scanner(pItem, pPos, true);
+            a_parse(scanner);
+            pItem = pPos + 1;
+        }
+    }
+    ItemScanner scanner(pItem, pEnd, true);
+    a_parse(scanner);
+}   // ForEachItem()
+}   // namespace glb
+#endif
@@ -32,7 +32,6 @@
 #include "main.h"
 
 static wxWindow* spMainframe = nullptr;      // to reach mainframe from clients
-wxWindow* GetMainframe(){return spMainframe;}
 
 wxCheckBox* g_pCheckboxBusyMC=nullptr;  // autohotkey uses this to find out if it has to wait before sending movements to popup in ChoiceMC
 wxCheckBox* g_pCheckboxBusy=nullptr;    // autohotkey uses this to find out if it has to wait before sending more mouse/text
@@ -90,6 +89,7 @@ void OnIdle()
         g_pCheckboxBusy->SetValue(false);   // uncheck -> not busy == ready
         DEBUG_BUSY MyLogDebug("Idle(%i), busy: %i --> 0",idleCount, checked);
     }
+    CalcScoreOnIdle();      // use idle time to calculate changed results
 }   // OnIdle()
 
 class MyFrame;
@@ -334,6 +334,7 @@ private:
 MyFrame::~MyFrame()
 {
     if (m_pActivePage) m_pActivePage->BackupData();
+    CalcScoreStopIdle();
 //    delete g_pCheckboxBusy;       // destroyed by MyFrame?
 //    delete g_pCheckboxBusyMC;     // destroyed by MyFrame?
     if ( --siMyFrameCounter == 0 )
@@ -456,6 +457,7 @@ bool MyApp::OnInit()
     // so we destroy it in DTOR of MyFrame
     spMyLog = new MyLog;
     MyLog::SetLevel(MyLog::Level::LOG_Max);
+    SetMessageBoxHandler(MyMessageDialog);  // messages of the non-ui code are shown as a dialog on the mainframe
     LogMessage("------------"); // just testing...
     LogMessage("test logging");
     LogError  ("Error");
@@ -568,6 +570,7 @@ MyFrame::MyFrame(MyApp& a_theApp) : wxFrame(nullptr, wxID_ANY, ssWinTitle = _("'
 
     SetIcon(wxICON(wxwin_standard_icon));
     spMainframe = this;    // for clients to reach us
+    SetMainframe(this);
 
     auto menuFile = new wxMenu;
     menuFile->Append(ID_MENU_SETUPNEWMATCH  , _("&New match/session"  ), _("Match/session entry"            ));
@@ -985,22 +988,3 @@ void MyFrame::LoadExistingSchemaFiles()
     }
     schema::DebuggingSchemaData();  // for debugging....
 }   // LoadExistingSchemaFiles()
-
-// cppcheck-suppress constParameterPointer
-void SendEvent2Mainframe(int a_id, void* a_pClientData)
-{
-    if (GetMainframe())
-    {
-        wxCommandEvent event(wxEVT_USER, a_id);
-        event.SetClientData(a_pClientData);
-        GetMainframe()->GetEventHandler()->AddPendingEvent(event);
-    }
-}   // SendEvent2Mainframe()
-
-// cppcheck-suppress constParameterPointer
-void SendEvent2Mainframe(wxWindow* a_pWindow, int a_id, void* const a_pClientData)
-{
-    wxCommandEvent event(wxEVT_USER, a_id);
-    event.SetClientData(a_pClientData);
-    a_pWindow->GetEventHandler()->AddPendingEvent(event);
-}   // SendEvent2Mainframe()
@@ -6,6 +6,8 @@
 #include <wx/textctrl.h>
 #include <wx/menu.h>
 #include <wx/filedlg.h>
+#include <wx/app.h>
+#include <wx/thread.h>
 #include <map>
 
 #include "mylog.h"
@@ -238,6 +240,11 @@ bool MyLog::IsEnabled(MyLog::Level a_level)
 
 void MyLog::DoLog(MyLog::Level a_level, const wxString& a_msg)
 {
+    if (!wxIsMainThread())
+    {   // from a worker thread (database write-behind): the log window may only be changed by the ui thread
+        if (wxTheApp) wxTheApp->CallAfter([a_level, a_msg]{ DoLog(a_level, a_msg); });
+        return;
+    }
     if (!sbLogger || sLevel < a_level ) return;
     if ( (unsigned int)a_level >= nrOfTypes ) return;
 
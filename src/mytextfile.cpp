@@ -0,0 +1,143 @@
+﻿// Copyright(c) 2024-present, BusyHarry/h.levels & BridgeWx contributors.
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#include <wx/intl.h>
+#include <array>
+
+#include "mylog.h"
+#include "mytextfile.h"
+
+/****************** MyTextFile **********************/
+MyTextFile::MyTextFile(const wxString& a_filename, AccessType a_access, wxTextFileType a_textType)
+{
+    MyCreate(a_filename, a_access, a_textType);
+}   // MyTextFile()
+
+void MyTextFile::MyCreate(const wxString& a_filename, AccessType a_access, wxTextFileType a_textType)
+{
+    m_access    = a_access;
+    m_textType  = a_textType;
+    m_fileName  = a_filename;
+    m_error     = 0;
+
+    Close();    // if opened previous, it will reinitialize/reset the class
+    m_bOk = Open(m_fileName, wxCSConv(wxFONTENCODING_CP437));
+    if (m_access != READ)
+    {
+        if (m_bOk)
+        {
+            if ( m_access == WRITE) Clear(); // empty existing file
+        }
+        else
+        {
+            m_bOk = Create();    // create file if it does not yet exists
+            if (m_bOk)
+                m_bOk = Open(m_fileName);
+        }
+    }
+}   // MyCreate()
+
+bool MyTextFile::IsOk() const
+{
+    return m_bOk;
+}   // IsOk()
+
+MyTextFile::~MyTextFile()
+{
+    Flush();
+}   // ~MyTextFile()
+
+void MyTextFile::Flush()
+{
+    if (IsOpened() && ( m_access != READ) )
+        m_bOk = WriteTo(GetName());     // write changes to disk
+}   // Flush()
+
+bool MyTextFile::WriteTo(const wxString& a_filename) const
+{
+    MyTextWriter writer(a_filename, m_textType);
+    for (size_t line = 0; line < GetLineCount(); ++line)
+        writer.AddLine(GetLine(line));
+    return writer.Commit();
+}   // WriteTo()
+
+/****************** end MyTextFile **********************/
+
+/****************** MyTextWriter **********************/
+static constexpr size_t WRITER_BUFFER_SIZE = 64 * 1024;    // write to disk when this size is reached
+static constexpr size_t CP437_TABLE_SIZE   = 0x25A1;       // highest unicode char in CP437 is 0x25A0
+
+static const std::array<unsigned char, CP437_TABLE_SIZE>& GetCp437Table()
+{   // unicode -> CP437, 0 if there is no CP437 char for it. Lower half is plain ascii, like wxCSConv does
+    static const auto table = []
+    {
+        static const wchar_t upperHalf[128] =
+        {   // unicode for CP437 chars 0x80 - 0xFF
+              0x00C7, 0x00FC, 0x00E9, 0x00E2, 0x00E4, 0x00E0, 0x00E5, 0x00E7, 0x00EA, 0x00EB, 0x00E8, 0x00EF, 0x00EE, 0x00EC, 0x00C4, 0x00C5
+            , 0x00C9, 0x00E6, 0x00C6, 0x00F4, 0x00F6, 0x00F2, 0x00FB, 0x00F9, 0x00FF, 0x00D6, 0x00DC, 0x00A2, 0x00A3, 0x00A5, 0x20A7, 0x0192
+            , 0x00E1, 0x00ED, 0x00F3, 0x00FA, 0x00F1, 0x00D1, 0x00AA, 0x00BA, 0x00BF, 0x2310, 0x00AC, 0x00BD, 0x00BC, 0x00A1, 0x00AB, 0x00BB
+            , 0x2591, 0x2592, 0x2593, 0x2502, 0x2524, 0x2561, 0x2562, 0x2556, 0x2555, 0x2563, 0x2551, 0x2557, 0x255D, 0x255C, 0x255B, 0x2510
+            , 0x2514, 0x2534, 0x252C, 0x251C, 0x2500, 0x253C, 0x255E, 0x255F, 0x255A, 0x2554, 0x2569, 0x2566, 0x2560, 0x2550, 0x256C, 0x2567
+            , 0x2568, 0x2564, 0x2565, 0x2559, 0x2558, 0x2552, 0x2553, 0x256B, 0x256A, 0x2518, 0x250C, 0x2588, 0x2584, 0x258C, 0x2590, 0x2580
+            , 0x03B1, 0x00DF, 0x0393, 0x03C0, 0x03A3, 0x03C3, 0x00B5, 0x03C4, 0x03A6, 0x0398, 0x03A9, 0x03B4, 0x221E, 0x03C6, 0x03B5, 0x2229
+            , 0x2261, 0x00B1, 0x2265, 0x2264, 0x2320, 0x2321, 0x00F7, 0x2248, 0x00B0, 0x2219, 0x00B7, 0x221A, 0x207F, 0x00B2, 0x25A0, 0x00A0
+        };
+        std::array<unsigned char, CP437_TABLE_SIZE> result{};
+        for (unsigned int ch = 1; ch < 0x80; ++ch)
+            result[ch] = static_cast<unsigned char>(ch);
+        for (unsigned int index = 0; index < 128; ++index)
+            result[upperHalf[index]] = static_cast<unsigned char>(0x80 + index);
+        return result;
+    }();
+    return table;
+}   // GetCp437Table()
+
+MyTextWriter::MyTextWriter(const wxString& a_filename, wxTextFileType a_textType)
+    : m_fileName(a_filename), m_eol(wxTextFile::GetEOL(a_textType))
+{
+    m_bOk = m_file.Open(a_filename);
+    m_buffer.reserve(WRITER_BUFFER_SIZE + 1024);
+}   // MyTextWriter()
+
+void MyTextWriter::Append(const wxString& a_text)
+{   // as the wxCSConv(CP437) of wxTextFile::Write(): a char without a CP437 equivalent fails the whole write
+    const auto& table = GetCp437Table();
+    for (const auto ch : a_text)
+    {
+        auto value = static_cast<size_t>(ch.GetValue());
+        unsigned char byte = value < table.size() ? table[value] : 0;
+        if (byte == 0 && value != 0)
+        {   // the file is not replaced
+            if (m_bOk)
+                MyLogError(_("Writing <%s>: no CP437 character for U+%04zX in <%s>"), m_fileName, value, a_text);
+            m_bOk = false;
+            continue;
+        }
+        m_buffer.push_back(static_cast<char>(byte));
+    }
+}   // Append()
+
+void MyTextWriter::AddLine(const wxString& a_line)
+{
+    Append(a_line);
+    Append(m_eol);
+    if (m_buffer.size() >= WRITER_BUFFER_SIZE)
+        WriteBuffer();
+}   // AddLine()
+
+void MyTextWriter::WriteBuffer()
+{
+    if (m_bOk && !m_buffer.empty())
+        m_bOk = m_file.Write(m_buffer.data(), m_buffer.size());
+    m_buffer.clear();
+}   // WriteBuffer()
+
+bool MyTextWriter::Commit()
+{
+    WriteBuffer();
+    if (m_bOk)
+        m_bOk = m_file.Commit();
+    return m_bOk;
+}   // Commit()
+
+/****************** end MyTextWriter **********************/
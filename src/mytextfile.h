@@ -0,0 +1,58 @@
+﻿// Copyright(c) 2024-present, BusyHarry/h.levels & BridgeWx contributors.
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#if !defined _MYTEXTFILE_H_
+#define _MYTEXTFILE_H_
+#pragma once
+
+#include <wx/textfile.h>
+#include <wx/file.h>
+#include <wx/string.h>
+#include <string>
+
+class MyTextFile : public wxTextFile
+{   // wrapper around wxTextFile with buildin CP437 conversion for read/write
+public:
+    enum AccessType
+    {
+          READ
+        , WRITE
+        , READ_WRITE
+    };
+    MyTextFile() = default;
+    explicit MyTextFile(const wxString& filename, AccessType access = READ, wxTextFileType textType = wxTextFileType_Dos);
+    ~MyTextFile() final;
+    void MyCreate(const wxString& filename, AccessType access = READ, wxTextFileType textType= wxTextFileType_Dos);
+    bool IsOk() const;
+    void  Flush();
+    bool  WriteTo(const wxString& filename) const;  // write all lines to another file, the content stays
+private:
+    AccessType      m_access    = READ;
+    wxTextFileType  m_textType  = wxTextFileType_Dos;
+    wxString        m_fileName;
+    int             m_error     = -1;
+    bool            m_bOk       = false;
+};
+
+class MyTextWriter
+{   // buffered CP437 writer: lines are converted into a small buffer that is written when full,
+    // so there is no converted copy of the whole file. The lines themselves are still the caller's,
+    // e.g. the lines of a MyTextFile. The file is replaced on Commit(), not before and not on an error.
+public:
+    explicit MyTextWriter(const wxString& filename, wxTextFileType textType = wxTextFileType_Dos);
+    ~MyTextWriter() = default;      // not committed: the original file stays as it was
+    void AddLine(const wxString& line);
+    bool Commit ();                 // write the remaining data and replace the file, returns IsOk()
+    bool IsOk   () const {return m_bOk;}
+private:
+    void Append     (const wxString& text);
+    void WriteBuffer();
+
+    wxTempFile      m_file;
+    wxString        m_fileName;
+    std::string     m_buffer;       // converted, not yet written data
+    wxString        m_eol;
+    bool            m_bOk = false;
+};
+
+#endif
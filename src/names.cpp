@@ -15,6 +15,7 @@
 #include "cfg.h"
 #include "names.h"
 #include "fileio.h"
+#include "uilink.h"
 
 namespace names
 {
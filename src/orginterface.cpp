@@ -7,6 +7,8 @@
 #include <wx/ffile.h>
 
 #include "orginterface.h"
+#include "mytextfile.h"
+#include "uilink.h"
 
 #define TEST 0      /* filenames get extra extension ".tst" */
 /*
@@ -912,14 +914,22 @@ namespace  org
         return !bError;
     }   //ScoresRead()
 
+    wxString ScoresFile(UINT a_session)
+    {
+        return _ConstructFilename( cfg::EXT_SESSION_SCORE, a_session );
+    }   // ScoresFile()
+
     bool ScoresWrite(const vvScoreData& a_scoreData, UINT a_session)
     {
-        wxString scoreFile = _ConstructFilename( cfg::EXT_SESSION_SCORE, a_session );
+        return ScoresWriteFile(a_scoreData, ScoresFile(a_session));
+    }   // ScoresWrite()
 
-        FILE* fp; auto err = fopen_s(&fp, scoreFile, "wb"); MY_UNUSED(err);
+    bool ScoresWriteFile(const vvScoreData& a_scoreData, const wxString& a_scoreFile)
+    {   // no cfg data used: can be called by the write-behind thread with a file of the moment of the write
+        FILE* fp; auto err = fopen_s(&fp, a_scoreFile, "wb"); MY_UNUSED(err);
         if (fp == nullptr)
         {
-            MyMessageBox(scoreFile + _(": open error"), _("Problem opening score-file"));
+            MyMessageBox(a_scoreFile + _(": open error"), _("Problem opening score-file"));
             return false;
         }
 
@@ -966,11 +976,11 @@ namespace  org
         (void)fclose(fp);
         if (bError)
         {
-            MyMessageBox(scoreFile + _(": write error"), _("Problem writing score-file"));
+            MyMessageBox(a_scoreFile + _(": write error"), _("Problem writing score-file"));
         }
 
         return !bError;
-    }   //ScoresWrite()
+    }   //ScoresWriteFile()
 
     static bool WriteBinairyUSHORT(const std::vector<unsigned int>& a_vUINT, const wxString& a_file)
     {
@@ -1249,4 +1259,90 @@ namespace  org
         return CorrectionsEndRead(fileName, a_mSessionResult, false, true);
     }   // SessionResultRead()
 
+    bool SessionTotalsWrite(const cor::mCumulativeTotals& a_mTotals, UINT a_session)
+    {   // no totals: remove the file, if present
+        wxString fileName = _ConstructFilename(cfg::EXT_SESSION_TOTALS, a_session);
+        if ( a_mTotals.empty() )
+            return !wxFile::Exists(fileName) || wxRemoveFile(fileName);
+        MyTextFile file(fileName, MyTextFile::WRITE);
+        if (!file.IsOk()) return false;
+        file.AddLine(_(";glbpair total.3 games*score.3 bonus.3 games active absent nototal weighted"));
+        for (const auto&[pair, data] : a_mTotals)
+        {
+            file.AddLine(FMT("%3u %9s %10s %8s %5u %2u %2u %2u %u",
+                pair,                                   // global pairnr
+                data.totalN.AsString3(),                // exact sums: 3 decimals
+                data.totalGameScoreW.AsString3(),
+                data.bonus.AsString3(),
+                data.gameCount,
+                data.activeSessions,
+                data.absentCount,
+                data.noTotalCount,
+                data.bWeightedAvg ? 1U : 0U));
+        }
+        return true;
+    }   // SessionTotalsWrite()
+
+    bool SessionTotalsRead(cor::mCumulativeTotals& a_mTotals, UINT a_session)
+    {   // totals are derived data: on error, just return false and let the caller recalculate them
+        a_mTotals.clear();
+        wxString fileName = _ConstructFilename(cfg::EXT_SESSION_TOTALS, a_session);
+        if (!wxFile::Exists(fileName)) return true;     // no totals, but no error!
+        MyTextFile tfile(fileName, MyTextFile::READ);
+        if (!tfile.IsOk()) return false;
+        for (wxString str = tfile.GetFirstLine(); !tfile.Eof(); str = tfile.GetNextLine())
+        {
+            str.Trim(TRIM_LEFT); str.Trim(TRIM_RIGHT);
+            if ( str.IsEmpty() || str[0] == ';' ) continue;
+
+            cor::CUMULATIVE_TOTAL total;
+            char totalBuf[15 + 1] = { 0 };
+            char scoreBuf[15 + 1] = { 0 };
+            char bonusBuf[15 + 1] = { 0 };
+            UINT pairNr, bWeighted;
+            auto count = wxSscanf(str, "%u %15s %15s %15s %u %u %u %u %u", &pairNr, totalBuf, scoreBuf, bonusBuf,
+                &total.gameCount, &total.activeSessions, &total.absentCount, &total.noTotalCount, &bWeighted);
+            if (count != 9)
+            {
+                MyLogError(_("Reading session totals: <%s> invalid!"), str);
+                a_mTotals.clear();
+                return false;
+            }
+            total.totalN          = Fdp(totalBuf);
+            total.totalGameScoreW = Fdp(scoreBuf);
+            total.bonus           = Fdp(bonusBuf);
+            total.bWeightedAvg    = bWeighted != 0;
+            a_mTotals[pairNr]     = total;
+        }
+        return true;
+    }   // SessionTotalsRead()
+
+    bool CalcCacheWrite(const wxString& a_cache, UINT a_session)
+    {   // no cache: remove the file, if present
+        wxString fileName = _ConstructFilename(cfg::EXT_SESSION_CALC_CACHE, a_session);
+        if ( a_cache.IsEmpty() )
+            return !wxFile::Exists(fileName) || wxRemoveFile(fileName);
+        MyTextFile file(fileName, MyTextFile::WRITE);
+        if (!file.IsOk()) return false;
+        for (const auto& line : wxSplit(a_cache, '\n', '\0'))
+            file.AddLine(line);
+        file.Flush();
+        return file.IsOk();
+    }   // CalcCacheWrite()
+
+    bool CalcCacheRead(wxString& a_cache, UINT a_session)
+    {
+        a_cache.clear();
+        wxString fileName = _ConstructFilename(cfg::EXT_SESSION_CALC_CACHE, a_session);
+        if (!wxFile::Exists(fileName)) return true;     // no cache, but no error!
+        MyTextFile tfile(fileName, MyTextFile::READ);
+        if (!tfile.IsOk()) return false;
+        for (size_t line = 0; line < tfile.GetLineCount(); ++line)
+        {
+            if (line) a_cache += '\n';
+            a_cache += tfile.GetLine(line);
+        }
+        return true;
+    }   // CalcCacheRead()
+
 } // namespace org
@@ -9,6 +9,8 @@
 namespace org
 {
     #include "interfaces.h"
+    wxString ScoresFile     (UINT session);     // the file ScoresWrite() writes for this session, as it is now
+    bool     ScoresWriteFile(const vvScoreData& scoreData, const wxString& scoreFile);
 } // namespace org
 
 #endif // _ORGINTERFACE_H_
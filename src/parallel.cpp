@@ -0,0 +1,128 @@
+﻿// Copyright(c) 2024-present, BusyHarry/h.levels & BridgeWx contributors.
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#include <algorithm>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+
+#include "parallel.h"
+
+namespace { // anonymous namespace for the worker pool of ParallelFor()
+    struct ParallelJob
+    {   // one ParallelFor() call: the caller and the pool threads take the next free index until all are done
+        ParallelJob(UINT a_count, const std::function<void(UINT index)>& a_func) : count(a_count), func(a_func) {}
+
+        void Work()
+        {   // an exception stops the job: the caller rethrows it
+            try
+            {
+                for (UINT index = nextIndex++; index < count; index = nextIndex++)
+                    func(index);
+            }
+            catch (...)
+            {
+                std::scoped_lock lock(mutex);
+                if (!exception) exception = std::current_exception();
+                nextIndex = count;
+            }
+        }   // Work()
+
+        const UINT                                  count;
+        const std::function<void(UINT index)>&      func;       // only used while the caller waits
+        std::atomic<UINT>                           nextIndex{0};
+        std::mutex                                  mutex;
+        std::condition_variable                     cvDone;
+        UINT                                        helpers = 0;        // pool threads working on this job
+        bool                                        bDone   = false;    // caller has returned: helpers must not start anymore
+        std::exception_ptr                          exception;
+    };
+
+    class WorkerPool
+    {   // persistent worker threads, started on first use: no thread creation for each ParallelFor()
+    public:
+        static WorkerPool& Get()
+        {
+            static WorkerPool pool;
+            return pool;
+        }   // Get()
+
+        UINT Size() const {return static_cast<UINT>(m_threads.size());}
+
+        void Help(const std::shared_ptr<ParallelJob>& a_pJob, UINT a_helpers)
+        {   // let a_helpers threads join the job, if they are free before it is done
+            {
+                std::scoped_lock lock(m_mutex);
+                for (UINT helper = 0; helper < a_helpers; ++helper)
+                    m_jobs.push_back(a_pJob);
+            }
+            m_cvJobs.notify_all();
+        }   // Help()
+
+    private:
+        WorkerPool()
+        {   // the threads are stopped and joined by the destructor of m_threads
+            UINT threadCount = std::max(std::thread::hardware_concurrency(), 1U) - 1;   // the caller also works
+            for (UINT thread = 0; thread < threadCount; ++thread)
+                m_threads.emplace_back([this](std::stop_token a_stop){ Worker(a_stop); });
+        }
+
+        void Worker(std::stop_token a_stop)
+        {
+            for (;;)
+            {
+                std::shared_ptr<ParallelJob> pJob;
+                {
+                    std::unique_lock lock(m_mutex);
+                    if (!m_cvJobs.wait(lock, a_stop, [this]{ return !m_jobs.empty(); }))
+                        return;     // stopped
+                    pJob = std::move(m_jobs.front());
+                    m_jobs.pop_front();
+                }
+                {
+                    std::scoped_lock lock(pJob->mutex);
+                    if (pJob->bDone || pJob->nextIndex >= pJob->count) continue;   // nothing left to do
+                    ++pJob->helpers;
+                }
+                pJob->Work();
+                {
+                    std::scoped_lock lock(pJob->mutex);
+                    --pJob->helpers;
+                }
+                pJob->cvDone.notify_all();
+            }
+        }   // Worker()
+
+        std::deque<std::shared_ptr<ParallelJob> >   m_jobs;
+        std::mutex                                  m_mutex;
+        std::condition_variable_any                 m_cvJobs;
+        std::vector<std::jthread>                   m_threads;      // last member: stopped before the others are destroyed
+    };  // class WorkerPool
+}   // namespace
+
+void ParallelFor(UINT a_count, const std::function<void(UINT index)>& a_func)
+{   // the caller works too and only waits for the pool threads that joined: so a busy pool (or a call
+    // from a pool thread) never blocks, the caller then just does all the work itself
+    WorkerPool& pool    = WorkerPool::Get();
+    UINT        helpers = std::min(pool.Size(), a_count > 0 ? a_count - 1 : 0);
+    if (helpers == 0)
+    {   // no use to wake threads
+        for (UINT index = 0; index < a_count; ++index)
+            a_func(index);
+        return;
+    }
+
+    auto pJob = std::make_shared<ParallelJob>(a_count, a_func);
+    pool.Help(pJob, helpers);
+    pJob->Work();
+    std::unique_lock lock(pJob->mutex);
+    pJob->cvDone.wait(lock, [&pJob](){return pJob->helpers == 0;});
+    pJob->bDone = true;     // late helpers will skip this job, a_func may go out of scope now
+    if (pJob->exception)
+        std::rethrow_exception(pJob->exception);
+}   // ParallelFor()
@@ -0,0 +1,15 @@
+﻿// Copyright(c) 2024-present, BusyHarry/h.levels & BridgeWx contributors.
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#if !defined _PARALLEL_H_
+#define _PARALLEL_H_
+
+#include <functional>
+
+using UINT = unsigned int;
+
+// call a_func(index) for index = 0..count-1 on a persistent pool of worker threads (max hardware cores)
+// returns after ALL calls are done. a_func must only change data for its own index!
+// an exception in a_func stops the remaining calls and is rethrown here
+void ParallelFor(UINT count, const std::function<void(UINT index)>& a_func);
+#endif
@@ -926,8 +926,25 @@ void MyLinePrinter::PrintTable(const table::TableInfo& table)
 
 // external callable functions
 
+static void SyncWithCfg()
+{   // the printer settings are kept by cfg: take them over when they are changed, before the printer is used
+    static wxString ssPrinterName;
+    static UINT     suLinesPerPage = 0;
+    if (cfg::GetPrinterName() != ssPrinterName)
+    {
+        ssPrinterName = cfg::GetPrinterName();
+        thePrintclass.SetPrinterName(ssPrinterName);
+    }
+    if (cfg::GetLinesPerPage() != suLinesPerPage)
+    {
+        suLinesPerPage = cfg::GetLinesPerPage();
+        thePrintclass.SetLinesPerPage(static_cast<int>(suLinesPerPage));
+    }
+}   // SyncWithCfg()
+
 bool BeginPrint(const wxString& a_title)
 {
+    SyncWithCfg();
     return thePrintclass.BeginPrint(a_title);
 }   // BeginPrint()
 
@@ -943,16 +960,19 @@ void SetPrinterName(const wxString& a_printerName)
 
 bool PrintCharacter(wxChar a_char)
 {
+    SyncWithCfg();
     return thePrintclass.PrintCharacter(a_char);
 }   // PrintCharacter()
 
 bool PrintLine(const wxString& a_line)
 {
+    SyncWithCfg();
     return thePrintclass.PrintLine(a_line);
 }   // PrintLine()
 
 const wxString& GetPrinterName()
 {
+    SyncWithCfg();
     return thePrintclass.GetPrinterName();
 }   // GetPrinterName()
 
@@ -973,11 +993,13 @@ void SelectFont()
 
 bool PrintAFile(const wxString& a_fileName, const wxString& a_title)
 {
+    SyncWithCfg();
     return thePrintclass.PrintAFile( a_fileName, a_title );
 }   // PrintAFile()
 
 bool SelectPrinter()
 {
+    SyncWithCfg();
     return thePrintclass.SelectPrinter();
 }   // SelectPrinter()
 
@@ -988,21 +1010,25 @@ void SetLinesPerPage(int a_lines)
 
 UINT GetLinesPerPage ()
 {
+    SyncWithCfg();
     return thePrintclass.GetLinesPerPage();
 }   // GetLinesPerPage()
 
 void PrintTable(const table::TableInfo& table)
 {
+    SyncWithCfg();
     thePrintclass.PrintTable(table);
 }   // PrintTable()
 
 unsigned int GetCharsPerLine()
 {
+    SyncWithCfg();
     return thePrintclass.GetCharsPerLine();
 }   // GetCharsPerLine()
 
 bool IsPrintToFile()
 {
+    SyncWithCfg();
     return thePrintclass.IsPrintToFile();
 }  // IsPrintToFile()
 
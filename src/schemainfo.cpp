@@ -16,7 +16,7 @@
 #include "schemainfo.h"
 #include "myLog.h"
 #include "importexportschema.h"
-#include "baseframe.h"
+#include "uilink.h"
 
 #define   SET(round,table) (*m_pSchema).tableData[round][table].set
 
@@ -10,14 +10,12 @@
 #include "fileio.h"
 
 static vvScoreData svGameSetData;
+static std::vector<UINT> svGamesPlayed;     // [sessionPair] -> number of games played, empty if not yet counted
 
 namespace score
 {
 
 static constexpr auto CURRENT_TYPE      = 1;        // version of datastorage
-static constexpr auto MAX_REAL          = 8000;     // for 'normal' score
-static constexpr auto OFFSET_PROCENT    = 9000;     // adjusted score in %
-static constexpr auto OFFSET_REAL       = 20000;    // adjusted score asif it was 'normal'
 static constexpr auto NS                = 0;        // index in data for N/S pair
 static constexpr auto EW                = 1;        // index in data for E/W pair
 
@@ -25,19 +23,28 @@ UINT GetNumberOfGamesPlayedByGlobalPair(UINT a_globalPairnr)
 {
     ReadScoresFromDisk();
     UINT sessionPair = names::PairnrGlobal2SessionPairnr(a_globalPairnr);
-    UINT count = 0;
-    for (const auto& itGame : svGameSetData)
-    {
-        for (const auto& itSet : itGame)
+    if (svGamesPlayed.empty())
+    {   // count for all pairs at once: one pass over all scores
+        svGamesPlayed.resize(1);
+        for (const auto& itGame : svGameSetData)
         {
-            if ( itSet.pairNS == sessionPair || itSet.pairEW == sessionPair)
+            std::vector<UINT> pairs;    // a pair is only counted once per game
+            for (const auto& itSet : itGame)
+            {
+                pairs.push_back(itSet.pairNS);
+                pairs.push_back(itSet.pairEW);
+            }
+            std::ranges::sort(pairs);
+            auto [first, last] = std::ranges::unique(pairs);
+            pairs.erase(first, last);
+            for (auto pair : pairs)
             {
-                ++count;
-                break;
+                if (pair >= svGamesPlayed.size()) svGamesPlayed.resize(pair+1ULL, 0);
+                ++svGamesPlayed[pair];
             }
         }
     }
-    return count;
+    return sessionPair < svGamesPlayed.size() ? svGamesPlayed[sessionPair] : 0;
 }   // GetNumberOfGamesPlayedByGlobalPair()
 
 bool WriteSessionRank(const std::vector<unsigned int>& a_vSessionRank)
@@ -71,6 +78,7 @@ void SetScoreData(const vvScoreData& newData )
     if (newData != svGameSetData)
     {
         svGameSetData = newData;
+        svGamesPlayed.clear();
         WriteScoresToDisk();
         (void)ConfigChanged(true);
     }
@@ -80,6 +88,7 @@ void ReadScoresFromDisk()
 {
     if (!ConfigChanged()) return;
     io::ScoresRead(svGameSetData, cfg::GetActiveSession());
+    svGamesPlayed.clear();
 }   // ReadScoresFromDisk()
 
 void WriteScoresToDisk()
@@ -97,84 +106,6 @@ void WriteScoresToDisk()
     io::ScoresWrite(svGameSetData, cfg::GetActiveSession());
 }   // WriteScoresToDisk()
 
-UINT GetNumberOfGames(const vvScoreData* a_scoreData)
-{
-    const vvScoreData& scores = a_scoreData == nullptr ? svGameSetData : *a_scoreData;
-    auto count = scores.size();
-    if (count == 0) return 0;
-    for (--count; count; --count)
-    {
-        if (scores[count].size()) break;
-    }
-
-    return (UINT)count;
-}   // GetNumberOfGames()
-
-bool IsReal(int a_score)
-{   // remark: this is NOT a test if its a valid score, only the possible catagory is determined!
-    return (a_score < MAX_REAL) && (a_score != SCORE_NP);  // above MAXREAL we have % scores or 'normal' adjusted scores
-}   // IsReal()
-
-bool IsProcent(int a_score)
-{
-    return (a_score >= OFFSET_PROCENT) &&  (a_score <= OFFSET_PROCENT + 100);
-}   // IsProcent()
-
-wxString ScoreToString(int a_score)
-{
-    wxString result;
-
-    if (a_score == SCORE_NONE)
-    {
-        return result;              // empty if no score
-    }
-
-    if (a_score == SCORE_NP)
-    {
-        return _("NP");                // not played
-    }
-
-    if (abs(a_score) > MAX_REAL)
-    {   // filter special cases
-        if ((a_score >= OFFSET_REAL - MAX_REAL) && (a_score <= OFFSET_REAL + MAX_REAL))
-        {
-            a_score -= OFFSET_REAL;     // a real adjusted score
-            result = 'R';
-        }
-        else if (score::IsProcent(a_score))
-        {
-            a_score -= OFFSET_PROCENT;  // an adjusted % score
-            result = '%';
-        }
-        else
-            result = "???";
-    }
-
-    return result + FMT("%i", a_score);
-}   // ScoreToString()
-
-int ScoreFromString(const wxString& a_score)
-{
-    wxString tmp = a_score;
-    tmp.Trim(TRIM_RIGHT);
-    tmp.Trim(TRIM_LEFT);
-    tmp.MakeUpper();
-
-    if (tmp.IsEmpty()) return SCORE_NONE;
-    int score = 0;
-    UINT uScore;
-    wxChar chr;
-    constexpr auto BAD_SCORE = 1; /* returned value, if input somehow not ok*/
-
-#define FORCE_INRANGE(x) std::clamp((x), -MAX_REAL+1, MAX_REAL-1) /* force 'real' score to be (absolute) less then MAX_REAL*/
-    if ( 1 == wxSscanf(tmp," %i %c"  , &score , &chr)) return FORCE_INRANGE(score);                     // 'normal' score
-    if ( 1 == wxSscanf(tmp," %%%u %c", &uScore, &chr)) return std::min(uScore,101U)+OFFSET_PROCENT;     // % score
-    if ( 1 == wxSscanf(tmp," R%i %c" , &score , &chr)) return FORCE_INRANGE(score)+OFFSET_REAL;         // 'real' aribitrary score
-    if ( (tmp == _("NP")) || (tmp == "NP") )    // remark: one fixed "NP" and one translatable
-        return SCORE_NP;
-    return BAD_SCORE;   // bad score, rangecheck will get it
-}   // ScoreFromString()
-
 char VulnerableChar(UINT a_game, bool a_bNS)
 {
     static const char nsInfo[] = " * ** *  * ** * ";    /* 2,4,5,7,10,12,13,15 */
@@ -297,24 +228,10 @@ ScoreValidation IsScoreValid(int a_score, UINT a_game, bool a_bNS)
     return FindScore(-a_score, score::IsVulnerable  (a_game,!a_bNS), SPECIAL);      //  NS <->EW
 }   // IsScoreValid()
 
-int Score2Real(int score)
-{
-    if ((score >= OFFSET_REAL-MAX_REAL) && (score <= OFFSET_REAL+MAX_REAL))
-        score -= OFFSET_REAL;      //separation in % and 'real' scores
-    return score;
-}   // Score2Real()
-
-int Procentscore2Procent(int score)
+UINT GetNumberOfGames(const vvScoreData* a_scoreData)
 {
-    return score - OFFSET_PROCENT;
-}   // Procentscore2Procent()
-
-int ScoreEwToNs(int ewScore)
-{   // remark: scores are real or % scores, so we don't need to check for real adjusted scores
-    if (score::IsProcent(ewScore))
-        return 100+2*OFFSET_PROCENT-ewScore;
-    return -ewScore;
-}   // ScoreEwToNs()
+    return GetNumberOfGames(a_scoreData == nullptr ? svGameSetData : *a_scoreData);
+}   // GetNumberOfGames()
 
 bool ExistGameData()
 {
@@ -347,6 +264,7 @@ bool AdjustPairNrs(UINT a_fromPair, int a_delta)
         }
     }
 
+    if (bChanged) svGamesPlayed.clear();
     return bChanged;
 }   // AdjustPairnr()
 
@@ -366,6 +284,7 @@ bool DeleteScoresFromPair(UINT a_pair)
         }
     }
 
+    if (bDeleted) svGamesPlayed.clear();
     return bDeleted;
 }   // DeleteScoresFromPair()
 
@@ -39,6 +39,10 @@ using vvScoreData = std::vector< std::vector<score::GameSetData> > ; // vv=vecto
 
 namespace score
 {
+    static constexpr auto MAX_REAL          = 8000;     // for 'normal' score
+    static constexpr auto OFFSET_PROCENT    = 9000;     // adjusted score in %
+    static constexpr auto OFFSET_REAL       = 20000;    // adjusted score asif it was 'normal'
+
     enum ScoreValidation
     {
           ScoreValid    // a valid possible score
@@ -50,6 +54,7 @@ namespace score
     const vvScoreData*  GetScoreData();                                 // get a ptr to the current scores
     void                SetScoreData(const vvScoreData&);               // update the scores (write to disk)
     UINT                GetNumberOfGames(const vvScoreData* a_scoreData = nullptr); // highest gamenr that is played in a session
+    UINT                GetNumberOfGames(const vvScoreData& a_scoreData);           // same, without using the current scores
     bool                IsReal(int score);                              // checks if score is real (not adjusted)
     bool                IsProcent(int score);                           // checks if its a '%' score
     wxString            ScoreToString(int score);                       // get string representation of score
@@ -59,6 +64,7 @@ namespace score
     ScoreValidation     IsScoreValid(int score, UINT game, bool bNS);   // checks if a score is valid
     int                 Score2Real(int score);                          // make adjusted real score into real score
     int                 Procentscore2Procent(int score);                // convert aribitrairy score to 0<=value<=100
+    int                 Procent2Procentscore(int procent);              // convert 0<=value<=100 to a %-score
     UINT                GetNumberOfGamesPlayedByGlobalPair(UINT globalPairnr);
     bool                ExistGameData();                                // true, if there is atleast one score entered
     bool                AdjustPairNrs(UINT fromPair, int delta);        // adjust all pairnrs in the scoredata starting from 'frompair' with 'delta', return true if one or more changes
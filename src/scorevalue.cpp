@@ -0,0 +1,118 @@
+﻿// Copyright(c) 2024-present, BusyHarry/h.levels & BridgeWx contributors.
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+// conversion of score values: no global state, so also usable by the calculation engine
+#include <wx/string.h>
+#include <wx/intl.h>
+#include <wx/wxcrtvararg.h>
+#include <algorithm>
+#include <vector>
+
+#include "utils.h"
+#include "score.h"
+
+namespace score
+{
+
+UINT GetNumberOfGames(const vvScoreData& a_scoreData)
+{
+    auto count = a_scoreData.size();
+    if (count == 0) return 0;
+    for (--count; count; --count)
+    {
+        if (a_scoreData[count].size()) break;
+    }
+
+    return (UINT)count;
+}   // GetNumberOfGames()
+
+bool IsReal(int a_score)
+{   // remark: this is NOT a test if its a valid score, only the possible catagory is determined!
+    return (a_score < MAX_REAL) && (a_score != SCORE_NP);  // above MAXREAL we have % scores or 'normal' adjusted scores
+}   // IsReal()
+
+bool IsProcent(int a_score)
+{
+    return (a_score >= OFFSET_PROCENT) &&  (a_score <= OFFSET_PROCENT + 100);
+}   // IsProcent()
+
+wxString ScoreToString(int a_score)
+{
+    wxString result;
+
+    if (a_score == SCORE_NONE)
+    {
+        return result;              // empty if no score
+    }
+
+    if (a_score == SCORE_NP)
+    {
+        return _("NP");                // not played
+    }
+
+    if (abs(a_score) > MAX_REAL)
+    {   // filter special cases
+        if ((a_score >= OFFSET_REAL - MAX_REAL) && (a_score <= OFFSET_REAL + MAX_REAL))
+        {
+            a_score -= OFFSET_REAL;     // a real adjusted score
+            result = 'R';
+        }
+        else if (score::IsProcent(a_score))
+        {
+            a_score -= OFFSET_PROCENT;  // an adjusted % score
+            result = '%';
+        }
+        else
+            result = "???";
+    }
+
+    return result + FMT("%i", a_score);
+}   // ScoreToString()
+
+int ScoreFromString(const wxString& a_score)
+{
+    wxString tmp = a_score;
+    tmp.Trim(TRIM_RIGHT);
+    tmp.Trim(TRIM_LEFT);
+    tmp.MakeUpper();
+
+    if (tmp.IsEmpty()) return SCORE_NONE;
+    int score = 0;
+    UINT uScore;
+    wxChar chr;
+    constexpr auto BAD_SCORE = 1; /* returned value, if input somehow not ok*/
+
+#define FORCE_INRANGE(x) std::clamp((x), -MAX_REAL+1, MAX_REAL-1) /* force 'real' score to be (absolute) less then MAX_REAL*/
+    if ( 1 == wxSscanf(tmp," %i %c"  , &score , &chr)) return FORCE_INRANGE(score);                     // 'normal' score
+    if ( 1 == wxSscanf(tmp," %%%u %c", &uScore, &chr)) return std::min(uScore,101U)+OFFSET_PROCENT;     // % score
+    if ( 1 == wxSscanf(tmp," R%i %c" , &score , &chr)) return FORCE_INRANGE(score)+OFFSET_REAL;         // 'real' aribitrary score
+    if ( (tmp == _("NP")) || (tmp == "NP") )    // remark: one fixed "NP" and one translatable
+        return SCORE_NP;
+    return BAD_SCORE;   // bad score, rangecheck will get it
+}   // ScoreFromString()
+
+int Score2Real(int score)
+{
+    if ((score >= OFFSET_REAL-MAX_REAL) && (score <= OFFSET_REAL+MAX_REAL))
+        score -= OFFSET_REAL;      //separation in % and 'real' scores
+    return score;
+}   // Score2Real()
+
+int Procentscore2Procent(int score)
+{
+    return score - OFFSET_PROCENT;
+}   // Procentscore2Procent()
+
+int Procent2Procentscore(int procent)
+{
+    return procent + OFFSET_PROCENT;
+}   // Procent2Procentscore()
+
+int ScoreEwToNs(int ewScore)
+{   // remark: scores are real or % scores, so we don't need to check for real adjusted scores
+    if (score::IsProcent(ewScore))
+        return 100+2*OFFSET_PROCENT-ewScore;
+    return -ewScore;
+}   // ScoreEwToNs()
+
+}   // end of namespace score
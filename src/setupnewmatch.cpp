@@ -50,6 +50,9 @@ SetupNewMatch::SetupNewMatch(wxWindow* a_pParent, UINT a_pageId) : Baseframe(a_p
 // butler or precent score
     m_pChkBoxButler = new wxCheckBox(this, wxID_ANY, _("Butler"));
     m_pChkBoxButler->SetToolTip(_("Type of calculation: percent or butler"));
+    m_pChkBoxCrossImps = new wxCheckBox(this, wxID_ANY, _("Cross-imps"));
+    m_pChkBoxCrossImps->SetToolTip(_("Butler: compare each score with all other scores i.s.o. a datum score"));
+    m_pChkBoxButler->Bind(wxEVT_CHECKBOX, [this](const wxCommandEvent&){m_pChkBoxCrossImps->Enable(m_pChkBoxButler->GetValue());});
 
     // now add all of the above in sets of 2 to a flexgridsizer
     auto fgs = new wxFlexGridSizer(5 /*rows*/, 2 /*columns*/, 9 /*v-gap*/, 25 /*h-gap*/);
@@ -57,7 +60,7 @@ SetupNewMatch::SetupNewMatch(wxWindow* a_pParent, UINT a_pageId) : Baseframe(a_p
     fgs->Add(txtMatch  , 0, wxALIGN_CENTER_VERTICAL);   fgs->Add(m_pComboBoxMatch,  1          );
     fgs->Add(txtSession, 0, wxALIGN_CENTER_VERTICAL);   fgs->Add(m_pTxtCtrlSession, 0          );
     fgs->Add(txtDbType , 0, wxALIGN_CENTER_VERTICAL);   fgs->Add(m_pTxtCtrlDbType , 0          );
-    fgs->Add(m_pChkBoxButler  , 0 );
+    fgs->Add(m_pChkBoxButler  , 0 );                     fgs->Add(m_pChkBoxCrossImps, 0         );
 
     fgs->AddGrowableCol(1, 1);  // column 1 should grow horizontally if possible
 
@@ -128,6 +131,8 @@ void SetupNewMatch::RefreshInfo()
     m_pTxtCtrlSession->SetValue  ( U2String( cfg::GetActiveSession()) );
     m_pTxtCtrlDbType ->SetValue  (cfg::GetDbExtension());
     m_pChkBoxButler  ->SetValue  (cfg::GetButler());
+    m_pChkBoxCrossImps->SetValue (cfg::GetCrossImps());
+    m_pChkBoxCrossImps->Enable   (cfg::GetButler());
 
     UpdateSelection();
     Layout();
@@ -143,6 +148,7 @@ void SetupNewMatch::BackupData()
 
     cfg::HandleCommandline( argv, false );
     cfg::SetButler(m_pChkBoxButler->GetValue());
+    cfg::SetCrossImps(m_pChkBoxCrossImps->GetValue());
 
 }   // BackupData()
 
@@ -168,6 +174,8 @@ void SetupNewMatch::PrintPage()
     prn::PrintLine(FMT("%-13s: %s\n", _("Session"     ), m_pTxtCtrlSession->GetValue()));
     prn::PrintLine(FMT("%-13s: %s\n", _("Databasetype"), m_pTxtCtrlDbType ->GetValue()));
     prn::PrintLine(FMT("%-13s: %s\n", _("Butler"      ), BoolToString(m_pChkBoxButler->GetValue())));
+    if (m_pChkBoxButler->GetValue())
+        prn::PrintLine(FMT("%-13s: %s\n", _("Cross-imps"), BoolToString(m_pChkBoxCrossImps->GetValue())));
 
     prn::PrintLine(cfg::GetCopyrightDateTime());
     prn::EndPrint();
@@ -32,6 +32,7 @@ private:
     MywxComboBox*               m_pComboBoxMatch;
     wxTextCtrl*                 m_pTxtCtrlDbType;
     wxCheckBox*                 m_pChkBoxButler;
+    wxCheckBox*                 m_pChkBoxCrossImps;     // butler: cross-imps i.s.o. datum score
 };
 
 #endif
@@ -2,10 +2,16 @@
 // Distributed under the MIT License (http://opensource.org/licenses/MIT)
 
 #include <wx/wxcrtvararg.h>
+#include <wx/log.h>
+#include <map>
+#include <string>
+#include <algorithm>
+#include <string_view>
 
 #include "sqlite3.h"
 #include "sqlite.h"
 #include "dbglobals.h"
+#include "uilink.h"
 
 /*
 * tables:
@@ -21,8 +27,11 @@ namespace sql
 {
     #define MAIN_TABLE  "main"                      /* name of the main table */
     #define GAME_COL    "GAME"                      /* name of the game column for scores*/
-    #define DATA_COL    "DATA"                      /* name of the data column for scores*/
-    static const long   dbVersion = 100;            // assumed version (or smaller) for the code below
+    #define DATA_COL    "DATA"                      /* name of the data column for scores, before version 101 */
+    #define OLD_SCORES  "gameResult"                /* scores table before version 101: all sets of a game in one text row */
+    #define SET_COLUMNS GAME_COL ",PAIRNS,PAIREW,SCORENS,SCOREEW,CONTRACTNS,CONTRACTEW" /* scores table: a row per set */
+    static const long   dbVersion = 101;            // assumed version (or smaller) for the code below
+                                                    // 101: scores in a row per set i.s.o. a row per game
     static wxString     sqlDbFilename;              // current database, empty if database closed
     static wxString     sqlErrorMsg;                // sql errorstring of last SqlExec()
     static sqlite3*     sqlFp            = nullptr; // ptr to database, nullptr if not open
@@ -37,17 +46,67 @@ namespace sql
     static wxString GetTableName        (keyId id, UINT session = DEFAULT_SESSION);
     static wxString GetColumnName       (keyId id);
     static void     CreateSessionTables (UINT session);
-    static int      SqlExec             (const char* pSql);         // results, if any, are put in 'sqlData'
-    static int      SqlExec             (const wxString& sql);      // results, if any, are put in 'sqlData'
+    static void     UpgradeSessionTables();                     // add columns that are missing in older session tables
+    static bool     UpgradeScoreTables  ();                     // version 100 -> 101: convert the scores to a row per set
+    static int      CreateScoreTable    (UINT session);
+    static int      SqlExec             (const char* pSql);         // no results: use a Cursor for queries
+    static int      SqlExec             (const wxString& sql);      // no results: use a Cursor for queries
     static bool     UintVectorWrite     (const UINT_VECTOR& vUint, UINT session, keyId id);
     static bool     UintVectorRead      (      UINT_VECTOR& vUint, UINT session, keyId id);
-
-    struct ColumnInfo
-    {   // query result for one column
-        wxString name;
-        wxString data;
-    };
-    static std::vector<std::vector<ColumnInfo>> sqlData;   // sqlData[row][col].
+    static void     CloseDatabase       (sqlite3*& pDb);            // finalize its statements, then close it
+
+    // prepared statements: compiled once per database and sql text, values are bound and not part of the sql
+    static std::map<std::pair<sqlite3*, std::string>, sqlite3_stmt*> stmtCache;
+    static sqlite3_stmt* StmtPrepare    (const wxString& sql);      // reset and without bindings, nullptr on error
+    static void     StmtBind            (sqlite3_stmt* pStmt, int index, const wxString& value);
+    static void     StmtBind            (sqlite3_stmt* pStmt, int index, long value);
+    static int      StmtExec            (sqlite3_stmt* pStmt);      // statement without results, it is reset afterwards
+
+    // the scores as they are stored, so a write only needs the changed sets and no read first
+    static std::map<std::pair<sqlite3*, UINT>, vvScoreData> storedScores;  // [database, session]
+
+    class Cursor
+    {   // Steps through the result rows of a query on the current database, the columns of the
+        // current row are read directly from sqlite: no copies of rows that are not used.
+        // All state is in the cursor, so queries on more databases can be active at the same time.
+    public:
+        explicit Cursor(const wxString& sql) : m_pStmt(StmtPrepare(sql)), m_pDb(sqlFp) {}
+        ~Cursor() {if ( m_pStmt ) sqlite3_reset(m_pStmt);}     // release its locks, the statement stays cached
+        Cursor(const Cursor&) = delete;
+        Cursor& operator = (const Cursor&) = delete;
+
+        void Bind(int index, const wxString& value) {StmtBind(m_pStmt, index, value);} // before the first Next()
+        void Bind(int index, long value)            {StmtBind(m_pStmt, index, value);}
+
+        bool Next()
+        {   // go to the next row, false if no more rows or on error
+            if ( m_pStmt == nullptr || m_rc == SQLITE_DONE ) return false;
+            m_rc = sqlite3_step(m_pStmt);
+            if ( m_rc != SQLITE_ROW && m_rc != SQLITE_DONE )
+                MyLogError("sqlite3_step(%s) returned error %d (%s)", sqlite3_sql(m_pStmt), m_rc, sqlite3_errmsg(m_pDb));
+            return m_rc == SQLITE_ROW;
+        }   // Next()
+
+        bool IsOk() const {return m_pStmt != nullptr && (m_rc == SQLITE_OK || m_rc == SQLITE_ROW || m_rc == SQLITE_DONE);}
+
+        // columns of the current row, only valid after Next() returned true
+        long Int(int column) const {return static_cast<long>(sqlite3_column_int64(m_pStmt, column));}
+        std::string_view Utf8(int column) const
+        {   // valid till the next call of Next()
+            auto pText = reinterpret_cast<const char*>(sqlite3_column_text(m_pStmt, column));
+            return pText ? std::string_view(pText, static_cast<size_t>(sqlite3_column_bytes(m_pStmt, column))) : std::string_view();
+        }   // Utf8()
+        wxString Text(int column) const
+        {   // the sql is written as utf8, so read it back as utf8
+            auto text = Utf8(column);
+            return wxString::FromUTF8(text.data(), text.size());
+        }   // Text()
+
+    private:
+        sqlite3_stmt*   m_pStmt;
+        sqlite3*        m_pDb;
+        int             m_rc = SQLITE_OK;   // result of the last step
+    };  // Cursor
 
 /************** implementation *************/
     static wxString SqlError4MsgBox(const char* a_msg)
@@ -64,11 +123,25 @@ namespace sql
     bool DatabaseClose(io::GlbDbType /*dbType*/)
     {
         sqlDbFilename.clear();
-        if ( sqlFp )            sqlite3_close(sqlFp);            sqlFp            = nullptr;
-        if ( sqlFpGlobalNames ) sqlite3_close(sqlFpGlobalNames); sqlFpGlobalNames = nullptr;
+        CloseDatabase(sqlFp);
+        CloseDatabase(sqlFpGlobalNames);
         return true;
     }   // DatabaseClose()
 
+    static void CloseDatabase(sqlite3*& a_pDb)
+    {   // a database with unfinalized statements can't be closed
+        if ( a_pDb == nullptr ) return;
+        std::erase_if(stmtCache, [a_pDb](const auto& entry)
+            {
+                if ( entry.first.first != a_pDb ) return false;
+                sqlite3_finalize(entry.second);
+                return true;
+            });
+        std::erase_if(storedScores, [a_pDb](const auto& entry) { return entry.first.first == a_pDb; });
+        sqlite3_close(a_pDb);   // will flush pending changes
+        a_pDb = nullptr;
+    }   // CloseDatabase()
+
     static sqlite3* InitDatabase(const wxString& a_dbFile)
     {
         sqlite3* fp;    // local database ptr
@@ -90,7 +163,7 @@ namespace sql
                 " (';info database           : data saved according definition of version <x>')"
                 ",(';info pair names         : <global pairnr> = {<name>,<clubId>}, max size=30')"
                 ",(';info club names         : <club id> = \"club name\", max size=25')"
-                ",(';info game result        : <game nr> = {<ns>,<ew>,<ns result>,<ew result>[,\"ns contract\",\"ew contract\"]}[@ ...]')"
+                ",(';info game result        : table session.<x>.sets, a row per set: <game nr>,<ns>,<ew>,<ns result>,<ew result>,<ns contract>,<ew contract>')"
                 ",(';info schema             : {<nr of games>,<setsize>,<first game>}@{<nr of pairs>,<absent pair>,\"schema\",\"groupChars\"}[@...]')"
                 ",(';info min/max club       : {<min pairs needed>,<max pairs used>}')"
                 ",(';info assignments        : <global pairnr>[@...] -> array[<sessionpair>] = <global pairnr>')"
@@ -101,6 +174,8 @@ namespace sql
                 ",(';info session result     : {<global pairnr>,<score.2>,<games>}[@...]')"
                 ",(';info session rank       : <globalpair>[@...] array[<rank>]=<globalpair>')"
                 ",(';info total rank         : <globalpair>[@...] array[<rank>]=<globalpair>')"
+                ",(';info session totals     : {<global pairnr>,<total.3>,<games*score.3>,<bonus.3>,<games>,<active>,<absent>,<no total>,<weighted>}[@...]')"
+                ",(';info calc cache         : <id> <input hash>, then per list: @<list> <nr of lines> and its lines, all separated by newlines')"
                 ";";
             wxString mainCreateTable = "CREATE TABLE " MAIN_TABLE "( ID INT";
             #define ADD_COLUMN(key) \
@@ -164,6 +239,9 @@ namespace sql
             MyMessageBox(msg);
         }
         (void) ReadValue(KEY_PRG_VERSION, cfg::GetVersion());
+        UpgradeSessionTables();
+        if ( version < dbVersion && UpgradeScoreTables() )
+            (void)WriteValue(KEY_DB_VERSION, dbVersion);
         std::swap(fp, sqlFp);       // back to original value for global fp
         return fp;
     }   // InitDatabase()
@@ -173,8 +251,7 @@ namespace sql
         theSeparator = glb::GetSeparator();
         wxFileName db(cfg::ConstructFilename(cfg::EXT_SQLITE));
         if ( db.GetFullPath() == sqlDbFilename && sqlFp != nullptr ) return CFG_OK;
-        sqlite3_close(sqlFp);   // will flush pending changes
-        sqlFp = nullptr;
+        CloseDatabase(sqlFp);
         InitSdbMap();
 
         bool bFileExist = wxFile::Exists(db.GetFullPath());
@@ -210,13 +287,12 @@ namespace sql
     int UpdateSingleItem(const wxString& a_table, const wxString& a_column, const T& a_value)
     {
         if ( !sqlFp ) return SQLITE_CANTOPEN;
-        wxString cmd;
+        sqlite3_stmt* pStmt = StmtPrepare(FMT("UPDATE %s SET %s = ?1 WHERE ID = 1;", a_table, a_column));
         if constexpr ( std::is_same_v<T, wxString> )
-            cmd = FMT("UPDATE %s SET %s = '%s' WHERE ID = 1;", a_table, a_column, a_value);
+            StmtBind(pStmt, 1, a_value);
         if constexpr ( !std::is_same_v<T, wxString> )
-            cmd = FMT("UPDATE %s SET %s = %ld WHERE ID = 1;" , a_table, a_column, static_cast<long>(a_value));
-        int rc = SqlExec(cmd);
-        return rc;
+            StmtBind(pStmt, 1, static_cast<long>(a_value));
+        return StmtExec(pStmt);
     }   // UpdateSingleItem<>
 
     template <typename T>
@@ -234,22 +310,17 @@ namespace sql
         if ( !sqlFp ) return a_defaultValue;
         wxString column = GetColumnName(a_id);
         wxString table  = GetTableName(a_id, a_session);
-        wxString cmd    = FMT("SELECT %s FROM %s WHERE %s NOT NULL;", column, table, column);
-        auto     rc     = SqlExec(cmd);
-        if ( rc == SQLITE_OK )
-        {   // table/column present, return its value or store default value
-            if ( sqlData.size() && sqlData[0].size() )
-            {
-                wxString res = sqlData[0][0].data;
-                if constexpr ( std::is_same_v<T, wxString> )
-                    return res;
-                if constexpr ( !std::is_same_v<T, wxString> )
-                    return static_cast<T>(wxAtol(res));
-            }
-            else
-            {   // no value present, so set default
-               (void)UpdateSingleItem<T>(table, column, a_defaultValue);
-            }
+        Cursor   cursor(FMT("SELECT %s FROM %s WHERE %s NOT NULL;", column, table, column));
+        if ( cursor.Next() )
+        {   // table/column present, return its value
+            if constexpr ( std::is_same_v<T, wxString> )
+                return cursor.Text(0);
+            if constexpr ( !std::is_same_v<T, wxString> )
+                return static_cast<T>(cursor.Int(0));
+        }
+        if ( cursor.IsOk() )
+        {   // no value present, so set default
+           (void)UpdateSingleItem<T>(table, column, a_defaultValue);
         }
 
         return a_defaultValue;
@@ -314,14 +385,16 @@ namespace sql
         (void)SqlExec("BEGIN;");
         wxString sql = FMT("DELETE FROM %s", table);
         bool bResult = SQLITE_OK == SqlExec(sql);       // remove content of pairnames
-        wxString fmt = FMT("INSERT INTO %s VALUES(%%u,'%%s',%%u);", table);
+        sqlite3_stmt* pInsert = StmtPrepare(FMT("INSERT INTO %s VALUES(?1,?2,?3);", table));
         UINT pair = 0;
         for (const auto& it : a_pairInfo)
         {
             if ( pair )
             {   // entry 0 is dummy
-                sql = FMT(fmt, pair, it.pairName, it.clubIndex);
-                if ( SQLITE_OK != SqlExec(sql) )
+                StmtBind(pInsert, 1, static_cast<long>(pair));
+                StmtBind(pInsert, 2, it.pairName);
+                StmtBind(pInsert, 3, static_cast<long>(it.clubIndex));
+                if ( SQLITE_OK != StmtExec(pInsert) )
                     bResult = false;    // mark error, but continue: log will show errors
             }
             ++pair;
@@ -338,24 +411,28 @@ namespace sql
         if ( !sqlFp ) return false;
 
         InitGlobalNames();  // use global db, if set so
-        bool bResult = true;
-        wxString sql = FMT("SELECT * FROM %s;", GetTableName(KEY_MATCH_PAIRNAMES) );
-        (void)SqlExec(sql);
-        size_t maxPair = sqlData.size();
+        bool     bResult = true;
+        wxString table   = GetTableName(KEY_MATCH_PAIRNAMES);
+        size_t   maxPair = 0;
+        {
+            Cursor count(FMT("SELECT COUNT(*) FROM %s;", table));
+            if ( count.Next() )
+                maxPair = static_cast<size_t>(count.Int(0));
+        }
         if ( maxPair > cfg::MAX_PAIRS )
             maxPair = cfg::MAX_PAIRS;   // ignore unwanted entries
         a_pairInfo.resize(maxPair+1);
-        for ( const auto& pi : sqlData )
+        Cursor pi(FMT("SELECT * FROM %s;", table));
+        while ( pi.Next() )
         {   // [0]=id, [1]=name, [2]=clubId
-            UINT pair = wxAtoi(pi[0].data);
+            auto pair = static_cast<UINT>(pi.Int(0));
             if ( pair > maxPair )
             {
-                MyLogError(_("Reading pairnames: pairnr <%s> too high!"), pi[0].data);
+                MyLogError(_("Reading pairnames: pairnr <%u> too high!"), pair);
                 bResult = false;
                 continue;
             }
-            names::PairInfo info(pi[1].data, (UINT)wxAtoi(pi[2].data));
-            a_pairInfo[pair] = info;
+            a_pairInfo[pair] = names::PairInfo(pi.Text(1), static_cast<UINT>(pi.Int(2)));
         }
         InitGlobalNames();  // back to local db
         return bResult;
@@ -370,18 +447,17 @@ namespace sql
 
         InitGlobalNames();  // use global db, if set so
         bool bResult = true;
-        wxString sql = FMT("SELECT * FROM %s;", GetTableName(KEY_MATCH_CLUBNAMES) );
-        (void)SqlExec(sql);
-        for ( const auto& ci : sqlData )
+        Cursor ci(FMT("SELECT * FROM %s;", GetTableName(KEY_MATCH_CLUBNAMES)));
+        while ( ci.Next() )
         {   // [0]=clubId, [1]=clubName
-            auto clubId = (UINT)wxAtoi(ci[0].data);
+            auto clubId = static_cast<UINT>(ci.Int(0));
             if ( clubId > cfg::MAX_CLUBNAMES )
             {
                 MyLogError(_("Reading clubnames: clubnr <%u> too high!"), clubId);
                 bResult = false;
                 continue;
             }
-            a_clubNames[clubId] = ci[1].data;
+            a_clubNames[clubId] = ci.Text(1);
             if ( clubId > a_uMaxId )
                 a_uMaxId = clubId;
         }
@@ -398,15 +474,16 @@ namespace sql
         (void)SqlExec("BEGIN;");
         wxString sql = FMT("DELETE FROM %s", table);
         bool bResult = SQLITE_OK == SqlExec(sql);       // remove content of clubnames
-        wxString fmt = FMT("INSERT INTO %s VALUES(%%u,'%%s');", table);
+        sqlite3_stmt* pInsert = StmtPrepare(FMT("INSERT INTO %s VALUES(?1,?2);", table));
         UINT clubId  = 0;
 
         for (const auto& ci : a_clubNames)
         {
             if ( clubId && !ci.IsEmpty() )
             {   // entry 0 is dummy
-                sql = FMT(fmt, clubId, ci);
-                if ( SQLITE_OK != SqlExec(sql) )
+                StmtBind(pInsert, 1, static_cast<long>(clubId));
+                StmtBind(pInsert, 2, ci);
+                if ( SQLITE_OK != StmtExec(pInsert) )
                     bResult = false;
             }
             ++clubId;
@@ -421,10 +498,8 @@ namespace sql
         if ( !sqlFp ) return false;
         // const char* e1 = "SELECT EXISTS(SELECT 1 FROM sqlite_master WHERE type="table" AND name ="table_name");";
         // const char* e2 = "select name from sqlite_master where tbl_name like 'm%';";
-        wxString sql = FMT("select tbl_name from sqlite_master where tbl_name like 'session.%u." MAIN_TABLE "';", a_session);
-        int rc    = SqlExec(sql);
-        auto size = sqlData.size();
-        return rc == SQLITE_OK && size > 0;
+        Cursor table(FMT("select tbl_name from sqlite_master where tbl_name like 'session.%u." MAIN_TABLE "';", a_session));
+        return table.Next();
     }   // end ExistSession()
 
     static void InitSdbMap()
@@ -457,7 +532,7 @@ namespace sql
 
         dbKeys[KEY_SESSION_DISCR]            = { "description"      , TEXT_};
         dbKeys[KEY_SESSION_SCHEMA]           = { "schema"           , TEXT_};
-        dbKeys[KEY_SESSION_GAMERESULT]       = { "gameResult"       , TEXT_};
+        dbKeys[KEY_SESSION_GAMERESULT]       = { "sets"             , TEXT_};   // scores: a row per set, version 100: "gameResult"
         dbKeys[KEY_SESSION_ASSIGNMENTS]      = { "assignments"      , TEXT_};   // array of global pairnr's
         dbKeys[KEY_SESSION_ASSIGNMENTS_NAME] = { "assignmentsName"  , TEXT_};   // array for global pairnr's of session names
         dbKeys[KEY_SESSION_CORRECTION]       = { "correctionsSession",TEXT_};   // corrections for this session
@@ -465,6 +540,8 @@ namespace sql
         dbKeys[KEY_SESSION_RESULT]           = { "sessionResult"    , TEXT_};   // short session result, used for total/end calculation
         dbKeys[KEY_SESSION_RANK_SESSION]     = { "sessionrank"      , TEXT_};   // rank in the sessionresult
         dbKeys[KEY_SESSION_RANK_TOTAL]       = { "totalrank"        , TEXT_};   // rank in the totalresult for this session
+        dbKeys[KEY_SESSION_TOTALS]           = { "sessionTotals"    , TEXT_};   // running totals upto this session, used for total/end calculation
+        dbKeys[KEY_SESSION_CALC_CACHE]       = { "calcCache"        , TEXT_};   // session results with the hash of their input
 
     }  // InitSdbMap()
 
@@ -503,23 +580,10 @@ namespace sql
     }   // GetColumnName()
 
     static int SqlExec(const char* a_pSql)
-    {   // this will call the sql3 execution unit
-        // results: sqlData and sqlErrorMsg
+    {   // this will call the sql3 execution unit, for commands without results
+        // result: sqlErrorMsg
         sqlErrorMsg.clear();
-        sqlData.clear();    // clear data before exec(): callback will be called for each row with data
-        auto CallBack = [] (void* /*pUserData*/, int count, char* columnData[], char* columnNames[])  -> int
-        {   // called for each row result
-            std::vector<ColumnInfo> rowData;
-
-            for (int index = 0; index < count; ++index)
-            {
-                rowData.emplace_back(columnNames[index], columnData[index] ? columnData[index] : "");
-            }
-            sqlData.emplace_back(rowData);
-            return 0;   // non-zero will force the exec function to abort
-        };
-
-        auto rc = sqlite3_exec(sqlFp, a_pSql, CallBack, nullptr, nullptr);
+        auto rc = sqlite3_exec(sqlFp, a_pSql, nullptr, nullptr, nullptr);
         if ( rc != SQLITE_OK )
         {
             // if sqlite3_exec is called with non-zero errorptr, then
@@ -540,19 +604,73 @@ namespace sql
         return SqlExec(sql);
     }   // SqlExec()
 
+    static sqlite3_stmt* StmtPrepare(const wxString& a_sql)
+    {   // compile the sql once for the current database, the next calls only reset it
+        if ( !sqlFp ) return nullptr;
+        sqlErrorMsg.clear();
+        std::string sql(a_sql.ToUTF8());
+        auto it = stmtCache.find({sqlFp, sql});
+        if ( it != stmtCache.end() )
+        {
+            sqlite3_reset         (it->second);
+            sqlite3_clear_bindings(it->second);
+            return it->second;
+        }
+
+        sqlite3_stmt* pStmt = nullptr;
+        auto rc = sqlite3_prepare_v3(sqlFp, sql.c_str(), static_cast<int>(sql.size()), SQLITE_PREPARE_PERSISTENT, &pStmt, nullptr);
+        if ( rc != SQLITE_OK )
+        {
+            const char* perr = sqlite3_errmsg(sqlFp);
+            sqlErrorMsg      = perr;
+            MyLogError("sqlite3_prepare_v3(%s) returned error %d (%s)", sql.c_str(), rc, perr);
+            sqlite3_finalize(pStmt);
+            return nullptr;
+        }
+        stmtCache[{sqlFp, sql}] = pStmt;
+        return pStmt;
+    }   // StmtPrepare()
+
+    static void StmtBind(sqlite3_stmt* a_pStmt, int a_index, const wxString& a_value)
+    {   // the text is copied by sqlite
+        if ( a_pStmt == nullptr ) return;
+        auto buf = a_value.ToUTF8();
+        (void)sqlite3_bind_text(a_pStmt, a_index, buf.data(), static_cast<int>(buf.length()), SQLITE_TRANSIENT);
+    }   // StmtBind()
+
+    static void StmtBind(sqlite3_stmt* a_pStmt, int a_index, long a_value)
+    {
+        if ( a_pStmt == nullptr ) return;
+        (void)sqlite3_bind_int64(a_pStmt, a_index, a_value);
+    }   // StmtBind()
+
+    static int StmtExec(sqlite3_stmt* a_pStmt)
+    {   // for insert/update/delete: no results expected
+        if ( a_pStmt == nullptr ) return SQLITE_ERROR;     // already logged by StmtPrepare()
+        auto rc = sqlite3_step(a_pStmt);
+        if ( rc == SQLITE_DONE )
+            rc = SQLITE_OK;
+        else
+        {
+            const char* perr = sqlite3_errmsg(sqlFp);
+            sqlErrorMsg      = perr;
+            MyLogError("sqlite3_step(%s) returned error %d (%s)", sqlite3_sql(a_pStmt), rc, perr);
+        }
+        sqlite3_reset(a_pStmt);     // release its locks, so COMMIT can proceed
+        return rc;
+    }   // StmtExec()
+
     static void CreateSessionTables(UINT a_session)
     {   // create the MAIN table and the gameresult table for this session
         if ( sqlFp == nullptr || ExistSession( a_session) )
             return;
         int         errorCount = 0;
-        wxString    table      = GetTableName(KEY_SESSION_GAMERESULT, a_session);
-        wxString    sql        = FMT("CREATE TABLE %s (" GAME_COL " INT," DATA_COL " TEXT); ", table);
         #define CHECK(x) if ( (x) != SQLITE_OK ) ++errorCount
         CHECK(SqlExec("BEGIN"));
-        CHECK(SqlExec(sql));
+        CHECK(CreateScoreTable(a_session));
 
-        table = GetTableName(KEY_SESSION_DISCR, a_session);
-        sql = FMT("CREATE TABLE %s ( ID INT", table);
+        wxString table = GetTableName(KEY_SESSION_DISCR, a_session);
+        wxString sql   = FMT("CREATE TABLE %s ( ID INT", table);
         #define ADD_COLUMN(key) \
                 sql += FMT(",%s %s", dbKeys[key].first, TableTypesText[dbKeys[key].second])
         ADD_COLUMN(KEY_SESSION_DISCR);
@@ -564,6 +682,8 @@ namespace sql
         ADD_COLUMN(KEY_SESSION_RANK_SESSION);
         ADD_COLUMN(KEY_SESSION_RESULT);
         ADD_COLUMN(KEY_SESSION_RANK_TOTAL);
+        ADD_COLUMN(KEY_SESSION_TOTALS);
+        ADD_COLUMN(KEY_SESSION_CALC_CACHE);
         #undef ADD_COLUMN
         sql += ");";   // close sql command
         CHECK(SqlExec(sql));
@@ -577,6 +697,46 @@ namespace sql
         #undef CHECK
     }   // CreateSessionTables()
 
+    static int CreateScoreTable(UINT a_session)
+    {   // a row per set: a pair plays a game only once as NS, so (game, ns) is the key
+        wxString table = GetTableName(KEY_SESSION_GAMERESULT, a_session);
+        wxString index = FMT("'session.%u.%s", a_session, dbKeys[KEY_SESSION_GAMERESULT].first);  // + column': index name
+        int rc = SqlExec(FMT("CREATE TABLE IF NOT EXISTS %s (" GAME_COL " INT NOT NULL, PAIRNS INT NOT NULL, PAIREW INT"
+                             ", SCORENS INT, SCOREEW INT, CONTRACTNS TEXT, CONTRACTEW TEXT"
+                             ", PRIMARY KEY (" GAME_COL ", PAIRNS)) WITHOUT ROWID;", table));
+        if ( rc == SQLITE_OK )
+            rc = SqlExec(FMT("CREATE INDEX IF NOT EXISTS %s.ns' ON %s (PAIRNS);", index, table));
+        if ( rc == SQLITE_OK )
+            rc = SqlExec(FMT("CREATE INDEX IF NOT EXISTS %s.ew' ON %s (PAIREW);", index, table));
+        return rc;
+    }   // CreateScoreTable()
+
+    static void UpgradeSessionTables()
+    {   // session tables of older databases: add the columns that were added later
+        if ( sqlFp == nullptr ) return;
+        std::vector<wxString> tables;
+        {
+            Cursor table("select tbl_name from sqlite_master where tbl_name like 'session.%." MAIN_TABLE "';");
+            while ( table.Next() )
+                tables.push_back(table.Text(0));
+        }   // done before altering the tables
+
+        for ( const auto& table : tables )
+        {
+            for ( keyId id : {KEY_SESSION_TOTALS, KEY_SESSION_CALC_CACHE} )
+            {
+                wxString column = GetColumnName(id);
+                bool     bAdd;
+                {
+                    Cursor info(FMT("select name from pragma_table_info('%s') where name = '%s';", table, column));
+                    bAdd = !info.Next() && info.IsOk();
+                }
+                if ( bAdd )
+                    (void)SqlExec(FMT("ALTER TABLE '%s' ADD COLUMN %s %s;", table, column, TableTypesText[dbKeys[id].second]));
+            }
+        }
+    }   // UpgradeSessionTables()
+
     static bool UintVectorRead(UINT_VECTOR& a_vUint, UINT a_session, keyId a_id)
     {   // Resize vector to cfg::MAX_PAIRS and read a set of UINTs and put them in a vector.
         if ( !sqlFp ) return false;
@@ -626,50 +786,168 @@ namespace sql
         return UintVectorRead(a_vuRank, a_session, KEY_SESSION_RANK_TOTAL);
     }   // TotalRankRead()
 
-    static bool CB_ScoresWriteGame(UINT a_game, const wxString& a_gameScores, void* a_pUserData)
-    {   // write the scores of a single game
-        wxString sql = FMT(*(reinterpret_cast<wxString*>(a_pUserData)), a_game, a_gameScores);
-        return SQLITE_OK == SqlExec(sql);
-    }   // CB_ScoreWriteGame()
+    static bool SameSet(const score::GameSetData& a_left, const score::GameSetData& a_right)
+    {   // operator == of GameSetData ignores the contracts
+        return a_left == a_right && a_left.contractNS == a_right.contractNS && a_left.contractEW == a_right.contractEW;
+    }   // SameSet()
+
+    static bool ScoresWriteSets(const vvScoreData& a_scoreData, const vvScoreData& a_stored, const wxString& a_table, UINT& a_duplicates)
+    {   // write only the sets that differ from the stored ones, the caller handles the transaction.
+        // A pair can only be NS once in a game: a second set of it is not written, but counted in a_duplicates
+        sqlite3_stmt* pUpsert = StmtPrepare(FMT("INSERT OR REPLACE INTO %s (" SET_COLUMNS ") VALUES(?1,?2,?3,?4,?5,?6,?7);", a_table));
+        sqlite3_stmt* pDelete = StmtPrepare(FMT("DELETE FROM %s WHERE " GAME_COL " = ?1 AND PAIRNS = ?2;", a_table));
+        if ( pUpsert == nullptr || pDelete == nullptr )
+            return false;
+
+        static const std::vector<score::GameSetData> noSets;
+        auto bindContract = [pUpsert](int a_index, const wxString& a_contract)
+        {   // no contract: NULL, so nothing is stored
+            if ( a_contract.IsEmpty() )
+                (void)sqlite3_bind_null(pUpsert, a_index);
+            else
+                StmtBind(pUpsert, a_index, a_contract);
+        };
+        bool   bResult = true;
+        size_t games   = std::max(a_scoreData.size(), a_stored.size());
+        a_duplicates   = 0;
+        for ( size_t game = 1; game < games; ++game )
+        {
+            const auto& sets   = game < a_scoreData.size() ? a_scoreData[game] : noSets;
+            const auto& stored = game < a_stored   .size() ? a_stored   [game] : noSets;
+            for ( auto setIt = sets.begin(); setIt != sets.end(); ++setIt )
+            {   // new or changed sets
+                const auto& set = *setIt;
+                if ( std::ranges::find(sets.begin(), setIt, set.pairNS, &score::GameSetData::pairNS) != setIt )
+                {   // the primary key would silently replace the first set of this pair
+                    MyLogError(_("Scores of game %u: pair %u plays NS in more than one set, set %u-%u is not stored!")
+                        , static_cast<UINT>(game), set.pairNS, set.pairNS, set.pairEW);
+                    ++a_duplicates;
+                    continue;
+                }
+                auto it = std::ranges::find(stored, set.pairNS, &score::GameSetData::pairNS);
+                if ( it != stored.end() && SameSet(*it, set) ) continue;
+                StmtBind(pUpsert, 1, static_cast<long>(game));
+                StmtBind(pUpsert, 2, static_cast<long>(set.pairNS));
+                StmtBind(pUpsert, 3, static_cast<long>(set.pairEW));
+                StmtBind(pUpsert, 4, static_cast<long>(set.scoreNS));
+                StmtBind(pUpsert, 5, static_cast<long>(set.scoreEW));
+                bindContract(6, set.contractNS);
+                bindContract(7, set.contractEW);
+                if ( SQLITE_OK != StmtExec(pUpsert) )
+                    bResult = false;    // mark error, but continue: log will show errors
+            }
+            for ( const auto& set : stored )
+            {   // removed sets
+                if ( std::ranges::find(sets, set.pairNS, &score::GameSetData::pairNS) != sets.end() ) continue;
+                StmtBind(pDelete, 1, static_cast<long>(game));
+                StmtBind(pDelete, 2, static_cast<long>(set.pairNS));
+                if ( SQLITE_OK != StmtExec(pDelete) )
+                    bResult = false;
+            }
+        }
+        return bResult;
+    }   // ScoresWriteSets()
 
     bool ScoresWrite(const vvScoreData& a_scoreData, UINT a_session)
-    {
+    {   // compared with the stored scores: a changed score is a single row write
         if ( !sqlFp ) return false;
-        wxString sqlTable = GetTableName(KEY_SESSION_GAMERESULT, a_session);
-        wxString sql      = FMT("DELETE FROM %s", sqlTable);
-        if ( SQLITE_OK != SqlExec(sql) )
-            return false;
-        wxString cb_fmtScoresWrite = FMT("INSERT INTO %s (" GAME_COL "," DATA_COL ") VALUES(%%u, '%%s'); ", sqlTable);
+        auto it = storedScores.find({sqlFp, a_session});
+        if ( it == storedScores.end() )
+        {   // not read/written since the open: what is stored now
+            vvScoreData stored;
+            if ( !ScoresRead(stored, a_session) )
+                return false;
+            it = storedScores.find({sqlFp, a_session});
+        }
+        UINT duplicates = 0;
         (void)SqlExec("BEGIN;");
-        auto result = glb::ScoresWrite(a_scoreData, CB_ScoresWriteGame, &cb_fmtScoresWrite );
+        auto result = ScoresWriteSets(a_scoreData, it->second, GetTableName(KEY_SESSION_GAMERESULT, a_session), duplicates);
         (void)SqlExec("COMMIT;");
+        if ( result && duplicates == 0 )
+            it->second = a_scoreData;
+        else
+            storedScores.erase(it);     // stored data differs: read it again on the next write
         return result;
     }   // ScoresWrite()
 
-    static bool CB_ScoresReadLine(wxString& a_game, wxString& a_gameScores, void* a_pUserData)
-    {   // read the scores of a single game at 'index'
-        size_t& index = *(reinterpret_cast<size_t*>(a_pUserData));
-        if ( index >= sqlData.size() )
-            return false;   // no more data available
-        a_game       = sqlData[index][0].data;
-        a_gameScores = sqlData[index][1].data;
-        ++index;   // next line to read
-        return true;
-    }   // CB_ScoresReadLine()
-
     bool ScoresRead(vvScoreData& a_scoreData, UINT a_session)
     {
         if ( !sqlFp ) return false;
         wxString sqlTable = GetTableName(KEY_SESSION_GAMERESULT, a_session);
-        wxString sql = FMT("SELECT * FROM %s;", sqlTable);
-        if ( SQLITE_OK != SqlExec(sql) )
+        Cursor   set(FMT("SELECT " SET_COLUMNS " FROM %s ORDER BY " GAME_COL ",PAIRNS;", sqlTable));
+        if ( !set.IsOk() )
             return false;   // no table?
-        // now ALL scsores are read into 'sqlData'
-        size_t index = 0;   // read data, starting at index 0
-        auto rc = glb::ScoresRead(a_scoreData, CB_ScoresReadLine, &index);
-        return rc;
+        a_scoreData.clear();                    // remove old data
+        a_scoreData.resize(cfg::MAX_GAMES + 1); //  and assure room voor all games. We depend on the entries of this vector!
+        while ( set.Next() )
+        {
+            auto game = static_cast<UINT>(set.Int(0));
+            if ( game > cfg::MAX_GAMES ) { MyLogError(_("Reading scores: gamenr <%u> too high!"), game); continue; }
+            a_scoreData[game].push_back({ static_cast<UINT>(set.Int(1)), static_cast<UINT>(set.Int(2))
+                                        , static_cast<int> (set.Int(3)), static_cast<int> (set.Int(4))
+                                        , set.Text(5), set.Text(6) });
+        }
+        if ( !set.IsOk() )
+            return false;
+        storedScores[{sqlFp, a_session}] = a_scoreData;
+        return true;
     }   // ScoresRead()
 
+    static bool CB_ScoresReadLine(wxString& a_game, wxString& a_gameScores, void* a_pUserData)
+    {   // read the scores of the next game, from a table before version 101
+        auto& cursor = *(reinterpret_cast<Cursor*>(a_pUserData));
+        if ( !cursor.Next() )
+            return false;   // no more data available
+        a_game       = cursor.Text(0);
+        a_gameScores = cursor.Text(1);
+        return true;
+    }   // CB_ScoresReadLine()
+
+    static bool UpgradeScoreTables()
+    {   // before version 101 all sets of a game were one text row, now each set has its own row
+        std::vector<UINT> sessions;
+        {
+            Cursor table("select tbl_name from sqlite_master where tbl_name like 'session.%." OLD_SCORES "';");
+            while ( table.Next() )
+            {
+                UINT session = 0;
+                if ( 1 == wxSscanf(table.Text(0), "session.%u.", &session) )
+                    sessions.push_back(session);
+            }
+        }   // done before changing the tables
+
+        bool bResult = true;
+        for ( auto session : sessions )
+        {
+            wxString    oldTable = FMT("'session.%u." OLD_SCORES "'", session);
+            vvScoreData scores;
+            bool        bOk;
+            {   // the scores are parsed game by game while reading
+                Cursor cursor(FMT("SELECT " GAME_COL "," DATA_COL " FROM %s;", oldTable));
+                bOk = cursor.IsOk() && glb::ScoresRead(scores, CB_ScoresReadLine, &cursor) && cursor.IsOk();
+            }
+            UINT duplicates = 0;
+            (void)SqlExec("BEGIN;");
+            bOk = bOk && SQLITE_OK == CreateScoreTable(session)
+                      && ScoresWriteSets(scores, vvScoreData(), GetTableName(KEY_SESSION_GAMERESULT, session), duplicates);
+            if ( bOk && duplicates )
+            {   // not all sets could be converted: keep the old table aside, nothing is lost
+                wxString backup = FMT("'session.%u." OLD_SCORES ".v100'", session);
+                bOk = SQLITE_OK == SqlExec(FMT("ALTER TABLE %s RENAME TO %s;", oldTable, backup));
+                MyLogError(_("Session %u: %u set(s) with a pair that plays NS more than once are not converted, the old scores are kept in table %s"), session, duplicates, backup);
+            }
+            else
+                bOk = bOk && SQLITE_OK == SqlExec(FMT("DROP TABLE %s;", oldTable));
+            (void)SqlExec(bOk ? "COMMIT;" : "ROLLBACK;");
+            if ( !bOk )
+            {   // keep the old table: the next open tries again
+                MyLogError(_("Converting the scores of session %u failed"), session);
+                bResult = false;
+            }
+        }
+        return bResult;
+    }   // UpgradeScoreTables()
+
     bool CorrectionsEndRead(cor::mCorrectionsEnd& a_mCorrectionsEnd, UINT a_session, bool a_bEdit)
     {
         if ( !sqlFp ) return false;
@@ -771,6 +1049,39 @@ namespace sql
         return glb::SessionResultRead(a_mSessionResult, info);
     } //SessionResultRead()
 
+    bool SessionTotalsRead(cor::mCumulativeTotals& a_mTotals, UINT a_session)
+    {
+        a_mTotals.clear();
+        if ( !sqlFp ) return false;
+        if ( !ExistSession(a_session) ) return true;    // don't create a session just for reading its totals
+        wxString info = ReadSingleItem(KEY_SESSION_TOTALS, ES, a_session);
+        return glb::SessionTotalsRead(a_mTotals, info);
+    }   // SessionTotalsRead()
+
+    bool SessionTotalsWrite(const cor::mCumulativeTotals& a_mTotals, UINT a_session)
+    {
+        if ( !sqlFp ) return false;
+        if ( a_mTotals.empty() && !ExistSession(a_session) ) return true;   // nothing to remove
+        wxString info = glb::SessionTotalsWrite(a_mTotals);
+        return UpdateSingleItem(KEY_SESSION_TOTALS, info, a_session);
+    }   // SessionTotalsWrite()
+
+    bool CalcCacheRead(wxString& a_cache, UINT a_session)
+    {
+        a_cache.clear();
+        if ( !sqlFp ) return false;
+        if ( !ExistSession(a_session) ) return true;    // don't create a session just for reading its cache
+        a_cache = ReadSingleItem(KEY_SESSION_CALC_CACHE, ES, a_session);
+        return true;
+    }   // CalcCacheRead()
+
+    bool CalcCacheWrite(const wxString& a_cache, UINT a_session)
+    {
+        if ( !sqlFp ) return false;
+        if ( a_cache.IsEmpty() && !ExistSession(a_session) ) return true;  // nothing to remove
+        return UpdateSingleItem(KEY_SESSION_CALC_CACHE, a_cache, a_session);
+    }   // CalcCacheWrite()
+
     int ScoresWriteEx(const wxString& a_dBase, const vvScoreData& a_scoreData, UINT a_session)
     {   // only write to existing files
         if ( !wxFile::Exists(a_dBase) )                 return EX_RESULT_NOT_EXIST;
@@ -782,10 +1093,46 @@ namespace sql
         std::swap(pSqlEx, sqlFp);       // have the correct value for the next calls....
         bResult = ScoresWrite(a_scoreData, a_session);
         std::swap(pSqlEx, sqlFp);       // back to how it was
-        sqlite3_close(pSqlEx);          // will also flush pending changes
+        CloseDatabase(pSqlEx);          // will also flush pending changes
         return bResult ? EX_RESULT_OK : EX_RESULT_ERROR;
     }   // ScoresWriteEx()
 
+    bool TestDatabaseOpen(const wxString& a_dbFile)
+    {   // test hook: a match database with the real tables as the current database, without the configuration
+        CloseDatabase(sqlFp);
+        sqlDbFilename.clear();
+        theSeparator = glb::GetSeparator();
+        InitSdbMap();
+        sqlFp = InitDatabase(a_dbFile);
+        return sqlFp != nullptr;
+    }   // TestDatabaseOpen()
+
+    bool PairnamesWriteFormatted(const names::PairInfoData& a_pairInfo)
+    {   // test hook: PairnamesWrite() as it was before the prepared statements, each insert is formatted and compiled
+        if ( !sqlFp ) return false;
+        wxString table = GetTableName(KEY_MATCH_PAIRNAMES);
+
+        (void)SqlExec("BEGIN;");
+        bool bResult = SQLITE_OK == SqlExec(FMT("DELETE FROM %s", table));
+        for ( UINT pair = 1; pair < a_pairInfo.size(); ++pair )
+        {   // entry 0 is dummy
+            wxString name = a_pairInfo[pair].pairName;
+            name.Replace("'", "''");    // else a quote ends the value
+            if ( SQLITE_OK != SqlExec(FMT("INSERT INTO %s VALUES(%u,'%s',%u);", table, pair, name, a_pairInfo[pair].clubIndex)) )
+                bResult = false;
+        }
+        (void)SqlExec("COMMIT;");
+        return bResult;
+    }   // PairnamesWriteFormatted()
+
+    bool WriteValueFormatted(keyId a_id, const wxString& a_value, UINT a_session)
+    {   // test hook: WriteValue() as it was before the prepared statements
+        if ( !sqlFp ) return false;
+        wxString value = a_value;
+        value.Replace("'", "''");
+        return SQLITE_OK == SqlExec(FMT("UPDATE %s SET %s = '%s' WHERE ID = 1;", GetTableName(a_id, a_session), GetColumnName(a_id), value));
+    }   // WriteValueFormatted()
+
 } // namespace sql
 
 #if 0
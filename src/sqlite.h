@@ -11,6 +11,11 @@ namespace sql
     #include "interfaces.h"
     bool ExistSession(UINT session);
 
+    // test hooks for the comparison in benchmarks.cpp: the formatted sql as used before the prepared statements
+    bool TestDatabaseOpen        (const wxString& dbFile);     // a match database as the current one, close with DatabaseClose()
+    bool PairnamesWriteFormatted (const names::PairInfoData& pairInfo);
+    bool WriteValueFormatted     (keyId id, const wxString& value, UINT session = DEFAULT_SESSION);
+
 }   // end namespace db
 
 #endif
@@ -0,0 +1,86 @@
+﻿// Copyright(c) 2024-present, BusyHarry/h.levels & BridgeWx contributors.
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#include <wx/app.h>
+#include <wx/event.h>
+#include <wx/msgdlg.h>
+#include <wx/thread.h>
+#include <wx/window.h>
+#include <iostream>
+
+#include "cfg.h"
+#include "uilink.h"
+
+static wxWindow*    spMainframe  = nullptr;     // to reach mainframe from clients
+static bool         sbHeadless   = false;
+static pMessageBox  spMessageBox = nullptr;
+
+void SetMainframe(wxWindow* a_pMainframe)
+{
+    spMainframe = a_pMainframe;
+}   // SetMainframe()
+
+wxWindow* GetMainframe()
+{
+    return spMainframe;
+}   // GetMainframe()
+
+void SetHeadless()
+{
+    sbHeadless = true;
+}   // SetHeadless()
+
+bool IsHeadless()
+{
+    return sbHeadless;
+}   // IsHeadless()
+
+void SetMessageBoxHandler(pMessageBox a_pHandler)
+{
+    spMessageBox = a_pHandler;
+}   // SetMessageBoxHandler()
+
+static int SafeAnswer(long a_style)
+{   // the answer if nobody can give one
+    if (a_style & wxCANCEL) return wxCANCEL;
+    if (a_style & wxNO    ) return wxNO;
+    return wxOK;
+}   // SafeAnswer()
+
+int MyMessageBox(const wxString& a_message, const wxString& a_caption, long a_style, const wxPoint& a_position)
+{
+    if (!wxIsMainThread())
+    {   // from a worker thread (database write-behind): show it later in the ui thread, nobody waits for the answer
+        if (wxTheApp) wxTheApp->CallAfter([a_message, a_caption, a_style, a_position]{ (void)MyMessageBox(a_message, a_caption, a_style, a_position); });
+        return SafeAnswer(a_style);
+    }
+
+    if (IsHeadless())
+    {   // no one to answer: show on console and take the most safe answer
+        std::cout << (a_caption.IsEmpty() ? a_caption : a_caption + ": ") << a_message << std::endl;
+        return SafeAnswer(a_style);
+    }
+
+    if (spMessageBox)
+        return spMessageBox(a_message, a_caption, a_style, a_position);
+    return wxMessageBox(a_message, a_caption, a_style, nullptr, a_position.x, a_position.y);
+}   // MyMessageBox()
+
+// cppcheck-suppress constParameterPointer
+void SendEvent2Mainframe(int a_id, void* a_pClientData)
+{
+    if (GetMainframe())
+    {
+        wxCommandEvent event(wxEVT_USER, a_id);
+        event.SetClientData(a_pClientData);
+        GetMainframe()->GetEventHandler()->AddPendingEvent(event);
+    }
+}   // SendEvent2Mainframe()
+
+// cppcheck-suppress constParameterPointer
+void SendEvent2Mainframe(wxWindow* a_pWindow, int a_id, void* const a_pClientData)
+{
+    wxCommandEvent event(wxEVT_USER, a_id);
+    event.SetClientData(a_pClientData);
+    a_pWindow->GetEventHandler()->AddPendingEvent(event);
+}   // SendEvent2Mainframe()
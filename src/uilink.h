@@ -0,0 +1,36 @@
+﻿// Copyright(c) 2024-present, BusyHarry/h.levels & BridgeWx contributors.
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#if !defined _UILINK_H_
+#define _UILINK_H_
+#pragma once
+
+#include <wx/defs.h>
+#include <wx/gdicmn.h>
+#include <wx/string.h>
+#include "utils.h"
+
+class wxWindow;
+
+// The link from the non-ui code (configuration, io, calculation) to the ui, if there is one.
+// BridgeWx sets its mainframe and messagebox, the batch calculator runs headless: messages go to the console.
+using pMessageBox = int(*)(const wxString& message, const wxString& caption, long style, const wxPoint& position);
+
+void        SetMainframe        (wxWindow* pMainframe);     // the window that gets the events of SendEvent2Mainframe()
+wxWindow*   GetMainframe        ();                         // nullptr if there is none (yet)
+void        SetHeadless         ();                         // no ui at all
+bool        IsHeadless          ();                         // true, if running without ui (batch calculation): messages go to the console
+void        SetMessageBoxHandler(pMessageBox pHandler);     // the ui-function that shows MyMessageBox()
+
+// show a message, from any thread: from a worker thread it is shown later and nobody waits for the answer
+int MyMessageBox(const wxString& message, const wxString& caption = ES, long style=wxOK|wxCENTER, const wxPoint& position = wxDefaultPosition);
+
+/*
+communicate with mainframe on the base of a menu-event
+@param id the value for the command handler
+@param pClientData optional pointer to extra data for this command
+*/
+void SendEvent2Mainframe(int id, void* const pClientData = nullptr);
+void SendEvent2Mainframe(wxWindow* pWindows, int id, void* const pClientData = nullptr);
+
+#endif
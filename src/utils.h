@@ -53,6 +53,7 @@ wxString GetDateTime();                         // get current datetime as : Get
 #endif
 
 wxString U2String       (UINT x);  // (unsigned) int to string
+void     U2String       (UINT x, wxString& buffer); // same, into a caller-owned buffer: no allocation if it is large enough
 wxString I2String       (int  x);  // int to string
 wxString L2String       (long x);  // long to string
 UINT MyGetFilesize      (const wxString& file);